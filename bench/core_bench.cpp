@@ -0,0 +1,135 @@
+/**
+ * @file bench/core_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Per-request server component benchmarks
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "harness.hpp"
+#include "core/async.hpp"
+#include "core/rate_limiter.hpp"
+#include "core/response_cache.hpp"
+#include "core/single_flight.hpp"
+
+namespace {
+    using namespace frqs ;
+
+    // One allow() per request, cycling over `clients` addresses. A generous
+    // rate keeps buckets non-empty; with more clients than slots every call
+    // also evicts.
+    void BM_RateLimiterAllow(bench::State& state, uint32_t clients) {
+        core::RateLimitConfig config ;
+        config.rate = 1e6 ;
+        core::RateLimiter limiter(config) ;
+
+        auto now = core::RateLimiter::Clock::now() ;
+        uint32_t next = 0 ;
+        for (auto _ : state) {
+            bool allowed = limiter.allow(0x0A000000u + (next++ % clients), now) ;
+            bench::doNotOptimize(allowed) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+
+    FRQS_BENCHMARK_CAPTURE(BM_RateLimiterAllow, clients_1, 1) ;
+    FRQS_BENCHMARK_CAPTURE(BM_RateLimiterAllow, clients_4096, 4096) ;
+    FRQS_BENCHMARK_CAPTURE(BM_RateLimiterAllow, clients_1m, 1u << 20) ;
+
+    // The accept-time check for a client that is being limited
+    void BM_RateLimiterExhausted(bench::State& state) {
+        core::RateLimitConfig config ;
+        config.rate = 1 ;
+        core::RateLimiter limiter(config) ;
+
+        auto now = core::RateLimiter::Clock::now() ;
+        (void)limiter.allow(0x7F000001u, now) ;
+        for (auto _ : state) {
+            bool limited = limiter.exhausted(0x7F000001u, now) ;
+            bench::doNotOptimize(limited) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_RateLimiterExhausted) ;
+
+    // A cache hit as the server does it: build the key from the parsed
+    // request, look it up and copy the stored bytes into an output buffer.
+    // Compare with BM_ResponseBuild_* in http_bench for the miss path.
+    void BM_ResponseCacheHit(bench::State& state, size_t body_size) {
+        constexpr std::string_view raw =
+            "GET /api/products?page=2&sort=price&category=books HTTP/1.1\r\n"
+            "Host: shop.example.com\r\n"
+            "Accept-Encoding: gzip, br\r\n"
+            "\r\n" ;
+        static http::HTTPRequest request ;
+        (void)request.parse(raw) ;
+
+        core::ResponseCacheConfig config ;
+        config.vary = {"Accept-Encoding"} ;
+        core::ResponseCache cache(config) ;
+
+        auto now = core::ResponseCache::Clock::now() ;
+        (void)cache.store(cache.key(request),
+                          http::HTTPResponse().ok(std::pmr::string(body_size, 'x'))
+                              .setContentType("application/json")
+                              .setHeader("Cache-Control", "max-age=60"),
+                          now) ;
+
+        std::string out ;
+        for (auto _ : state) {
+            auto hit = cache.find(cache.key(request), now) ;
+            out.assign(hit->entry->wire) ;
+            bench::doNotOptimize(out) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK_CAPTURE(BM_ResponseCacheHit, body_256, 256) ;
+    FRQS_BENCHMARK_CAPTURE(BM_ResponseCacheHit, body_16k, 16 * 1024) ;
+
+    // What coalescing adds to every static file request when nothing else
+    // is in flight for the same path
+    void BM_SingleFlightUncontended(bench::State& state) {
+        core::SingleFlight flights ;
+        core::Connection conn(net::Socket(), net::SockAddr(), core::Connection::Clock::now(), 0) ;
+        std::string key = "static /assets/css/main.css" ;
+        for (auto _ : state) {
+            bool leader = flights.join(key, conn) ;
+            auto waiters = flights.finish(key) ;
+            bench::doNotOptimize(leader) ;
+            bench::doNotOptimize(waiters) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_SingleFlightUncontended) ;
+
+    core::Task<int> leaf(int value) {
+        co_return value + 1 ;
+    }
+
+    core::Task<int> handler(int value) {
+        int a = co_await leaf(value) ;
+        int b = co_await leaf(a) ;
+        co_return b ;
+    }
+
+    // Create, run and destroy a handler that awaits two child tasks: three
+    // frames per iteration, all recycled by the frame pool
+    void BM_TaskRun(bench::State& state) {
+        net::Poller poller ;
+        utils::ThreadPool pool(1) ;
+        core::AsyncLoop loop(poller, pool, [](void*) {}) ;
+
+        int value = 0 ;
+        for (auto _ : state) {
+            auto task = handler(value) ;
+            loop.start(task, nullptr) ;
+            value = task.result() ;
+            bench::doNotOptimize(value) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_TaskRun) ;
+}
@@ -0,0 +1,353 @@
+/**
+ * @file bench/harness.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "harness.hpp"
+#include "utils/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <thread>
+#include <vector>
+
+namespace frqs::bench {
+
+namespace {
+    double cpuNow() noexcept {
+        return static_cast<double>(std::clock()) * 1e9 / CLOCKS_PER_SEC ;
+    }
+
+    struct Registered {
+        std::string name ;
+        Function function ;
+    } ;
+
+    std::vector<Registered>& registry() {
+        static std::vector<Registered> benchmarks ;
+        return benchmarks ;
+    }
+
+    struct Options {
+        std::string filter = "." ;
+        double min_time = 0.5 ;
+        int repetitions = 1 ;
+        std::string out ;
+        bool json_stdout = false ;
+    } ;
+
+    struct Result {
+        std::string name ;
+        std::string run_name ;
+        std::string run_type = "iteration" ;
+        std::string aggregate_name ;
+        int repetition_index = 0 ;
+        uint64_t iterations = 0 ;
+        double real_ns = 0 ;
+        double cpu_ns = 0 ;
+        double items_per_second = 0 ;
+        double bytes_per_second = 0 ;
+        std::string label ;
+        std::string error ;
+        std::map<std::string, double> counters ;
+    } ;
+
+    bool parseFlag(std::string_view arg, std::string_view name, std::string& value) {
+        if (!arg.starts_with(name) || arg.size() <= name.size() || arg[name.size()] != '=') {
+            return false ;
+        }
+        value = std::string(arg.substr(name.size() + 1)) ;
+        return true ;
+    }
+}
+
+void State::start() noexcept {
+    running_ = true ;
+    real_start_ = Clock::now() ;
+    cpu_start_ = cpuNow() ;
+}
+
+void State::pauseTiming() noexcept {
+    if (running_) {
+        real_ns_ += std::chrono::duration<double, std::nano>(Clock::now() - real_start_).count() ;
+        cpu_ns_ += cpuNow() - cpu_start_ ;
+        running_ = false ;
+    }
+}
+
+void State::resumeTiming() noexcept {
+    if (!running_) {
+        start() ;
+    }
+}
+
+void State::finish() noexcept {
+    pauseTiming() ;
+}
+
+bool registerBenchmark(std::string name, Function function) {
+    registry().push_back({std::move(name), std::move(function)}) ;
+    return true ;
+}
+
+class Runner {
+public:
+    explicit Runner(Options options) : options_(std::move(options)) {}
+
+    std::vector<Result> run(const Registered& benchmark) {
+        // Grow the iteration count until one run takes at least min_time
+        uint64_t iterations = 1 ;
+        State probe(iterations) ;
+        while (true) {
+            probe = State(iterations) ;
+            benchmark.function(probe) ;
+            double seconds = probe.real_ns_ / 1e9 ;
+            if (!probe.error_.empty() || seconds >= options_.min_time || iterations >= (uint64_t{1} << 40)) {
+                break ;
+            }
+            double scale = seconds > 0 ? options_.min_time * 1.4 / seconds : 100.0 ;
+            scale = std::clamp(scale, 2.0, 100.0) ;
+            iterations = static_cast<uint64_t>(static_cast<double>(iterations) * scale) ;
+        }
+
+        std::vector<Result> results ;
+        for (int rep = 0 ; rep < options_.repetitions ; ++rep) {
+            State state(iterations) ;
+            if (rep == 0) {
+                state = std::move(probe) ;
+            } else {
+                benchmark.function(state) ;
+            }
+            results.push_back(toResult(benchmark.name, state, rep)) ;
+            if (!state.error_.empty()) {
+                return results ;
+            }
+        }
+
+        if (options_.repetitions > 1) {
+            addAggregates(benchmark.name, results) ;
+        }
+        return results ;
+    }
+
+private:
+    Options options_ ;
+
+    static Result toResult(const std::string& name, const State& state, int rep) {
+        Result r ;
+        r.name = name ;
+        r.run_name = name ;
+        r.repetition_index = rep ;
+        r.iterations = state.iterations_ ;
+        r.real_ns = state.real_ns_ / static_cast<double>(state.iterations_) ;
+        r.cpu_ns = state.cpu_ns_ / static_cast<double>(state.iterations_) ;
+        double seconds = state.real_ns_ / 1e9 ;
+        if (seconds > 0) {
+            r.items_per_second = static_cast<double>(state.items_) / seconds ;
+            r.bytes_per_second = static_cast<double>(state.bytes_) / seconds ;
+        }
+        r.label = state.label_ ;
+        r.error = state.error_ ;
+        r.counters = state.counters ;
+        return r ;
+    }
+
+    static void addAggregates(const std::string& name, std::vector<Result>& results) {
+        size_t n = results.size() ;
+        auto field = [&](auto getter) {
+            std::vector<double> values ;
+            for (size_t i = 0 ; i < n ; ++i) values.push_back(getter(results[i])) ;
+            return values ;
+        } ;
+        auto mean = [](const std::vector<double>& v) {
+            double sum = 0 ; for (double x : v) sum += x ; return sum / static_cast<double>(v.size()) ;
+        } ;
+        auto median = [](std::vector<double> v) {
+            std::sort(v.begin(), v.end()) ;
+            size_t mid = v.size() / 2 ;
+            return v.size() % 2 ? v[mid] : (v[mid - 1] + v[mid]) / 2 ;
+        } ;
+        auto stddev = [&](const std::vector<double>& v) {
+            double m = mean(v), acc = 0 ;
+            for (double x : v) acc += (x - m) * (x - m) ;
+            return v.size() > 1 ? std::sqrt(acc / static_cast<double>(v.size() - 1)) : 0.0 ;
+        } ;
+
+        auto real = field([](const Result& r) { return r.real_ns ; }) ;
+        auto cpu = field([](const Result& r) { return r.cpu_ns ; }) ;
+        auto items = field([](const Result& r) { return r.items_per_second ; }) ;
+        auto bytes = field([](const Result& r) { return r.bytes_per_second ; }) ;
+
+        auto make = [&](std::string aggregate, auto reduce) {
+            Result r ;
+            r.name = name + "_" + aggregate ;
+            r.run_name = name ;
+            r.run_type = "aggregate" ;
+            r.aggregate_name = aggregate ;
+            r.iterations = n ;
+            r.real_ns = reduce(real) ;
+            r.cpu_ns = reduce(cpu) ;
+            r.items_per_second = reduce(items) ;
+            r.bytes_per_second = reduce(bytes) ;
+            return r ;
+        } ;
+
+        results.push_back(make("mean", mean)) ;
+        results.push_back(make("median", median)) ;
+        results.push_back(make("stddev", stddev)) ;
+    }
+} ;
+
+namespace {
+    std::string toJson(const std::vector<Result>& results) {
+        std::string out ;
+        auto it = std::back_inserter(out) ;
+
+        auto now = std::chrono::system_clock::now() ;
+        auto stamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count() ;
+
+        std::format_to(it, "{{\n  \"context\": {{\n    \"timestamp\": {},\n    \"num_cpus\": {},\n"
+                           "    \"library_build_type\": \"{}\"\n  }},\n  \"benchmarks\": [\n",
+                       stamp, std::thread::hardware_concurrency(),
+#ifdef NDEBUG
+                       "release"
+#else
+                       "debug"
+#endif
+                       ) ;
+
+        for (size_t i = 0 ; i < results.size() ; ++i) {
+            const auto& r = results[i] ;
+            out += "    {\"name\": " ;
+            utils::appendJsonString(out, r.name) ;
+            out += ", \"run_name\": " ;
+            utils::appendJsonString(out, r.run_name) ;
+            std::format_to(it, ", \"run_type\": \"{}\"", r.run_type) ;
+            if (!r.aggregate_name.empty()) {
+                std::format_to(it, ", \"aggregate_name\": \"{}\"", r.aggregate_name) ;
+            } else {
+                std::format_to(it, ", \"repetition_index\": {}", r.repetition_index) ;
+            }
+            std::format_to(it, ", \"iterations\": {}, \"real_time\": {:.3f}, \"cpu_time\": {:.3f}, \"time_unit\": \"ns\"",
+                           r.iterations, r.real_ns, r.cpu_ns) ;
+            if (r.items_per_second > 0) {
+                std::format_to(it, ", \"items_per_second\": {:.3f}", r.items_per_second) ;
+            }
+            if (r.bytes_per_second > 0) {
+                std::format_to(it, ", \"bytes_per_second\": {:.3f}", r.bytes_per_second) ;
+            }
+            for (const auto& [key, value] : r.counters) {
+                out += ", " ;
+                utils::appendJsonString(out, key) ;
+                std::format_to(it, ": {}", value) ;
+            }
+            if (!r.label.empty()) {
+                out += ", \"label\": " ;
+                utils::appendJsonString(out, r.label) ;
+            }
+            if (!r.error.empty()) {
+                out += ", \"error_occurred\": true, \"error_message\": " ;
+                utils::appendJsonString(out, r.error) ;
+            }
+            out += i + 1 < results.size() ? "},\n" : "}\n" ;
+        }
+        out += "  ]\n}\n" ;
+        return out ;
+    }
+
+    std::string humanRate(double per_second) {
+        if (per_second >= 1e9) return std::format("{:.2f}G/s", per_second / 1e9) ;
+        if (per_second >= 1e6) return std::format("{:.2f}M/s", per_second / 1e6) ;
+        if (per_second >= 1e3) return std::format("{:.2f}k/s", per_second / 1e3) ;
+        return std::format("{:.2f}/s", per_second) ;
+    }
+
+    void printRow(const Result& r) {
+        std::string extra ;
+        if (r.items_per_second > 0) extra += " items=" + humanRate(r.items_per_second) ;
+        if (r.bytes_per_second > 0) extra += " bytes=" + humanRate(r.bytes_per_second) ;
+        for (const auto& [key, value] : r.counters) extra += std::format(" {}={}", key, value) ;
+        if (!r.label.empty()) extra += " " + r.label ;
+        if (!r.error.empty()) extra += " ERROR: " + r.error ;
+        std::cout << std::format("{:<48} {:>12.1f} ns {:>12.1f} ns {:>12}{}\n",
+                                 r.name, r.real_ns, r.cpu_ns, r.iterations, extra) ;
+    }
+}
+
+int runAll(int argc, char* argv[]) {
+    Options options ;
+
+    for (int i = 1 ; i < argc ; ++i) {
+        std::string_view arg = argv[i] ;
+        std::string value ;
+        if (parseFlag(arg, "--benchmark_filter", value)) {
+            options.filter = value ;
+        } else if (parseFlag(arg, "--benchmark_min_time", value)) {
+            options.min_time = std::stod(value) ;
+        } else if (parseFlag(arg, "--benchmark_repetitions", value)) {
+            options.repetitions = std::max(1, std::stoi(value)) ;
+        } else if (parseFlag(arg, "--benchmark_out", value)) {
+            options.out = value ;
+        } else if (parseFlag(arg, "--benchmark_format", value)) {
+            options.json_stdout = (value == "json") ;
+        } else if (arg == "--benchmark_list_tests") {
+            for (const auto& b : registry()) std::cout << b.name << '\n' ;
+            return 0 ;
+        } else {
+            std::cerr << "Unknown flag: " << arg << "\n"
+                      << "Flags: --benchmark_filter=<regex> --benchmark_min_time=<seconds>\n"
+                      << "       --benchmark_repetitions=<n> --benchmark_out=<file.json>\n"
+                      << "       --benchmark_format=<console|json> --benchmark_list_tests\n" ;
+            return 2 ;
+        }
+    }
+
+    std::regex filter(options.filter) ;
+    Runner runner(options) ;
+    std::vector<Result> all ;
+    bool failed = false ;
+
+    if (!options.json_stdout) {
+        std::cout << std::format("{:<48} {:>15} {:>15} {:>12}\n", "Benchmark", "Time", "CPU", "Iterations")
+                  << std::string(94, '-') << '\n' ;
+    }
+
+    for (const auto& benchmark : registry()) {
+        if (!std::regex_search(benchmark.name, filter)) {
+            continue ;
+        }
+        for (auto& result : runner.run(benchmark)) {
+            if (!options.json_stdout) {
+                printRow(result) ;
+            }
+            failed |= !result.error.empty() ;
+            all.push_back(std::move(result)) ;
+        }
+    }
+
+    auto json = toJson(all) ;
+    if (options.json_stdout) {
+        std::cout << json ;
+    }
+    if (!options.out.empty()) {
+        std::ofstream file(options.out) ;
+        if (!file) {
+            std::cerr << "Cannot write " << options.out << '\n' ;
+            return 1 ;
+        }
+        file << json ;
+    }
+    return failed ? 1 : 0 ;
+}
+
+} // namespace frqs::bench
@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file bench/harness.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Self-contained microbenchmark harness for zhttp_bench
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace frqs::bench {
+
+// Keeps the compiler from eliding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory") ;
+#else
+    static volatile const void* sink ;
+    sink = &value ;
+#endif
+}
+
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory") ;
+#endif
+}
+
+class State {
+public:
+    struct [[maybe_unused]] Value {} ;
+
+    class Iterator {
+    public:
+        Iterator(State* state, uint64_t remaining) noexcept : state_(state), remaining_(remaining) {}
+
+        Value operator*() const noexcept { return {} ; }
+        void operator++() noexcept { --remaining_ ; }
+        bool operator!=(const Iterator&) noexcept {
+            if (remaining_ != 0) [[likely]] {
+                return true ;
+            }
+            state_->finish() ;
+            return false ;
+        }
+
+    private:
+        State* state_ ;
+        uint64_t remaining_ ;
+    } ;
+
+    explicit State(uint64_t iterations) noexcept : iterations_(iterations) {}
+
+    Iterator begin() noexcept { start() ; return {this, iterations_} ; }
+    Iterator end() noexcept { return {this, 0} ; }
+
+    // Exclude setup work inside the loop from the measurement
+    void pauseTiming() noexcept ;
+    void resumeTiming() noexcept ;
+
+    void setItemsProcessed(uint64_t items) noexcept { items_ = items ; }
+    void setBytesProcessed(uint64_t bytes) noexcept { bytes_ = bytes ; }
+    void setLabel(std::string label) { label_ = std::move(label) ; }
+
+    // Marks the run failed: it is reported with message and zhttp_bench
+    // exits non-zero
+    void skipWithError(std::string message) { error_ = std::move(message) ; }
+
+    [[nodiscard]] uint64_t iterations() const noexcept { return iterations_ ; }
+
+    // Extra per-run values, reported as-is
+    std::map<std::string, double> counters ;
+
+private:
+    friend class Runner ;
+    using Clock = std::chrono::steady_clock ;
+
+    uint64_t iterations_ ;
+    uint64_t items_ = 0 ;
+    uint64_t bytes_ = 0 ;
+    std::string label_ ;
+    std::string error_ ;
+
+    Clock::time_point real_start_ ;
+    double cpu_start_ = 0 ;
+    double real_ns_ = 0 ;
+    double cpu_ns_ = 0 ;
+    bool running_ = false ;
+
+    void start() noexcept ;
+    void finish() noexcept ;
+} ;
+
+using Function = std::function<void(State&)> ;
+
+// Returns true so it can initialize a static in registration macros
+bool registerBenchmark(std::string name, Function function) ;
+
+// Parses --benchmark_* flags, runs matching benchmarks, prints results
+int runAll(int argc, char* argv[]) ;
+
+} // namespace frqs::bench
+
+#define FRQS_BENCH_CONCAT_IMPL(a, b) a##b
+#define FRQS_BENCH_CONCAT(a, b) FRQS_BENCH_CONCAT_IMPL(a, b)
+
+// FRQS_BENCHMARK(fn) registers void fn(State&) under its own name
+#define FRQS_BENCHMARK(fn) \
+    [[maybe_unused]] static const bool FRQS_BENCH_CONCAT(frqs_bench_reg_, __LINE__) = \
+        ::frqs::bench::registerBenchmark(#fn, fn)
+
+// FRQS_BENCHMARK_CAPTURE(fn, tag, args...) registers fn(state, args...) as "fn/tag"
+#define FRQS_BENCHMARK_CAPTURE(fn, tag, ...) \
+    [[maybe_unused]] static const bool FRQS_BENCH_CONCAT(frqs_bench_reg_, __LINE__) = \
+        ::frqs::bench::registerBenchmark(#fn "/" #tag, [](::frqs::bench::State& s) { fn(s, __VA_ARGS__) ; })
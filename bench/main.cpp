@@ -0,0 +1,16 @@
+/**
+ * @file bench/main.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief zhttp_bench entry point
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "harness.hpp"
+
+int main(int argc, char* argv[]) {
+    return frqs::bench::runAll(argc, argv) ;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file bench/net_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Address formatting, parsing and access list benchmarks
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "harness.hpp"
+#include "net/access_list.hpp"
+#include "net/ipv4.hpp"
+#include "net/sockaddr.hpp"
+#include <random>
+#include <vector>
+
+namespace {
+    using namespace frqs ;
+
+    void BM_IPv4ToString(bench::State& state, uint32_t address) {
+        net::IPv4 ip(address) ;
+        for (auto _ : state) {
+            auto s = ip.toString() ;
+            bench::doNotOptimize(s) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+
+    FRQS_BENCHMARK_CAPTURE(BM_IPv4ToString, loopback, 0x7F000001u) ;
+    FRQS_BENCHMARK_CAPTURE(BM_IPv4ToString, wide, 0xC0A8FFFEu) ;
+
+    void BM_IPv4Parse(bench::State& state) {
+        std::string_view text = "192.168.100.254" ;
+        for (auto _ : state) {
+            net::IPv4 ip(text) ;
+            bench::doNotOptimize(ip) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_IPv4Parse) ;
+
+    void BM_SockAddrToString(bench::State& state) {
+        net::SockAddr addr(net::IPv4(0xC0A8FFFEu), 54321) ;
+        for (auto _ : state) {
+            auto s = addr.toString() ;
+            bench::doNotOptimize(s) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_SockAddrToString) ;
+
+    // Threat-feed sized list: 300k prefixes, mostly /24 to /32 spread over
+    // the whole address space
+    const net::AccessList& benchAccessList() {
+        static const net::AccessList list = [] {
+            std::mt19937 rng(42) ;
+            std::vector<net::AccessList::Rule> rules(300'000) ;
+            for (auto& rule : rules) {
+                rule.prefix = static_cast<uint8_t>(rng() % 4 == 0 ? 8 + rng() % 16 : 24 + rng() % 9) ;
+                rule.network = net::IPv4(static_cast<uint32_t>(rng())) ;
+            }
+            return net::AccessList(rules) ;
+        }() ;
+        return list ;
+    }
+
+    void BM_AccessListMatch(bench::State& state) {
+        const auto& list = benchAccessList() ;
+
+        std::mt19937 rng(7) ;
+        std::vector<uint32_t> addresses(4096) ;
+        for (auto& address : addresses) {
+            address = static_cast<uint32_t>(rng()) ;
+        }
+
+        size_t i = 0 ;
+        for (auto _ : state) {
+            bool permitted = list.permits(addresses[i++ & 4095]) ;
+            bench::doNotOptimize(permitted) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_AccessListMatch) ;
+}
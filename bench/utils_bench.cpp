@@ -0,0 +1,156 @@
+/**
+ * @file bench/utils_bench.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Path security, thread pool, queueing and logging benchmarks
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "harness.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/date_header.hpp"
+#include "utils/fair_queue.hpp"
+#include "utils/filesystem_utils.hpp"
+#include "utils/histogram.hpp"
+#include "utils/logger.hpp"
+#include "utils/thread_pool.hpp"
+#include <fstream>
+#include <future>
+#include <vector>
+
+namespace {
+    using namespace frqs ;
+
+    // Small document root shared by the securePath benchmarks
+    const std::filesystem::path& benchRoot() {
+        static const std::filesystem::path root = [] {
+            auto dir = std::filesystem::temp_directory_path() / "zhttp_bench_root" ;
+            std::filesystem::create_directories(dir / "assets" / "css") ;
+            std::ofstream(dir / "index.html") << "<h1>bench</h1>" ;
+            std::ofstream(dir / "assets" / "css" / "main.css") << "body{}" ;
+            return dir ;
+        }() ;
+        return root ;
+    }
+
+    void BM_NormalizePath(bench::State& state, std::string_view path) {
+        for (auto _ : state) {
+            auto normalized = utils::FileSystemUtils::normalizePath(path) ;
+            bench::doNotOptimize(normalized) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+
+    FRQS_BENCHMARK_CAPTURE(BM_NormalizePath, simple, "/index.html") ;
+    FRQS_BENCHMARK_CAPTURE(BM_NormalizePath, nested, "/assets/css/vendor/bootstrap/bootstrap.min.css") ;
+    FRQS_BENCHMARK_CAPTURE(BM_NormalizePath, traversal, "/images/../../../../etc/./passwd") ;
+
+    void BM_SecurePath(bench::State& state, std::string_view path) {
+        const auto& root = benchRoot() ;
+        for (auto _ : state) {
+            auto resolved = utils::FileSystemUtils::securePath(root, path) ;
+            bench::doNotOptimize(resolved) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+
+    FRQS_BENCHMARK_CAPTURE(BM_SecurePath, existing, "/assets/css/main.css") ;
+    FRQS_BENCHMARK_CAPTURE(BM_SecurePath, missing, "/assets/js/app.js") ;
+    FRQS_BENCHMARK_CAPTURE(BM_SecurePath, traversal, "/../../etc/passwd") ;
+
+    // Submit-to-completion throughput for no-op tasks, in batches
+    void BM_ThreadPoolSubmit(bench::State& state, size_t threads) {
+        constexpr size_t BATCH = 1000 ;
+        utils::ThreadPool pool(threads) ;
+        std::vector<std::future<void>> futures ;
+        futures.reserve(BATCH) ;
+
+        for (auto _ : state) {
+            for (size_t i = 0 ; i < BATCH ; ++i) {
+                futures.push_back(pool.submit([] {})) ;
+            }
+            for (auto& f : futures) {
+                f.wait() ;
+            }
+            futures.clear() ;
+        }
+        state.setItemsProcessed(state.iterations() * BATCH) ;
+    }
+
+    FRQS_BENCHMARK_CAPTURE(BM_ThreadPoolSubmit, threads_1, 1) ;
+    FRQS_BENCHMARK_CAPTURE(BM_ThreadPoolSubmit, threads_4, 4) ;
+
+    // One push and one pop, spread over `clients` flows
+    void BM_FairQueuePushPop(bench::State& state, uint32_t clients) {
+        utils::FairQueue<uint32_t> queue ;
+        uint32_t next = 0 ;
+        for (auto _ : state) {
+            uint32_t key = 0x7F000001u + (next++ % clients) ;
+            (void)queue.push(key, key) ;
+            auto item = queue.pop() ;
+            bench::doNotOptimize(item) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK_CAPTURE(BM_FairQueuePushPop, clients_1, 1) ;
+    FRQS_BENCHMARK_CAPTURE(BM_FairQueuePushPop, clients_1024, 1024) ;
+
+    // A statement below the runtime threshold should cost one branch
+    void BM_LogDisabled(bench::State& state) {
+        auto previous = utils::getLogLevel() ;
+        utils::setLogLevel(utils::Level::ERROR) ;
+        uint16_t port = 8080 ;
+        for (auto _ : state) {
+            utils::logInfo("Connection from {}:{}", "127.0.0.1", port) ;
+            bench::clobberMemory() ;
+        }
+        utils::setLogLevel(previous) ;
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_LogDisabled) ;
+
+    void BM_HistogramRecord(bench::State& state) {
+        auto histogram = std::make_unique<utils::Histogram>() ;
+        uint64_t value = 1 ;
+        for (auto _ : state) {
+            histogram->record(value) ;
+            value = (value * 7 + 13) & 0xFFFFF ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_HistogramRecord) ;
+
+    // A keep-alive request's input buffer: borrowed on the first read and
+    // handed back once the request is consumed
+    void BM_BufferPoolCycle(bench::State& state, size_t size) {
+        utils::BufferPool pool ;
+        for (auto _ : state) {
+            utils::Buffer buffer ;
+            bool ok = pool.reserve(buffer, size) ;
+            buffer.commit(size) ;
+            bench::doNotOptimize(buffer.data()) ;
+            buffer.consume(size) ;
+            bench::doNotOptimize(ok) ;
+        }
+        state.counters["allocations"] = static_cast<double>(pool.allocations()) ;
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK_CAPTURE(BM_BufferPoolCycle, request_1k, 1024) ;
+    FRQS_BENCHMARK_CAPTURE(BM_BufferPoolCycle, request_20k, 20 * 1024) ;
+
+    // What every response pays for its Date and Server lines
+    void BM_DateHeaderRead(bench::State& state) {
+        utils::DateHeader header ;
+        header.setServer("zhttp") ;
+        std::array<char, utils::DateHeader::CAPACITY> block ;
+        for (auto _ : state) {
+            auto lines = header.read(block) ;
+            bench::doNotOptimize(lines) ;
+        }
+        state.setItemsProcessed(state.iterations()) ;
+    }
+    FRQS_BENCHMARK(BM_DateHeaderRead) ;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace frqs::core {
+
+// What to do when the connection limit is reached
+enum class OverloadAction : uint8_t {
+    REJECT,         // Accept, answer 503 and close
+    PAUSE_ACCEPT    // Stop accepting; the kernel backlog pushes back on clients
+} ;
+
+struct AdmissionConfig {
+    size_t max_connections = 10'000 ;              // 0 = unlimited
+    size_t max_queued = 4096 ;                     // Requests waiting for a worker, 0 = unlimited
+    size_t max_queued_per_client = 256 ;           // Per client IPv4, 0 = unlimited
+    std::chrono::milliseconds target_delay{0} ;    // CoDel target queueing delay, 0 disables
+    std::chrono::milliseconds interval{100} ;      // CoDel window, also the normal queueing limit
+    std::chrono::seconds retry_after{1} ;
+    OverloadAction on_max_connections = OverloadAction::REJECT ;
+} ;
+
+// Decides whether work enters the system. Limits on open connections and
+// queued requests are checked by the event loop. Queueing delay follows
+// the server variant of CoDel: if even the fastest dequeue in the last
+// interval waited longer than target_delay the queue is standing, and
+// requests that waited past target_delay are shed at dequeue; otherwise
+// they may wait up to interval.
+class AdmissionControl {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    explicit AdmissionControl(AdmissionConfig config = {}) ;
+
+    AdmissionControl(const AdmissionControl&) = delete ;
+    AdmissionControl& operator=(const AdmissionControl&) = delete ;
+
+    [[nodiscard]] const AdmissionConfig& config() const noexcept { return config_ ; }
+
+    // Prebuilt "503 Service Unavailable" with Retry-After and Connection: close
+    [[nodiscard]] const std::string& overloadResponse() const noexcept { return overload_response_ ; }
+
+    // Event loop
+    [[nodiscard]] bool connectionAllowed(size_t open) const noexcept {
+        return config_.max_connections == 0 || open < config_.max_connections ;
+    }
+    [[nodiscard]] bool tryEnqueue() noexcept ;
+    void cancelEnqueue() noexcept { queued_.fetch_sub(1, std::memory_order_relaxed) ; }
+
+    // Worker, when it picks the request up; true means shed it
+    [[nodiscard]] bool dequeued(Clock::duration waited, Clock::time_point now) noexcept ;
+
+    [[nodiscard]] size_t queued() const noexcept { return queued_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] bool overloaded() const noexcept { return overloaded_.load(std::memory_order_relaxed) ; }
+
+private:
+    AdmissionConfig config_ ;
+    std::string overload_response_ ;
+    uint64_t target_ns_ ;
+    uint64_t interval_ns_ ;
+
+    std::atomic<size_t> queued_{0} ;
+    std::atomic<uint64_t> window_min_ns_ ;
+    std::atomic<int64_t> window_end_ns_{0} ;
+    std::atomic<bool> overloaded_{false} ;
+} ;
+
+} // namespace frqs::core
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "core/task.hpp"
+#include "net/poller.hpp"
+#include "net/socket.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/timer_wheel.hpp"
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace frqs::core {
+
+// Where suspended handler coroutines wait. It shares the server's poller
+// and is driven by the server's event loop, so every resumption after a
+// co_await happens on the loop thread. A coroutine suspended here holds
+// no thread: thousands can wait on timers, sockets or offloaded work
+// while the loop and the pool keep serving. Code between awaits runs on
+// the loop too, so CPU-heavy work belongs in offload().
+class AsyncLoop {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    // Work handed to the loop thread
+    struct Op {
+        Op* next = nullptr ;
+        void (*run)(Op&) = nullptr ;
+    } ;
+
+    struct Timer : utils::TimerWheel::Timer {
+        void (*fire)(Timer&) = nullptr ;
+    } ;
+
+    // Registered with the poller under a tagged pointer
+    struct IoWait {
+        void (*ready)(IoWait&, uint32_t events) = nullptr ;
+    } ;
+
+    AsyncLoop(net::Poller& poller, utils::ThreadPool& pool, std::function<void(void*)> on_finished) ;
+
+    AsyncLoop(const AsyncLoop&) = delete ;
+    AsyncLoop& operator=(const AsyncLoop&) = delete ;
+
+    // Runs the task on the calling thread up to its first suspension.
+    // on_finished(tag) is called once it completes, on the loop or, if it
+    // never suspended, on the calling thread after it returns.
+    template <typename T>
+    void start(Task<T>& task, void* tag) ;
+
+    // Any thread
+    void post(Op& op) noexcept ;
+    void offload(std::function<void()> work) ;
+
+    // Loop thread
+    void arm(Timer& timer, Clock::time_point deadline) noexcept { timers_.arm(timer, deadline) ; }
+    void watch(net::Poller::handle_t handle, uint32_t interest, IoWait& wait) ;
+    void unwatch(net::Poller::handle_t handle) noexcept { poller_.remove(handle) ; }
+
+    // Posted work first, then due timers
+    void run(Clock::time_point now) ;
+    [[nodiscard]] std::optional<Clock::duration> nextTimeout(Clock::time_point now) const noexcept {
+        return timers_.nextTimeout(now) ;
+    }
+
+    // Poller events whose data came from watch()
+    [[nodiscard]] static bool owns(void* data) noexcept { return (reinterpret_cast<uintptr_t>(data) & 1) != 0 ; }
+    static void dispatch(const net::Poller::Event& event) noexcept ;
+
+private:
+    friend void detail::taskFinished(AsyncLoop& loop, void* tag) noexcept ;
+
+    net::Poller& poller_ ;
+    utils::ThreadPool& pool_ ;
+    std::function<void(void*)> on_finished_ ;
+    utils::TimerWheel timers_{std::chrono::milliseconds(1)} ;
+
+    std::mutex posted_mutex_ ;
+    Op* posted_ = nullptr ;   // LIFO; reversed when run
+} ;
+
+template <typename T>
+void AsyncLoop::start(Task<T>& task, void* tag) {
+    auto& promise = task.handle_.promise() ;
+    promise.loop = this ;
+    promise.tag = tag ;
+    promise.holds.store(2, std::memory_order_relaxed) ;
+    task.handle_.resume() ;
+    if (promise.release()) {
+        on_finished_(tag) ;
+    }
+}
+
+namespace detail {
+    // Base of the awaitables: finds the loop through the awaiting promise
+    struct LoopAwaiter : AsyncLoop::Op {
+        AsyncLoop* loop = nullptr ;
+        std::coroutine_handle<> waiter ;
+
+        template <typename Promise>
+        void bind(std::coroutine_handle<Promise> handle) {
+            loop = handle.promise().loop ;
+            waiter = handle ;
+            if (!loop) {
+                throw std::logic_error("Awaited outside an AsyncLoop task") ;
+            }
+        }
+    } ;
+
+    class SleepAwaiter : LoopAwaiter, AsyncLoop::Timer {
+    public:
+        explicit SleepAwaiter(AsyncLoop::Clock::time_point deadline) noexcept : deadline_(deadline) {}
+
+        bool await_ready() const noexcept { return deadline_ <= AsyncLoop::Clock::now() ; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) {
+            bind(handle) ;
+            suspend() ;
+        }
+
+        void await_resume() noexcept {}
+
+    private:
+        AsyncLoop::Clock::time_point deadline_ ;
+
+        void suspend() noexcept ;
+    } ;
+
+    class IoAwaiter : LoopAwaiter, AsyncLoop::Timer, AsyncLoop::IoWait {
+    public:
+        IoAwaiter(const net::Socket& socket, uint32_t interest, AsyncLoop::Clock::duration timeout) noexcept
+            : handle_(socket.native_handle()), interest_(interest), timeout_(timeout) {}
+
+        ~IoAwaiter() ;
+
+        bool await_ready() const noexcept { return false ; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) {
+            bind(handle) ;
+            suspend() ;
+        }
+
+        // False when the timeout expired first. Rethrows when the socket
+        // could not be registered, which is not a timeout.
+        bool await_resume() {
+            if (error_) {
+                std::rethrow_exception(error_) ;
+            }
+            return ready_ ;
+        }
+
+    private:
+        net::Poller::handle_t handle_ ;
+        uint32_t interest_ ;
+        AsyncLoop::Clock::duration timeout_ ;
+        bool watching_ = false ;
+        bool ready_ = false ;
+        std::exception_ptr error_ ;   // From watch()
+
+        void suspend() noexcept ;
+        void finish(bool signalled) noexcept ;
+    } ;
+
+    class HopAwaiter : LoopAwaiter {
+    public:
+        bool await_ready() const noexcept { return false ; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) {
+            bind(handle) ;
+            run = [](AsyncLoop::Op& op) { static_cast<HopAwaiter&>(op).waiter.resume() ; } ;
+            loop->post(*this) ;
+        }
+
+        void await_resume() noexcept {}
+    } ;
+
+    template <typename F>
+    class OffloadAwaiter : LoopAwaiter {
+    public:
+        using Result = std::invoke_result_t<F&> ;
+
+        explicit OffloadAwaiter(F work) : work_(std::move(work)) {}
+
+        bool await_ready() const noexcept { return false ; }
+
+        template <typename Promise>
+        void await_suspend(std::coroutine_handle<Promise> handle) {
+            bind(handle) ;
+            run = [](AsyncLoop::Op& op) { static_cast<OffloadAwaiter&>(op).waiter.resume() ; } ;
+            loop->offload([this] {
+                try {
+                    if constexpr (std::is_void_v<Result>) {
+                        work_() ;
+                    } else {
+                        result_.emplace(work_()) ;
+                    }
+                } catch (...) {
+                    error_ = std::current_exception() ;
+                }
+                loop->post(*this) ;
+            }) ;
+        }
+
+        Result await_resume() {
+            if (error_) {
+                std::rethrow_exception(error_) ;
+            }
+            if constexpr (!std::is_void_v<Result>) {
+                return std::move(*result_) ;
+            }
+        }
+
+    private:
+        using Storage = std::conditional_t<std::is_void_v<Result>, bool, std::optional<Result>> ;
+
+        F work_ ;
+        Storage result_{} ;
+        std::exception_ptr error_ ;
+    } ;
+}
+
+// co_await sleep(50ms): resumes on the loop once the delay has passed
+[[nodiscard]] inline detail::SleepAwaiter sleep(AsyncLoop::Clock::duration delay) noexcept {
+    return detail::SleepAwaiter(AsyncLoop::Clock::now() + delay) ;
+}
+
+// co_await readable(socket, 2s): true once the socket is readable (or
+// closed), false on timeout. The socket must not be registered with the
+// poller already; if registering fails the co_await throws the error. A
+// zero timeout waits indefinitely.
+[[nodiscard]] inline detail::IoAwaiter readable(const net::Socket& socket,
+                                                AsyncLoop::Clock::duration timeout = {}) noexcept {
+    return detail::IoAwaiter(socket, net::Poller::READABLE, timeout) ;
+}
+
+[[nodiscard]] inline detail::IoAwaiter writable(const net::Socket& socket,
+                                                AsyncLoop::Clock::duration timeout = {}) noexcept {
+    return detail::IoAwaiter(socket, net::Poller::WRITABLE, timeout) ;
+}
+
+// co_await resumeOnLoop(): continue on the loop thread, before touching
+// state only the event loop may change
+[[nodiscard]] inline detail::HopAwaiter resumeOnLoop() noexcept {
+    return {} ;
+}
+
+// co_await offload([] { return blockingCall() ; }): runs on the thread
+// pool and resumes on the loop with the result or exception
+template <typename F>
+[[nodiscard]] detail::OffloadAwaiter<std::decay_t<F>> offload(F&& work) {
+    return detail::OffloadAwaiter<std::decay_t<F>>(std::forward<F>(work)) ;
+}
+
+} // namespace frqs::core
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "net/socket.hpp"
+#include "net/sockaddr.hpp"
+
+#ifdef DELETE
+	#undef DELETE
+#endif
+
+#include "core/task.hpp"
+#include "http/method.hpp"
+#include "http/request.hpp"
+#include "http/response.hpp"
+#include "utils/arena.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/timer_wheel.hpp"
+#include "utils/trace.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace frqs::core {
+
+// Per-connection deadlines and limits. Header and body deadlines run from
+// the first byte of the request (not the last read), so a client trickling
+// one byte at a time cannot hold a connection open.
+struct ConnectionConfig {
+    std::chrono::milliseconds header_timeout{10'000} ;      // First byte to end of headers
+    std::chrono::milliseconds body_timeout{30'000} ;        // End of headers to end of body
+    std::chrono::milliseconds write_timeout{30'000} ;       // Whole response
+    std::chrono::milliseconds keep_alive_timeout{5'000} ;   // Idle between requests
+    std::chrono::milliseconds linger_timeout{2'000} ;       // Discarding input after a closing error reply
+    size_t max_header_size = 8192 ;
+    size_t max_requests = 1000 ;                            // Per connection, 0 = unlimited
+    size_t max_buffer_memory = 256 * 1024 * 1024 ;          // Input buffers of all connections, pooled ones included
+    bool keep_alive = true ;
+} ;
+
+// One client connection, owned by the server's event loop. The loop reads
+// and frames requests and writes responses; a worker only touches the
+// buffers while the connection is PROCESSING. The embedded timer holds
+// whichever deadline applies to the current state.
+struct Connection : utils::TimerWheel::Timer {
+    using Clock = std::chrono::steady_clock ;
+
+    enum class State : uint8_t {
+        READING_HEADERS,
+        READING_BODY,
+        PROCESSING,   // Handed to a worker or a suspended coroutine handler
+        WRITING,
+        IDLE,         // Keep-alive, waiting for the next request
+        LINGERING     // Error reply sent and write side shut; dropping input until EOF
+    } ;
+
+    // Outcome of scanning the input buffer for the next request
+    enum class Framing : uint8_t {
+        NEED_HEADERS,
+        NEED_BODY,
+        COMPLETE,
+        HEADERS_TOO_LARGE,
+        BODY_TOO_LARGE,
+        UNSUPPORTED,   // Transfer-Encoding bodies
+        INVALID
+    } ;
+
+    Connection(net::Socket client, net::SockAddr client_addr, Clock::time_point accepted_at, uint64_t accepted_ticks) ;
+
+    net::Socket socket ;
+    net::SockAddr peer ;
+    State state = State::READING_HEADERS ;
+    uint32_t interest = 0 ;          // Poller interest currently registered
+    bool peer_closed = false ;       // EOF or hangup seen; close after the current response
+    bool hung_up = false ;           // Hangup while processing; no longer polled
+    bool keep_alive = false ;        // Decided by the worker for the current request
+    bool linger = false ;            // Closing reply sent with the request possibly unread
+    bool http11 = false ;
+    uint32_t requests_served = 0 ;
+
+    utils::Buffer in ;               // Empty, holding no memory, between requests
+    size_t scanned = 0 ;             // Bytes of in already searched for the header end
+    size_t header_size = 0 ;         // 0 until the headers are complete
+    size_t request_size = 0 ;        // Headers plus body, once known
+
+    // A response goes out as out, then out_tail. out_tail is the part of a
+    // canned or cached wire sent from where it lives; out_owner keeps a
+    // cached one alive until it is written.
+    std::string out ;
+    std::string_view out_tail ;
+    std::shared_ptr<const std::string> out_owner ;
+    size_t out_offset = 0 ;          // Across out and out_tail
+    bool corked = false ;            // TCP_CORK held while a long response drains
+
+    // Backs the request and the response for the current request; declared
+    // ahead of both so it outlives them
+    utils::Arena arena ;
+
+    // Parsed in place and kept until the response is out; a suspended
+    // coroutine handler still holds a reference to it
+    std::optional<http::HTTPRequest> request ;
+    Task<http::HTTPResponse> task ;   // Coroutine handler in flight
+    bool relayed = false ;            // Response went straight to the socket (reverse proxy)
+    size_t bytes_relayed = 0 ;
+
+    // Current request, filled in by the loop and the worker
+    Clock::time_point started_at ;
+    Clock::time_point queued_at ;
+    Clock::time_point handler_start ;
+    utils::trace::RequestTrace trace ;
+    http::Method method = http::Method::UNKNOWN ;
+    std::string path ;
+    uint16_t status = 0 ;
+    size_t route = 0 ;
+    size_t worker = 0 ;
+    uint32_t handler_us = 0 ;
+
+    // Appends whatever the socket has, growing in from the pool only while
+    // the request is still incomplete; false once the peer has closed.
+    // Socket errors come back as the error, and no_buffer_space when the
+    // pool is at its limit.
+    [[nodiscard]] net::Expected<bool> receive(utils::BufferPool& pool, const ConnectionConfig& config) noexcept ;
+
+    [[nodiscard]] Framing frame(const ConnectionConfig& config) ;
+
+    // Reads and drops whatever the socket has; false once the peer has
+    // closed. Nothing is buffered.
+    [[nodiscard]] net::Expected<bool> discard() noexcept ;
+
+    // Serializes response into out for the current request: the Connection
+    // header keep_alive and http11 call for, headers (the Date/Server
+    // block) after the status line, and no body for HEAD. Allocation-free
+    // once out and the response's resource have grown to size.
+    void serialize(http::HTTPResponse& response, std::string_view headers) ;
+
+    // Writes pending output; true when all of it is sent
+    [[nodiscard]] net::Expected<bool> flush() noexcept ;
+
+    [[nodiscard]] size_t outSize() const noexcept { return out.size() + out_tail.size() ; }
+
+    // Drops the finished request and resets per-request state
+    void advance() ;
+} ;
+
+} // namespace frqs::core
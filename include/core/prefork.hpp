@@ -0,0 +1,114 @@
+#pragma once
+
+#include "core/server.hpp"
+#include "net/socket.hpp"
+#include "net/socket_profile.hpp"
+#include "utils/metrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#ifndef _WIN32
+    #include <sys/types.h>
+#endif
+
+namespace frqs::core {
+
+struct PreforkConfig {
+    size_t workers = 0 ;                                      // Processes; 0 = one per CPU
+    size_t threads = 1 ;                                      // Worker threads per process; sizes the shared counters
+    bool reuse_port = true ;                                  // A SO_REUSEPORT listener per worker instead of one shared
+    net::SocketProfile listener = net::SocketProfile::latency() ;
+    std::vector<int> cpus ;                                   // Worker i pinned to cpus[i % size]; empty = unpinned
+    std::chrono::milliseconds restart_backoff{100} ;          // Doubles while workers keep dying young
+    std::chrono::milliseconds max_restart_backoff{5'000} ;
+    std::chrono::milliseconds shutdown_timeout{10'000} ;      // Then the stragglers get SIGKILL
+} ;
+
+// Multi-process mode: a master forks workers that each run their own
+// Server on the same port, and restarts any that die. With reuse_port
+// every worker binds its own listener and the kernel spreads connections
+// among them, waking one process each; without it the master binds one
+// listener that all workers inherit, and every worker wakes for each
+// connection with the quickest accept winning.
+//
+// Request counters live in an anonymous shared mapping made before the
+// first fork. Each thread of each worker writes its own slot there just as
+// in a single process, and any worker's metrics sum every slot, so totals
+// cover the whole group with no locks or messages. Latency histograms and
+// gauges stay per process.
+//
+//     Prefork prefork(port, config) ;
+//     if (prefork.run()) {           // Returns a value only in a worker
+//         Server server(port, config.threads) ;
+//         ...
+//         prefork.attach(server) ;
+//         server.start() ;
+//     }
+class Prefork {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    // Maps the shared counters and, without reuse_port, binds the
+    // listener. Throws std::runtime_error (always on Windows).
+    Prefork(uint16_t port, PreforkConfig config) ;
+    ~Prefork() ;
+
+    Prefork(const Prefork&) = delete ;
+    Prefork& operator=(const Prefork&) = delete ;
+    Prefork(Prefork&&) = delete ;
+    Prefork& operator=(Prefork&&) = delete ;
+
+    // Master: forks the workers and supervises them until stop(), then
+    // returns nullopt once every one has exited. Worker: returns its index
+    // straight after the fork.
+    [[nodiscard]] std::optional<size_t> run() ;
+
+    // In a worker, after enableMetrics and before start(): gives server the
+    // listener (or its own SO_REUSEPORT one) and config.listener as its
+    // socket profile, and moves its counters into the shared slots
+    void attach(Server& server) ;
+
+    // Async-signal-safe. In the master, stops restarting and sends the
+    // workers SIGTERM; in a worker whose server is not running yet, exits.
+    void stop() noexcept ;
+
+    [[nodiscard]] bool isWorker() const noexcept { return worker_.has_value() ; }
+    [[nodiscard]] const PreforkConfig& config() const noexcept { return config_ ; }
+
+    // Across all workers, live and dead
+    [[nodiscard]] uint64_t total(utils::Metrics::Counter counter) const noexcept ;
+    [[nodiscard]] uint64_t restarts() const noexcept ;
+
+private:
+    struct Shared ;
+
+#ifdef _WIN32
+    using pid_t = int ;
+#endif
+
+    PreforkConfig config_ ;
+    size_t slots_per_worker_ ;
+    std::optional<net::Socket> listener_ ;   // Without reuse_port
+
+    void* mapping_ = nullptr ;
+    size_t mapping_size_ = 0 ;
+    Shared* shared_ = nullptr ;
+    std::span<utils::Metrics::CounterSlot> slots_ ;
+
+    pid_t master_pid_ = 0 ;
+    std::unique_ptr<std::atomic<pid_t>[]> pids_ ;   // By worker, 0 while not running; read by stop()
+    std::atomic<bool> stopping_{false} ;
+    std::optional<size_t> worker_ ;                 // Set in a worker
+
+    // Connections a dead worker had open were closed with it
+    void settle(size_t worker) noexcept ;
+    void becomeWorker(size_t worker) ;
+    void shutdown() ;
+} ;
+
+} // namespace frqs::core
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace frqs::core {
+
+struct RateLimitConfig {
+    double rate = 0 ;                          // Requests per second per client IPv4, 0 disables
+    uint32_t burst = 0 ;                       // Bucket size, 0 = one second's worth
+    size_t max_clients = 16'384 ;              // Table slots, rounded up to a power of two
+    std::chrono::seconds retry_after{1} ;
+} ;
+
+// Per-client token buckets in a fixed-size, open-addressed table. Every
+// operation is a handful of relaxed atomics on one or two cache lines:
+// a client probes a short window of slots, claims an empty one with a CAS,
+// and when the window is full takes over the slot refilled longest ago if
+// that one has been idle long enough to be full. Clients that find no slot
+// share a single overflow bucket.
+// Buckets refill lazily from the caller's clock, so an idle client costs
+// nothing. Races between two threads touching the same client, or an
+// eviction overlapping an update, can grant or deny one extra request;
+// the limit is approximate, never blocking.
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    explicit RateLimiter(RateLimitConfig config = {}) ;
+    ~RateLimiter() ;
+
+    RateLimiter(const RateLimiter&) = delete ;
+    RateLimiter& operator=(const RateLimiter&) = delete ;
+
+    [[nodiscard]] const RateLimitConfig& config() const noexcept { return config_ ; }
+    [[nodiscard]] bool enabled() const noexcept { return refill_per_s_ != 0 ; }
+
+    // Prebuilt "429 Too Many Requests" with Retry-After and Connection: close
+    [[nodiscard]] const std::string& limitedResponse() const noexcept { return limited_response_ ; }
+
+    // Takes a token; false when the client is over its rate
+    [[nodiscard]] bool allow(uint32_t client, Clock::time_point now) noexcept ;
+
+    // True when the client has no token left. Takes nothing and does not
+    // start tracking unknown clients.
+    [[nodiscard]] bool exhausted(uint32_t client, Clock::time_point now) const noexcept ;
+
+    [[nodiscard]] uint64_t evictions() const noexcept { return evictions_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] uint64_t overflows() const noexcept { return overflows_.load(std::memory_order_relaxed) ; }
+
+private:
+    // bucket packs the last refill time (ms, high 40 bits) with the tokens
+    // left (1/256ths, low 24 bits) so both change in one CAS
+    struct alignas(16) Entry {
+        std::atomic<uint32_t> key{0} ;     // 0 = empty
+        std::atomic<uint64_t> bucket{0} ;
+    } ;
+
+    RateLimitConfig config_ ;
+    std::string limited_response_ ;
+    Clock::time_point epoch_ ;
+    uint64_t refill_per_s_ = 0 ;       // Token 1/256ths per second
+    uint64_t capacity_ = 0 ;           // Token 1/256ths
+    uint64_t fill_ms_ = 0 ;            // Empty to full
+    size_t mask_ = 0 ;
+    std::unique_ptr<Entry[]> table_ ;
+    Entry overflow_ ;                  // Shared by clients without a slot
+    std::atomic<uint64_t> evictions_{0} ;
+    std::atomic<uint64_t> overflows_{0} ;
+
+    [[nodiscard]] uint64_t stamp(Clock::time_point now) const noexcept ;
+    [[nodiscard]] uint64_t refill(uint64_t bucket, uint64_t now_ms) const noexcept ;
+    [[nodiscard]] bool take(Entry& entry, uint64_t now_ms) noexcept ;
+    void reset(Entry& entry, uint32_t key, uint64_t now_ms) noexcept ;
+} ;
+
+} // namespace frqs::core
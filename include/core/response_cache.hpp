@@ -0,0 +1,133 @@
+#pragma once
+
+#ifdef DELETE
+	#undef DELETE
+#endif
+
+#include "http/request.hpp"
+#include "http/response.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace frqs::core {
+
+struct ResponseCacheConfig {
+    size_t max_bytes = 64 * 1024 * 1024 ;      // Keys and serialized responses, all shards together
+    size_t max_entry_bytes = 1024 * 1024 ;     // Larger responses are never stored
+    std::chrono::seconds default_ttl{0} ;      // For responses without max-age; 0 = those are not cached
+    std::chrono::seconds stale_ttl{10} ;       // Unless the response sets stale-while-revalidate
+    std::vector<std::string> vary ;            // Request headers that are part of the key
+} ;
+
+// Micro-cache for handler responses. GET and HEAD requests without
+// Authorization are keyed on method, path, the query parameters sorted by
+// name and the configured vary headers. A response is stored only when it
+// opts in through Cache-Control (s-maxage or max-age, or default_ttl) and
+// has no Set-Cookie, no private/no-store/no-cache and no Vary beyond the
+// configured headers.
+//
+// Entries hold the response fully serialized, without a Connection header,
+// so a hit is a copy into the output buffer and one send. Once past its
+// TTL an entry is served stale for the stale-while-revalidate window while
+// exactly one caller is told to refresh it; after that it is dropped.
+//
+// Entries are spread over SHARDS independently locked LRU lists, each
+// limited to its share of max_bytes.
+class ResponseCache {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    static constexpr size_t SHARDS = 16 ;
+
+    struct Entry {
+        std::string wire ;        // Status line, headers, blank line, body
+        size_t head_size = 0 ;    // Through the blank line, what HEAD sends
+        uint16_t status = 0 ;
+        Clock::time_point fresh_until ;
+        Clock::time_point stale_until ;
+    } ;
+
+    struct Hit {
+        std::shared_ptr<const Entry> entry ;
+        bool stale = false ;
+        bool refresh = false ;    // Caller owns the refresh; store() or abandon() when done
+    } ;
+
+    struct Stats {
+        uint64_t hits = 0 ;
+        uint64_t stale_hits = 0 ;
+        uint64_t misses = 0 ;
+        uint64_t stores = 0 ;
+        uint64_t evictions = 0 ;  // Dropped to make room
+        uint64_t expired = 0 ;    // Dropped past the stale window
+    } ;
+
+    explicit ResponseCache(ResponseCacheConfig config = {}) ;
+
+    ResponseCache(const ResponseCache&) = delete ;
+    ResponseCache& operator=(const ResponseCache&) = delete ;
+
+    [[nodiscard]] const ResponseCacheConfig& config() const noexcept { return config_ ; }
+
+    // Whether the request may be answered from, or fill, the cache
+    [[nodiscard]] bool accepts(const http::HTTPRequest& request) const noexcept ;
+
+    [[nodiscard]] std::string key(const http::HTTPRequest& request) const ;
+
+    [[nodiscard]] std::optional<Hit> find(std::string_view key, Clock::time_point now) ;
+
+    // Serializes and stores a cacheable response, replacing any entry for
+    // key. nullptr when it is not cacheable; the old entry is gone anyway.
+    std::shared_ptr<const Entry> store(std::string key, const http::HTTPResponse& response, Clock::time_point now) ;
+
+    // A refresh handed out by find() failed; the stale entry stays
+    void abandon(std::string_view key) ;
+
+    [[nodiscard]] Stats stats() const noexcept ;
+    [[nodiscard]] size_t bytes() const noexcept { return bytes_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] size_t entries() const noexcept { return entries_.load(std::memory_order_relaxed) ; }
+
+private:
+    struct Item {
+        std::string key ;
+        std::shared_ptr<const Entry> entry ;
+        size_t bytes = 0 ;
+        bool refreshing = false ;
+    } ;
+
+    // Most recently used at the front; index keys view Item::key
+    struct alignas(64) Shard {
+        std::mutex mutex ;
+        std::list<Item> lru ;
+        std::unordered_map<std::string_view, std::list<Item>::iterator> index ;
+        size_t bytes = 0 ;
+    } ;
+
+    ResponseCacheConfig config_ ;
+    size_t shard_budget_ ;
+    std::array<Shard, SHARDS> shards_ ;
+
+    std::atomic<uint64_t> hits_{0} ;
+    std::atomic<uint64_t> stale_hits_{0} ;
+    std::atomic<uint64_t> misses_{0} ;
+    std::atomic<uint64_t> stores_{0} ;
+    std::atomic<uint64_t> evictions_{0} ;
+    std::atomic<uint64_t> expired_{0} ;
+    std::atomic<size_t> bytes_{0} ;
+    std::atomic<size_t> entries_{0} ;
+
+    [[nodiscard]] Shard& shardFor(std::string_view key) noexcept ;
+    void erase(Shard& shard, std::list<Item>::iterator item) noexcept ;
+} ;
+
+} // namespace frqs::core
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "core/connection.hpp"
+#include "core/task.hpp"
+#include "core/upstream.hpp"
+#include "net/poller.hpp"
+
+#ifdef DELETE
+	#undef DELETE
+#endif
+
+#include "http/response.hpp"
+#include <memory>
+
+namespace frqs::core {
+
+// Forwards requests on a route to an Upstream and relays the answer. The
+// request line and headers are rewritten for the backend (hop-by-hop
+// headers dropped, X-Forwarded-For appended) and the already framed body
+// is sent from the connection's input buffer without a copy. Once the
+// backend's response head is in, the client socket is taken off the
+// poller and the body is streamed through a fixed read buffer with
+// backpressure in both directions, so a large response never sits in
+// memory. Content-Length and chunked bodies keep both connections alive;
+// HTTP/1.0 clients get chunked bodies decoded and the connection closed.
+//
+// Failures before anything was sent become 502 (unreachable or broken
+// backend), 504 (timeout) or 503 (every backend down). A failure mid-body
+// can only close the client connection.
+class ReverseProxy {
+public:
+    // connection_config is the server's, read per request for write_timeout
+    ReverseProxy(std::shared_ptr<Upstream> upstream, net::Poller& poller, const ConnectionConfig& connection_config) ;
+
+    // Runs as the connection's coroutine handler. Sets conn.relayed once
+    // the response is on its way straight to the socket; the returned
+    // response is only meaningful when it is not.
+    [[nodiscard]] Task<http::HTTPResponse> relay(Connection& conn) const ;
+
+    [[nodiscard]] Upstream& upstream() const noexcept { return *upstream_ ; }
+
+private:
+    std::shared_ptr<Upstream> upstream_ ;
+    net::Poller& poller_ ;
+    const ConnectionConfig& connection_config_ ;
+} ;
+
+} // namespace frqs::core
@@ -2,24 +2,61 @@
 
 #include "net/socket.hpp"
 #include "net/sockaddr.hpp"
+#include "net/poller.hpp"
+#include "net/access_list.hpp"
+#include "net/socket_profile.hpp"
 
 #ifdef DELETE
 	#undef DELETE
 #endif
 
+#include "core/admission.hpp"
+#include "core/async.hpp"
+#include "core/connection.hpp"
+#include "core/rate_limiter.hpp"
+#include "core/response_cache.hpp"
+#include "core/reverse_proxy.hpp"
+#include "core/single_flight.hpp"
+#include "core/upstream.hpp"
+#include "http/canned_response.hpp"
 #include "http/request.hpp"
 #include "http/response.hpp"
+#include "http/router.hpp"
 #include "utils/thread_pool.hpp"
+#include "utils/access_log.hpp"
+#include "utils/metrics.hpp"
+#include "utils/trace.hpp"
+#include "utils/timer_wheel.hpp"
+#include "utils/fair_queue.hpp"
+#include "utils/buffer_pool.hpp"
+#include "utils/date_header.hpp"
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
 
 namespace frqs::core {
 
+// Dedicated-core mode, trading CPU for latency: the event loop polls
+// without blocking and idle workers spin on the task queue instead of
+// parking, each backing off to blocking once idle for idle_timeout.
+struct BusyPollConfig {
+    std::chrono::milliseconds idle_timeout{5} ;
+    std::vector<int> cpus ;              // Event loop on cpus[0], workers round-robin on the rest; empty = unpinned
+    int socket_busy_poll = 0 ;           // SO_BUSY_POLL microseconds on the listener; needs CAP_NET_ADMIN
+    bool prefer_busy_poll = false ;      // SO_PREFER_BUSY_POLL; likewise
+} ;
+
 class Server {
 public:
     using RequestHandler = std::function<http::HTTPResponse(const http::HTTPRequest&)> ;
+    using AsyncHandler = std::function<Task<http::HTTPResponse>(const http::HTTPRequest&)> ;
+    using Clock = std::chrono::steady_clock ;
     
     explicit Server(
         uint16_t port = 8080,
@@ -37,12 +74,79 @@ public:
     // Configuration
     void setDocumentRoot(const std::filesystem::path& root) ;
     void setDefaultFile(std::string filename) ;
+    
+    // Server header sent with every response next to Date; empty (the
+    // default) sends none
+    void setServerHeader(std::string_view name) ;
     void setRequestHandler(RequestHandler handler) ;
     
+    // Setup-time. Routes are tried first, then the request handler, then
+    // static files. Patterns take ":name" and a trailing "*name" segment;
+    // captures are available through HTTPRequest::getParam.
+    void route(http::Method method, std::string_view pattern, RequestHandler handler) ;
+    
+    // Fixed reply (a health check, say) sent as is, without calling a
+    // handler or building a response; middleware does not see it
+    void route(http::Method method, std::string_view pattern, http::CannedResponse response) ;
+    
+    // Coroutine handler: starts on a worker, and after its first co_await
+    // (sleep, readable/writable, offload) resumes on the event loop. A
+    // suspended handler holds no thread. No server deadline covers a
+    // handler, so every wait on an outside service needs its own timeout.
+    void routeAsync(http::Method method, std::string_view pattern, AsyncHandler handler) ;
+    
+    // Forward every method on pattern to upstream's backends. One Upstream
+    // may serve several patterns; its pool and health are shared.
+    void proxy(std::string_view pattern, std::shared_ptr<Upstream> upstream) ;
+    
+    void enableAccessLog(utils::AccessLogConfig config = {}) ;
+    
+    // Read/write deadlines, keep-alive and request size limits
+    void setConnectionConfig(ConnectionConfig config) ;
+    
+    // Listener socket options (SocketProfile::latency() by default); takes
+    // effect on the next start()
+    void setSocketProfile(net::SocketProfile profile) ;
+    [[nodiscard]] const net::SocketProfile& socketProfile() const noexcept { return socket_profile_ ; }
+    
+    // Accept on a socket that is already bound and listening (one inherited
+    // from a prefork master, say) instead of binding the port; the socket
+    // profile is not applied to it. Takes effect on the next start().
+    void setListener(net::Socket listener) ;
+    
+    // See BusyPollConfig; call before start()
+    void enableBusyPolling(BusyPollConfig config = {}) ;
+    
+    // Connection, queue and queueing-delay limits; excess load gets a 503
+    void setAdmissionConfig(AdmissionConfig config) ;
+    
+    // Per client IPv4 token buckets; requests over the rate get a 429
+    void setRateLimit(RateLimitConfig config) ;
+    
+    // CIDR allow/deny list checked right after accept; nullptr disables.
+    // Safe to call while running: the loop picks the new list up on its
+    // next accept.
+    void setAccessList(std::shared_ptr<const net::AccessList> list) ;
+    
+    // Serve Prometheus metrics at path (checked before any other handler)
+    void enableMetrics(std::string path = "/metrics") ;
+    [[nodiscard]] utils::Metrics* getMetrics() noexcept { return metrics_.get() ; }
+    
+    // Cache RequestHandler responses that allow it (see ResponseCache),
+    // serving stale entries while one background refresh runs
+    void enableResponseCache(ResponseCacheConfig config = {}) ;
+    
+    // Write sampled and slow request phase timings as Chrome trace JSON
+    void enableTracing(utils::trace::TracerConfig config = {}) ;
+    
     // Server control
     void start() ;
     void stop() ;
     
+    // stop() without the log line: only a lock-free store and a write to
+    // the poller's wake fd, so it is safe from a signal handler
+    void requestStop() noexcept ;
+    
     [[nodiscard]] bool isRunning() const noexcept { return running_ ; }
     [[nodiscard]] uint16_t getPort() const noexcept { return port_ ; }
 
@@ -52,17 +156,121 @@ private:
     std::string default_file_ = "index.html" ;
     
     std::unique_ptr<net::Socket> server_socket_ ;
+    std::optional<net::Socket> inherited_listener_ ;
     std::unique_ptr<utils::ThreadPool> thread_pool_ ;
     
     std::atomic<bool> running_{false} ;
     RequestHandler custom_handler_ ;
+    http::Router router_ ;
+    std::vector<AsyncHandler> async_routes_ ;   // By router route, empty for plain handlers
+    std::vector<std::shared_ptr<const ReverseProxy>> proxy_routes_ ;   // By router route
+    std::vector<std::unique_ptr<const http::CannedResponse>> canned_routes_ ;   // By router route
+    std::vector<size_t> route_metrics_ ;   // Metrics route id per router route
+    std::unique_ptr<utils::AccessLog> access_log_ ;
+    std::unique_ptr<utils::Metrics> metrics_ ;
+    std::unique_ptr<utils::trace::Tracer> tracer_ ;
+    std::unique_ptr<ResponseCache> response_cache_ ;
+    SingleFlight flights_ ;   // Static files and response cache misses
+    std::string metrics_path_ ;
+    size_t static_route_ = 0 ;
+    size_t handler_route_ = 0 ;
+    size_t metrics_route_ = 0 ;
+    
+    // Event loop state, touched only by the thread running start()
+    ConnectionConfig connection_config_ ;
+    net::SocketProfile socket_profile_ = net::SocketProfile::latency() ;
+    std::optional<BusyPollConfig> busy_poll_ ;
+    std::atomic<bool> loop_spinning_{false} ;   // Workers skip the wakeup while set
+    std::unique_ptr<AdmissionControl> admission_ ;
+    std::unique_ptr<RateLimiter> rate_limiter_ ;
+    std::atomic<std::shared_ptr<const net::AccessList>> access_list_ ;
+    Clock::time_point loop_time_ ;   // Read once per loop iteration
+    
+    // Requests waiting for a worker, served round-robin per client address
+    std::unique_ptr<utils::FairQueue<Connection*>> fair_queue_ ;
+    std::atomic<bool> accept_paused_{false} ;
+    std::unique_ptr<net::Poller> poller_ ;
+    std::unique_ptr<AsyncLoop> async_ ;   // Outlives connections_ and the coroutines they hold
+    utils::TimerWheel timers_ ;
+    utils::DateHeader date_header_ ;
+    utils::BufferPool buffers_ ;   // Outlives connections_, whose input buffers it lends
+    std::unordered_map<Connection*, std::unique_ptr<Connection>> connections_ ;
+    
+    // Connections whose response a worker has finished
+    std::mutex completions_mutex_ ;
+    std::vector<Connection*> completions_ ;
+    std::vector<Connection*> draining_ ;   // Event loop only
+    
+    // Event loop
+    void eventLoop() ;
+    void acceptConnections() ;
+    Connection* addConnection(net::Socket client, const net::SockAddr& client_addr,
+                              Clock::time_point accepted_at, uint64_t accepted_ticks) ;
+    void shedConnection(net::Socket client, const net::SockAddr& client_addr, utils::Metrics::Counter reason,
+                        uint16_t status, std::string_view wire) ;
+    void pauseAccept(bool paused) ;
+    void onReadable(Connection& conn) ;
+    void processInput(Connection& conn) ;
+    void beginRequest(Connection& conn) ;
+    void dispatch(Connection& conn) ;
+    void reject(Connection& conn, const http::CannedResponse& response) ;
+    void respondAndClose(Connection& conn, uint16_t status, std::string_view wire) ;
+    void respondAndClose(Connection& conn, const http::CannedResponse& response) ;
+    size_t drainCompletions() ;
+    void writeResponse(Connection& conn) ;
+    void lingerClose(Connection& conn) ;
+    void onLingering(Connection& conn) ;
+    void finishRequest(Connection& conn) ;
+    void onTimeout(Connection& conn) ;
+    void setInterest(Connection& conn, uint32_t interest) ;
+    void closeConnection(Connection& conn) ;
+    void closeAll() ;
+    
+    // Runs on a worker
+    void process(Connection& conn) ;
+    // Serializes and resets response (it lives in conn's arena, which the
+    // loop recycles once the connection is handed back), then hands it back
+    void respond(Connection& conn, std::optional<http::HTTPResponse>& response) ;
+    void complete(Connection& conn) ;
+    
+    // A coroutine handler finished, on the loop (or a worker if it never suspended)
+    void finishAsync(Connection& conn) ;
+    
+    [[nodiscard]] size_t metricsSlot() const noexcept ;
+    void recordAccess(const Connection& conn) ;
+    
+    // nullopt when the request was answered already (from the cache) or
+    // a coroutine handler took it over
+    std::optional<http::HTTPResponse> handleRequest(Connection& conn) ;
+    std::optional<http::HTTPResponse> callHandler(Connection& conn, const RequestHandler& handler) ;
+    std::optional<http::HTTPResponse> serveStatic(Connection& conn) ;
+    
+    // Answer with a serialized response that has no Connection header; the
+    // body is sent straight from wire, which the connection holds until then
+    void respondWire(Connection& conn, std::shared_ptr<const std::string> wire, size_t head_size, uint16_t status) ;
+    
+    void respondCanned(Connection& conn, const http::CannedResponse& response) ;
+    
+    // Sends wire with the Date/Server block and connection (a Connection
+    // header line, or empty) after its status line. Only the status line and
+    // those go into conn.out; the rest of wire is written from where it is,
+    // which must stay put until then: static, or kept alive by owner.
+    void spliceWire(Connection& conn, std::string_view wire, std::string_view connection,
+                    std::shared_ptr<const std::string> owner = {}) ;
+    
+    // Coalesced requests: share the leader's response, or compute their
+    // own when it may not be shared
+    void respondWaiters(const std::vector<Connection*>& waiters, const std::shared_ptr<const std::string>& wire,
+                        size_t head_size, uint16_t status) ;
+    void computeAlone(std::vector<Connection*> waiters, const RequestHandler& handler) ;
     
-    // Internal handlers
-    void acceptLoop() ;
-    void handleClient(net::Socket client, net::SockAddr client_addr) ;
+    // Background refresh of a stale cache entry, on a worker
+    void revalidate(const std::string& raw, const std::string& key) ;
+    [[nodiscard]] const RequestHandler* findHandler(http::HTTPRequest& request) const ;
     
-    http::HTTPResponse handleRequest(const http::HTTPRequest& request) ;
-    http::HTTPResponse serveStaticFile(const http::HTTPRequest& request) ;
+    // The file a static request names, or the canned reply when there is none to serve
+    const http::CannedResponse* resolveStatic(const http::HTTPRequest& request, std::filesystem::path& file) const ;
+    http::HTTPResponse serveStaticFile(const http::HTTPRequest& request, const std::filesystem::path& file) ;
 } ;
 
 } // namespace frqs::core
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "core/connection.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace frqs::core {
+
+// Request coalescing. The first connection to join a key leads and
+// computes the response; connections joining the same key before the
+// leader finishes are parked here instead of computing it again. They
+// keep their worker free while they wait: the leader answers them all
+// from its result (or, when the result may not be shared, hands them
+// back to the pool to compute their own).
+//
+// Parked connections stay PROCESSING, so the event loop never closes
+// them underneath the leader.
+class SingleFlight {
+public:
+    static constexpr size_t SHARDS = 16 ;
+
+    SingleFlight() = default ;
+
+    SingleFlight(const SingleFlight&) = delete ;
+    SingleFlight& operator=(const SingleFlight&) = delete ;
+
+    // true when conn leads and must call finish(key); false when it was
+    // parked behind the current leader
+    [[nodiscard]] bool join(const std::string& key, Connection& conn) ;
+
+    // Ends the flight; the leader now owns the parked connections
+    [[nodiscard]] std::vector<Connection*> finish(const std::string& key) ;
+
+    // Requests that waited on a leader instead of computing
+    [[nodiscard]] uint64_t coalesced() const noexcept { return coalesced_.load(std::memory_order_relaxed) ; }
+
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex ;
+        std::unordered_map<std::string, std::vector<Connection*>> flights ;
+    } ;
+
+    std::array<Shard, SHARDS> shards_ ;
+    std::atomic<uint64_t> coalesced_{0} ;
+
+    [[nodiscard]] Shard& shardFor(const std::string& key) noexcept ;
+} ;
+
+} // namespace frqs::core
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "utils/frame_pool.hpp"
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace frqs::core {
+
+class AsyncLoop ;
+
+namespace detail {
+    // Called when a top-level task finishes; defined with AsyncLoop
+    void taskFinished(AsyncLoop& loop, void* tag) noexcept ;
+
+    struct TaskPromiseBase {
+        std::coroutine_handle<> continuation ;   // Awaiting parent, if any
+        AsyncLoop* loop = nullptr ;              // Inherited from the parent
+        void* tag = nullptr ;                    // Top-level only
+        std::exception_ptr error ;
+
+        // A top-level task is reported finished by whichever of its final
+        // suspend and AsyncLoop::start (once resume() has returned) comes
+        // second, so the frame is never released under a running resume()
+        std::atomic<uint32_t> holds{0} ;
+
+        [[nodiscard]] bool release() noexcept { return holds.fetch_sub(1, std::memory_order_acq_rel) == 1 ; }
+
+        std::suspend_always initial_suspend() noexcept { return {} ; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false ; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+                auto& promise = self.promise() ;
+                if (promise.continuation) {
+                    return promise.continuation ;
+                }
+                // The owner may destroy this frame as soon as it hears, so
+                // nothing in it is touched afterwards
+                if (promise.loop && promise.release()) {
+                    detail::taskFinished(*promise.loop, promise.tag) ;
+                }
+                return std::noop_coroutine() ;
+            }
+
+            void await_resume() noexcept {}
+        } ;
+
+        FinalAwaiter final_suspend() noexcept { return {} ; }
+
+        void unhandled_exception() noexcept { error = std::current_exception() ; }
+
+        // Frames come from the pool; the compiler passes the frame size back
+        static void* operator new(size_t size) { return utils::FramePool::allocate(size) ; }
+        static void operator delete(void* frame, size_t size) noexcept { utils::FramePool::deallocate(frame, size) ; }
+    } ;
+
+    template <typename T>
+    struct TaskPromise : TaskPromiseBase {
+        std::optional<T> value ;
+
+        template <typename U>
+        void return_value(U&& result) { value.emplace(std::forward<U>(result)) ; }
+
+        T take() {
+            if (error) {
+                std::rethrow_exception(error) ;
+            }
+            return std::move(*value) ;
+        }
+    } ;
+
+    template <>
+    struct TaskPromise<void> : TaskPromiseBase {
+        void return_void() noexcept {}
+
+        void take() {
+            if (error) {
+                std::rethrow_exception(error) ;
+            }
+        }
+    } ;
+}
+
+// Lazily started coroutine. Awaiting a Task runs it to completion with
+// the awaiting coroutine as its continuation (symmetric transfer, no
+// stack growth) and yields its result or rethrows its exception. A
+// top-level task is started with AsyncLoop::start and reports back through
+// the loop when it finishes.
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+    struct promise_type : detail::TaskPromise<T> {
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this)) ;
+        }
+    } ;
+
+    Task() noexcept = default ;
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset() ;
+            handle_ = std::exchange(other.handle_, {}) ;
+        }
+        return *this ;
+    }
+    ~Task() { reset() ; }
+
+    Task(const Task&) = delete ;
+    Task& operator=(const Task&) = delete ;
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(handle_) ; }
+    [[nodiscard]] bool done() const noexcept { return handle_ && handle_.done() ; }
+
+    // Result of a finished task; rethrows what the coroutine threw
+    T result() { return handle_.promise().take() ; }
+
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy() ;
+            handle_ = {} ;
+        }
+    }
+
+    struct Awaiter {
+        std::coroutine_handle<promise_type> child ;
+
+        bool await_ready() noexcept { return false ; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> parent) noexcept {
+            child.promise().continuation = parent ;
+            child.promise().loop = parent.promise().loop ;
+            return child ;
+        }
+
+        T await_resume() { return child.promise().take() ; }
+    } ;
+
+    Awaiter operator co_await() && noexcept { return Awaiter{handle_} ; }
+
+private:
+    friend class AsyncLoop ;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_ ;
+} ;
+
+} // namespace frqs::core
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "net/sockaddr.hpp"
+#include "net/socket.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace frqs::core {
+
+struct UpstreamConfig {
+    std::vector<net::SockAddr> backends ;
+    size_t max_idle = 32 ;                                   // Pooled keep-alive connections per backend
+    std::chrono::milliseconds connect_timeout{2'000} ;
+    std::chrono::milliseconds response_timeout{30'000} ;     // Per read while waiting on a backend
+    std::chrono::milliseconds idle_timeout{30'000} ;         // Pooled connections idle longer are closed
+    uint32_t max_failures = 3 ;                              // Consecutive failures that mark a backend down
+    std::chrono::milliseconds retry_interval{5'000} ;        // How often a down backend gets a trial request
+} ;
+
+// Backends behind one proxied route. Each request goes to the healthy
+// backend with the fewest requests in flight, so a slow backend drains
+// naturally instead of receiving its round-robin share. Health is passive:
+// failed connects, resets and timeouts count against a backend, and after
+// max_failures in a row it is skipped until retry_interval has passed,
+// when a single request is let through to probe it.
+//
+// Each backend keeps a LIFO stack of idle keep-alive connections, so the
+// most recently used (least likely to have been closed by the backend) is
+// reused first.
+class Upstream {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    // A connection to use for one request
+    struct Lease {
+        size_t backend = 0 ;
+        std::optional<net::Socket> socket ;   // Empty when a new connection is needed
+        bool reused = false ;                 // Came from the pool; the backend may have closed it
+    } ;
+
+    // Throws std::runtime_error without backends
+    explicit Upstream(UpstreamConfig config) ;
+
+    Upstream(const Upstream&) = delete ;
+    Upstream& operator=(const Upstream&) = delete ;
+
+    // "host:port,host:port"; throws std::runtime_error on a bad address
+    [[nodiscard]] static std::vector<net::SockAddr> parseBackends(std::string_view list) ;
+
+    [[nodiscard]] const UpstreamConfig& config() const noexcept { return config_ ; }
+
+    // nullopt when every backend is down and none is due for a probe
+    [[nodiscard]] std::optional<Lease> acquire(Clock::time_point now) ;
+
+    // ok=false counts a failure against the backend. The socket goes back
+    // to the pool when keep is set, otherwise it is closed.
+    void release(Lease& lease, bool ok, bool keep, Clock::time_point now) ;
+
+    [[nodiscard]] size_t size() const noexcept { return backends_.size() ; }
+    [[nodiscard]] size_t outstanding(size_t backend) const ;
+    [[nodiscard]] bool healthy(size_t backend) const ;
+
+private:
+    struct Idle {
+        net::Socket socket ;
+        Clock::time_point since ;
+    } ;
+
+    struct Backend {
+        std::vector<Idle> idle ;
+        size_t outstanding = 0 ;
+        uint32_t failures = 0 ;
+        Clock::time_point retry_at ;   // While down, when the next probe may go
+    } ;
+
+    UpstreamConfig config_ ;
+    mutable std::mutex mutex_ ;
+    std::vector<Backend> backends_ ;
+    size_t next_ = 0 ;   // Rotates the starting point between equally loaded backends
+
+    [[nodiscard]] bool down(const Backend& backend) const noexcept { return backend.failures >= config_.max_failures ; }
+} ;
+
+} // namespace frqs::core
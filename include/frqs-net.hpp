@@ -12,6 +12,7 @@
  */
 
 #include "core/server.hpp"
+#include "core/prefork.hpp"
 
 #ifdef ERROR
 	#undef ERROR
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file http/canned_response.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Immutable pre-serialized responses
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "http/response.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace frqs::http {
+
+// A response serialized once and never touched again, so any thread can
+// send it from its storage: no body string, header list or wire format
+// built per request. It is serialized in all three Connection header
+// variants up front; the source response should not set Connection
+// itself. The server copies it out with the current Date line spliced in.
+//
+// The server answers its own errors (400, 404, 408, ...) from the shared
+// instances below, built on first use; Server::route takes one for fixed
+// replies such as health checks.
+class CannedResponse {
+public:
+    enum class Persistence : uint8_t {
+        DEFAULT,      // No Connection header: HTTP/1.1 keep-alive
+        CLOSE,
+        KEEP_ALIVE    // HTTP/1.0 client that asked for keep-alive
+    } ;
+
+    explicit CannedResponse(const HTTPResponse& response) ;
+
+    // Status line through the body, or through the blank line for HEAD
+    [[nodiscard]] std::string_view wire(Persistence persistence = Persistence::DEFAULT, bool head_only = false) const noexcept ;
+    [[nodiscard]] uint16_t status() const noexcept { return status_ ; }
+
+    [[nodiscard]] static const CannedResponse& badRequest() ;
+    [[nodiscard]] static const CannedResponse& forbidden() ;
+    [[nodiscard]] static const CannedResponse& notFound() ;
+    [[nodiscard]] static const CannedResponse& methodNotAllowed() ;
+    [[nodiscard]] static const CannedResponse& requestTimeout() ;
+    [[nodiscard]] static const CannedResponse& payloadTooLarge() ;
+    [[nodiscard]] static const CannedResponse& headersTooLarge() ;
+    [[nodiscard]] static const CannedResponse& internalError() ;
+    [[nodiscard]] static const CannedResponse& notImplemented() ;
+
+private:
+    std::array<std::string, 3> wire_ ;
+    std::array<size_t, 3> head_size_{} ;
+    uint16_t status_ ;
+} ;
+
+} // namespace frqs::http
@@ -51,4 +51,18 @@ enum class Method : uint8_t {
     }
 }
 
+// Repeating the request has the same effect as sending it once (RFC 9110 9.2.2)
+[[nodiscard]] constexpr bool isIdempotent(Method method) noexcept {
+    switch (method) {
+        case Method::GET:
+        case Method::HEAD:
+        case Method::PUT:
+        case Method::DELETE:
+        case Method::OPTIONS:
+            return true ;
+        default:
+            return false ;
+    }
+}
+
 } // namespace frqs::http
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file http/middleware.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Compile-time and runtime middleware chains
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifdef DELETE
+	#undef DELETE
+#endif
+
+#include "method.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace frqs::http {
+
+// A middleware layer is a callable taking the request and the next stage.
+// It may answer on its own, call next, or change what next returned:
+//
+//   auto frame_deny = [](const HTTPRequest& req, auto&& next) {
+//       auto res = next(req) ;
+//       res.setHeader("X-Frame-Options", "DENY") ;
+//       return res ;
+//   } ;
+//
+// Layers written with `auto&& next` work in both chains below. Layers are
+// called concurrently from every worker, so any state they keep must be
+// thread safe.
+
+namespace detail {
+    // Stands in for "some next stage" when checking a layer
+    struct NextArchetype {
+        HTTPResponse operator()(const HTTPRequest&) const ;
+    } ;
+}
+
+template <typename H>
+concept Endpoint = std::copy_constructible<H>
+    && requires(const H& handler, const HTTPRequest& request) {
+        { handler(request) } -> std::convertible_to<HTTPResponse> ;
+    } ;
+
+template <typename L>
+concept Middleware = std::copy_constructible<L>
+    && requires(const L& layer, const HTTPRequest& request, detail::NextArchetype next) {
+        { layer(request, next) } -> std::convertible_to<HTTPResponse> ;
+    } ;
+
+// Handler and layers fixed at compile time. Each stage hands the next one
+// a lambda of its own type, so the whole chain is visible to the
+// optimizer and usually collapses into the handler: no indirect calls,
+// no allocation. Stored as a RequestHandler it costs the one std::function
+// call any handler does.
+template <Endpoint Handler, Middleware... Layers>
+class Pipeline {
+public:
+    Pipeline(Handler handler, std::tuple<Layers...> layers)
+        : handler_(std::move(handler)), layers_(std::move(layers)) {}
+
+    HTTPResponse operator()(const HTTPRequest& request) const { return stage<0>(request) ; }
+
+private:
+    Handler handler_ ;
+    [[no_unique_address]] std::tuple<Layers...> layers_ ;
+
+    template <size_t I>
+    HTTPResponse stage(const HTTPRequest& request) const {
+        if constexpr (I == sizeof...(Layers)) {
+            return handler_(request) ;
+        } else {
+            return std::get<I>(layers_)(request, [this](const HTTPRequest& next) { return stage<I + 1>(next) ; }) ;
+        }
+    }
+} ;
+
+// middleware(cors, auth).wrap(handler): cors sees the request first and
+// the response last
+template <Middleware... Layers>
+class Stack {
+public:
+    explicit Stack(Layers... layers) : layers_(std::move(layers)...) {}
+
+    template <Endpoint Handler>
+    [[nodiscard]] Pipeline<Handler, Layers...> wrap(Handler handler) const {
+        return Pipeline<Handler, Layers...>(std::move(handler), layers_) ;
+    }
+
+private:
+    [[no_unique_address]] std::tuple<Layers...> layers_ ;
+} ;
+
+template <typename... Layers>
+[[nodiscard]] Stack<std::decay_t<Layers>...> middleware(Layers&&... layers) {
+    return Stack<std::decay_t<Layers>...>(std::forward<Layers>(layers)...) ;
+}
+
+// Layers chosen at runtime (from configuration, plugins). One indirect
+// call per layer; the chain is copied into the wrapped handler, so
+// calling it allocates nothing and later use() calls do not affect it.
+class MiddlewareChain {
+public:
+    using Handler = std::function<HTTPResponse(const HTTPRequest&)> ;
+
+    class Next ;
+    using Layer = std::function<HTTPResponse(const HTTPRequest&, const Next&)> ;
+
+    class Next {
+    public:
+        HTTPResponse operator()(const HTTPRequest& request) const ;
+
+    private:
+        friend class MiddlewareChain ;
+
+        struct Chain {
+            std::vector<Layer> layers ;
+            Handler handler ;
+        } ;
+
+        Next(const Chain* chain, size_t index) noexcept : chain_(chain), index_(index) {}
+
+        const Chain* chain_ ;
+        size_t index_ ;
+    } ;
+
+    MiddlewareChain& use(Layer layer) ;
+
+    [[nodiscard]] Handler wrap(Handler handler) const ;
+
+    [[nodiscard]] size_t size() const noexcept { return layers_.size() ; }
+    [[nodiscard]] bool empty() const noexcept { return layers_.empty() ; }
+
+private:
+    std::vector<Layer> layers_ ;
+} ;
+
+inline HTTPResponse MiddlewareChain::Next::operator()(const HTTPRequest& request) const {
+    if (index_ == chain_->layers.size()) {
+        return chain_->handler(request) ;
+    }
+    return chain_->layers[index_](request, Next(chain_, index_ + 1)) ;
+}
+
+// Answers CORS preflights and marks other responses as shareable with origin
+struct Cors {
+    std::string origin = "*" ;
+    std::string methods = "GET, HEAD, POST, PUT, DELETE, OPTIONS" ;
+    std::string headers = "Content-Type, Authorization" ;
+    std::string max_age = "600" ;   // Seconds a preflight may be cached
+
+    template <typename Next>
+    HTTPResponse operator()(const HTTPRequest& request, Next&& next) const {
+        if (request.getMethod() == Method::OPTIONS && request.getHeader("Access-Control-Request-Method")) {
+            HTTPResponse preflight ;
+            preflight.setStatus(204) ;
+            decorate(preflight) ;
+            preflight.setHeader("Access-Control-Allow-Methods", methods) ;
+            preflight.setHeader("Access-Control-Allow-Headers", headers) ;
+            preflight.setHeader("Access-Control-Max-Age", max_age) ;
+            return preflight ;
+        }
+
+        HTTPResponse response = next(request) ;
+        decorate(response) ;
+        return response ;
+    }
+
+    void decorate(HTTPResponse& response) const ;
+} ;
+
+// Requires "Authorization: Bearer <token>"; anything else gets a 401
+struct BearerAuth {
+    std::string token ;
+
+    template <typename Next>
+    HTTPResponse operator()(const HTTPRequest& request, Next&& next) const {
+        if (authorized(request)) {
+            return next(request) ;
+        }
+        return HTTPResponse()
+            .setStatus(401)
+            .setHeader("WWW-Authenticate", "Bearer")
+            .setBody("<h1>401 - Unauthorized</h1>")
+            .setContentType("text/html") ;
+    }
+
+    [[nodiscard]] bool authorized(const HTTPRequest& request) const noexcept ;
+} ;
+
+} // namespace frqs::http
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file http/proxy.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Message rewriting and framing for the reverse proxy
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace frqs::http {
+
+// True for headers that describe one connection and must not be
+// forwarded (RFC 9110 section 7.6.1). Expect is included because the
+// proxy has the whole request body before it connects upstream.
+[[nodiscard]] bool isHopByHop(std::string_view name) noexcept ;
+
+// Rewrites a client request head (request line through the blank line)
+// for an upstream: HTTP/1.1, hop-by-hop headers and those named in
+// Connection removed, client_ip appended to X-Forwarded-For. The client's
+// Content-Length lines are replaced by one carrying body_size, the length
+// this server framed the request with, so the upstream cannot read the
+// body differently. The result ends with the blank line, ready for the body.
+[[nodiscard]] std::string forwardRequestHead(std::string_view raw_head, uint64_t body_size, std::string_view client_ip) ;
+
+// Status line and headers of an upstream response, with what the proxy
+// needs to relay the body
+struct UpstreamResponse {
+    enum class Body : uint8_t {
+        NONE,      // 1xx, 204, 304 or a HEAD request
+        LENGTH,
+        CHUNKED,
+        UNTIL_CLOSE
+    } ;
+
+    uint16_t status = 0 ;
+    size_t head_size = 0 ;          // Bytes up to and including the blank line
+    Body body = Body::NONE ;
+    uint64_t content_length = 0 ;
+    bool reusable = false ;         // Upstream keeps the connection open
+    std::string head ;              // Status line and end-to-end headers, no blank line
+    std::string transfer_encoding ; // Upstream's codings, relayed as sent unless decoded
+
+    // nullopt until the blank line has arrived; throws std::runtime_error
+    // on a malformed head
+    [[nodiscard]] static std::optional<UpstreamResponse> parse(std::string_view data, bool head_request) ;
+} ;
+
+// Finds the end of a chunked body as it streams past and extracts the
+// payload for clients that cannot take chunked encoding. Chunk
+// extensions and trailers are skipped.
+class ChunkedDecoder {
+public:
+    struct Step {
+        size_t consumed = 0 ;         // Input bytes used by this step
+        std::string_view payload ;    // Body bytes within them, possibly empty
+    } ;
+
+    // Advances through input; call again with the rest until it is used
+    // up or done(). Throws std::runtime_error on malformed framing.
+    [[nodiscard]] Step next(std::string_view input) ;
+
+    [[nodiscard]] bool done() const noexcept { return state_ == State::DONE ; }
+
+private:
+    enum class State : uint8_t {
+        SIZE,          // Hex digits
+        EXTENSION,     // Up to the end of the size line
+        DATA,
+        DATA_END,      // CRLF after the data
+        TRAILER,       // Start of a trailer line, or the final blank line
+        TRAILER_LINE,
+        DONE
+    } ;
+
+    State state_ = State::SIZE ;
+    uint64_t remaining_ = 0 ;
+    size_t digits_ = 0 ;
+} ;
+
+} // namespace frqs::http
@@ -12,6 +12,9 @@
  */
 
 #include "method.hpp"
+#include <array>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -22,9 +25,26 @@ namespace frqs::http {
 class HTTPRequest {
 public:
     static constexpr size_t MAX_REQUEST_SIZE = 1024 * 1024 ; // 1MB limit
+    static constexpr size_t MAX_PARAMS = 8 ;
+    
+    // Path parameter captured by the router; the value is still percent-encoded
+    struct Param {
+        std::string_view name ;
+        std::string_view value ;
+    } ;
+    
+    using allocator_type = std::pmr::polymorphic_allocator<> ;
     
     HTTPRequest() = default ;
     
+    // Everything the request allocates comes from allocator's resource
+    // (the connection's per-request arena in the server)
+    explicit HTTPRequest(allocator_type allocator) ;
+    
+    // For handlers building their response and scratch data in the same
+    // arena: HTTPResponse(request.get_allocator())
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return raw_request_.get_allocator() ; }
+    
     // Parse raw HTTP request (Zero-Copy where possible)
     [[nodiscard]] bool parse(std::string_view raw_data) noexcept ;
     
@@ -42,13 +62,18 @@ public:
     
     [[nodiscard]] std::string_view getBody() const noexcept { return body_ ; }
     
+    // Path parameters of the matched route (":id", "*path")
+    [[nodiscard]] std::optional<std::string_view> getParam(std::string_view name) const noexcept ;
+    [[nodiscard]] std::span<const Param> getParams() const noexcept { return {params_.data(), param_count_} ; }
+    void setParams(std::span<const Param> params) noexcept ;
+    
     // Validation
     [[nodiscard]] bool isValid() const noexcept { return is_valid_ ; }
     [[nodiscard]] std::string_view getError() const noexcept { return error_message_ ; }
 
 private:
     // Backing storage for the raw request (owns the data)
-    std::string raw_request_ ;
+    std::pmr::string raw_request_ ;
     
     // Zero-copy views into raw_request_
     Method method_ = Method::UNKNOWN ;
@@ -58,8 +83,12 @@ private:
     std::string_view body_ ;
     
     // Headers and query params (keys/values are views into raw_request_)
-    std::unordered_map<std::string_view, std::string_view> headers_ ;
-    std::unordered_map<std::string_view, std::string_view> query_params_ ;
+    std::pmr::unordered_map<std::string_view, std::string_view> headers_ ;
+    std::pmr::unordered_map<std::string_view, std::string_view> query_params_ ;
+    
+    // Names point into the router, values into raw_request_
+    std::array<Param, MAX_PARAMS> params_{} ;
+    size_t param_count_ = 0 ;
     
     bool is_valid_ = false ;
     std::string_view error_message_ ;
@@ -79,4 +108,14 @@ private:
     } ;
 } ;
 
+// ASCII case-insensitive comparison, as for header names and tokens
+[[nodiscard]] bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept ;
+
+// Strips optional whitespace (spaces and tabs) from both ends
+[[nodiscard]] std::string_view trim(std::string_view text) noexcept ;
+
+// Case-insensitive match of token in a comma-separated header value,
+// e.g. containsToken("keep-alive, Upgrade", "upgrade")
+[[nodiscard]] bool containsToken(std::string_view list, std::string_view token) noexcept ;
+
 } // namespace frqs::http
\ No newline at end of file
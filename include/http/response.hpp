@@ -11,44 +11,112 @@
  * 
  */
 
+#include <concepts>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <cstdint>
 
 namespace frqs::http {
 
 class HTTPResponse {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<> ;
+    
     HTTPResponse() = default ;
     
+    // Status message, headers and body live in allocator's resource. A
+    // handler passes request.get_allocator() to build its response in the
+    // per-request arena.
+    explicit HTTPResponse(allocator_type allocator) ;
+    
+    // Copies stay in the source's resource, so returning a fluent chain
+    // (a copy of the temporary) does not leave the arena
+    HTTPResponse(const HTTPResponse& other) ;
+    HTTPResponse(HTTPResponse&&) noexcept = default ;
+    HTTPResponse& operator=(const HTTPResponse&) = default ;
+    HTTPResponse& operator=(HTTPResponse&&) = default ;
+    
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return body_.get_allocator() ; }
+    
     // Fluent API for building responses
     HTTPResponse& setStatus(uint16_t code, std::string_view message = "") ;
     HTTPResponse& setHeader(std::string_view name, std::string_view value) ;
-    HTTPResponse& setBody(std::string body) ;
+    HTTPResponse& setBody(std::string_view body) ;
     HTTPResponse& setContentType(std::string_view type) ;
     
     // Common status codes
-    HTTPResponse& ok(std::string body = "") ;
-    HTTPResponse& notFound(std::string body = "") ;
-    HTTPResponse& badRequest(std::string body = "") ;
-    HTTPResponse& internalError(std::string body = "") ;
-    HTTPResponse& forbidden(std::string body = "") ;
+    HTTPResponse& ok(std::string_view body = "") ;
+    HTTPResponse& notFound(std::string_view body = "") ;
+    
+    // A std::pmr::string body is moved in, without a copy when it uses this
+    // response's allocator (the default one, or request.get_allocator())
+    template <std::same_as<std::pmr::string> Body>
+    HTTPResponse& setBody(Body&& body) {
+        body_ = std::move(body) ;
+        return *this ;
+    }
+    
+    template <std::same_as<std::pmr::string> Body>
+    HTTPResponse& ok(Body&& body) {
+        return ok().setBody(std::move(body)) ;
+    }
+    
+    template <std::same_as<std::pmr::string> Body>
+    HTTPResponse& notFound(Body&& body) {
+        return notFound().setBody(std::move(body)) ;
+    }
+    
+    // A std::string cannot hand its buffer to a std::pmr::string, so moving
+    // one in copies it; these overloads keep that from going unnoticed
+    template <std::same_as<std::string> Body>
+    [[deprecated("copies the body; build it as std::pmr::string to move it")]]
+    HTTPResponse& setBody(Body&& body) {
+        return setBody(std::string_view(body)) ;
+    }
+    
+    template <std::same_as<std::string> Body>
+    [[deprecated("copies the body; build it as std::pmr::string to move it")]]
+    HTTPResponse& ok(Body&& body) {
+        return ok(std::string_view(body)) ;
+    }
+    
+    template <std::same_as<std::string> Body>
+    [[deprecated("copies the body; build it as std::pmr::string to move it")]]
+    HTTPResponse& notFound(Body&& body) {
+        return notFound(std::string_view(body)) ;
+    }
+    HTTPResponse& badRequest(std::string_view body = "") ;
+    HTTPResponse& internalError(std::string_view body = "") ;
+    HTTPResponse& forbidden(std::string_view body = "") ;
     
     // Build the complete HTTP response
     [[nodiscard]] std::string build() const ;
     
-    // Direct access
+    // Appends the wire form to out; a reused buffer makes this allocation-free.
+    // headers, complete "Name: value\r\n" lines, go right after the status line.
+    void buildInto(std::string& out, std::string_view headers = {}) const ;
+    
+    // Direct access; the mutable body lets callers fill it in place
     [[nodiscard]] uint16_t getStatus() const noexcept { return status_code_ ; }
-    [[nodiscard]] const std::string& getBody() const noexcept { return body_ ; }
+    [[nodiscard]] const std::pmr::string& getBody() const noexcept { return body_ ; }
+    [[nodiscard]] std::pmr::string& getBody() noexcept { return body_ ; }
+    [[nodiscard]] std::optional<std::string_view> getHeader(std::string_view name) const noexcept ;
 
 private:
+    using Header = std::pair<std::pmr::string, std::pmr::string> ;
+    
     uint16_t status_code_ = 200 ;
-    std::string status_message_ = "OK" ;
-    std::string body_ ;
-    std::unordered_map<std::string, std::string> headers_ ;
+    std::pmr::string status_message_{"OK"} ;
+    std::pmr::string body_ ;
+    std::pmr::vector<Header> headers_ ;   // In the order they were first set
     
+    [[nodiscard]] Header* findHeader(std::string_view name) noexcept ;
+    [[nodiscard]] const Header* findHeader(std::string_view name) const noexcept ;
     [[nodiscard]] static std::string_view getDefaultStatusMessage(uint16_t code) noexcept ;
 } ;
 
-} // namespace frqs::http
\ No newline at end of file
+} // namespace frqs::http
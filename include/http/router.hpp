@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file http/router.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Radix tree request router with path parameters
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifdef DELETE
+	#undef DELETE
+#endif
+
+#include "method.hpp"
+#include "request.hpp"
+#include "response.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace frqs::http {
+
+// Routes are "METHOD pattern" pairs. A pattern is split into segments by
+// '/'; a segment is literal, ":name" (one non-empty segment) or, as the
+// last segment, "*name" (the rest of the path, possibly empty):
+//
+//   /users/:id/posts        /static/*path        /health
+//
+// Literal text is stored in a radix tree with shared prefixes merged into
+// single edges. Matching walks the path once, preferring literal edges,
+// then a parameter, then a wildcard, and only backs up when a preferred
+// branch dead-ends. Captures are string_views into the path; nothing is
+// allocated.
+class Router {
+public:
+    using Handler = std::function<HTTPResponse(const HTTPRequest&)> ;
+
+    struct Match {
+        const Handler* handler = nullptr ;   // Null when nothing matched
+        size_t route = 0 ;                   // Registration index
+        bool path_found = false ;            // Path matched but not the method (405)
+        uint8_t allowed = 0 ;                // Bit per Method registered on the path
+        std::array<HTTPRequest::Param, HTTPRequest::MAX_PARAMS> params{} ;
+        size_t param_count = 0 ;
+
+        [[nodiscard]] std::span<const HTTPRequest::Param> getParams() const noexcept {
+            return {params.data(), param_count} ;
+        }
+    } ;
+
+    Router() ;
+
+    // Throws std::runtime_error on malformed patterns, duplicate routes or
+    // two parameter names at the same position. Returns the route index.
+    size_t add(Method method, std::string_view pattern, Handler handler) ;
+
+    // One route shared by several methods, named "GET,POST /pattern" ("ANY
+    // /pattern" for all of them). Nothing is registered if any method is taken.
+    size_t add(std::span<const Method> methods, std::string_view pattern, Handler handler) ;
+
+    // HEAD falls back to GET
+    [[nodiscard]] Match match(Method method, std::string_view path) const noexcept ;
+
+    [[nodiscard]] bool empty() const noexcept { return routes_.empty() ; }
+    [[nodiscard]] size_t size() const noexcept { return routes_.size() ; }
+
+    // "GET /users/:id"
+    [[nodiscard]] const std::string& name(size_t route) const noexcept { return routes_[route].name ; }
+
+    // "GET, HEAD" for an Allow header
+    [[nodiscard]] static std::string allowHeader(uint8_t allowed) ;
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX ;
+    static constexpr size_t METHOD_COUNT = static_cast<size_t>(Method::UNKNOWN) ;
+    static constexpr uint8_t ALL_METHODS = static_cast<uint8_t>((1u << METHOD_COUNT) - 1) ;
+
+    struct Node {
+        std::string prefix ;                // Literal bytes consumed by this node
+        std::string indices ;               // First byte of each literal child
+        std::vector<uint32_t> children ;    // Parallel to indices
+        uint32_t param = NONE ;             // ":name" child
+        uint32_t wildcard = NONE ;          // "*name" child
+        std::string name ;                  // Parameter name on param/wildcard nodes
+        std::array<uint32_t, METHOD_COUNT> routes ;
+        uint8_t allowed = 0 ;
+
+        Node() { routes.fill(NONE) ; }
+    } ;
+
+    struct Route {
+        std::string name ;
+        Handler handler ;
+    } ;
+
+    std::vector<Node> nodes_ ;    // nodes_[0] is the root
+    std::vector<Route> routes_ ;
+
+    [[nodiscard]] uint32_t literalChild(uint32_t node, std::string_view literal) ;
+    [[nodiscard]] uint32_t paramChild(uint32_t node, std::string_view name, bool wildcard) ;
+
+    [[nodiscard]] uint32_t find(uint32_t node, std::string_view path, Match& match) const noexcept ;
+} ;
+
+} // namespace frqs::http
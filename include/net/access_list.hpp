@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file net/access_list.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Compiled IPv4 CIDR allow/deny list
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "ipv4.hpp"
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace frqs::net {
+
+// Immutable longest-prefix-match table over IPv4 CIDR rules. Rules are
+// compiled into three levels indexed by 16, 8 and 8 address bits, so a
+// lookup is at most three dependent loads and never walks a trie:
+//
+//   top:    65,536 entries, a verdict or the index of a middle node
+//   middle: 256 two-bit verdicts plus a 256-bit bitmap of children; the
+//           child index is a popcount over the bitmap
+//   bottom: 256 two-bit verdicts, one cache line
+//
+// Only /16 ranges holding a longer prefix get a middle node and only /24
+// ranges holding a longer prefix get a bottom node, so hundreds of
+// thousands of feed entries stay in a few megabytes. The most specific
+// prefix wins; for the same prefix, deny beats allow.
+class AccessList {
+public:
+    enum class Verdict : uint8_t {
+        NONE,     // No rule covers the address
+        ALLOW,
+        DENY
+    } ;
+
+    struct Rule {
+        IPv4 network ;
+        uint8_t prefix = 32 ;
+        Verdict verdict = Verdict::DENY ;
+    } ;
+
+    // default_allow decides addresses no rule covers
+    explicit AccessList(std::span<const Rule> rules, bool default_allow = true) ;
+
+    // "a.b.c.d" or "a.b.c.d/len"; host bits are cleared
+    [[nodiscard]] static std::optional<Rule> parseCidr(std::string_view text) noexcept ;
+
+    // One rule per line: "allow <cidr>", "deny <cidr>" or a bare <cidr>
+    // (deny, the threat feed format). '#' and ';' start comments.
+    // Throws std::runtime_error naming the first bad line.
+    [[nodiscard]] static std::vector<Rule> parse(std::string_view text) ;
+
+    [[nodiscard]] static std::shared_ptr<const AccessList> load(const std::filesystem::path& path,
+                                                                bool default_allow = true) ;
+
+    [[nodiscard]] Verdict match(uint32_t address) const noexcept ;
+
+    [[nodiscard]] bool permits(uint32_t address) const noexcept {
+        Verdict verdict = match(address) ;
+        return verdict == Verdict::NONE ? default_allow_ : verdict == Verdict::ALLOW ;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return rule_count_ ; }
+    [[nodiscard]] size_t memoryUsage() const noexcept ;
+
+private:
+    static constexpr uint32_t CHILD = 0x8000'0000u ;
+
+    // 256 two-bit verdicts
+    struct alignas(64) Leaves {
+        uint64_t bits[8] = {} ;
+
+        [[nodiscard]] Verdict get(uint32_t index) const noexcept {
+            return static_cast<Verdict>((bits[index >> 5] >> ((index & 31) * 2)) & 3) ;
+        }
+    } ;
+
+    struct alignas(64) Middle {
+        uint64_t children[4] = {} ;   // Which of the 256 entries have a bottom node
+        uint32_t base[4] = {} ;       // Bottom index of the first child in each word
+        Leaves leaves ;
+    } ;
+
+    std::vector<uint32_t> top_ ;      // Verdict, or CHILD | middle index
+    std::vector<Middle> middle_ ;
+    std::vector<Leaves> bottom_ ;
+    size_t rule_count_ = 0 ;
+    bool default_allow_ = true ;
+} ;
+
+inline AccessList::Verdict AccessList::match(uint32_t address) const noexcept {
+    uint32_t top = top_[address >> 16] ;
+    if ((top & CHILD) == 0) {
+        return static_cast<Verdict>(top) ;
+    }
+
+    const Middle& middle = middle_[top & ~CHILD] ;
+    uint32_t index = (address >> 8) & 0xFF ;
+    uint64_t word = middle.children[index >> 6] ;
+    uint64_t bit = uint64_t{1} << (index & 63) ;
+    if ((word & bit) == 0) {
+        return middle.leaves.get(index) ;
+    }
+
+    uint32_t child = middle.base[index >> 6] + static_cast<uint32_t>(std::popcount(word & (bit - 1))) ;
+    return bottom_[child].get(address & 0xFF) ;
+}
+
+} // namespace frqs::net
@@ -16,6 +16,7 @@
 #include <compare>
 #include <concepts>
 #include <cstdint>
+#include <format>
 #include <string>
 #include <string_view>
 #include <bit>
@@ -95,4 +96,11 @@ IPv4::IPv4(const E (&address)[N]) noexcept {
         address_[i] = static_cast<uint8_t>(std::clamp(address[i], E{0}, E{255})) ;
 }
 
-} // namespace frqs::net
\ No newline at end of file
+} // namespace frqs::net
+
+template <>
+struct std::formatter<frqs::net::IPv4> : std::formatter<std::string_view> {
+    auto format(const frqs::net::IPv4& ip, std::format_context& ctx) const {
+        return std::formatter<std::string_view>::format(ip.toString(), ctx) ;
+    }
+} ;
\ No newline at end of file
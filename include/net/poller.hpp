@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file net/poller.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "socket.hpp"
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+    #include <poll.h>
+#endif
+
+namespace frqs::net {
+
+// Readiness notification over epoll (Linux) or poll() elsewhere,
+// level-triggered. Each registered handle carries an opaque pointer that
+// is handed back with its events. wake() may be called from any thread
+// (and from signal handlers) to interrupt a blocked wait().
+class Poller {
+public:
+    using handle_t = Socket::native_handle_t ;
+
+    static constexpr uint32_t READABLE = 1u << 0 ;
+    static constexpr uint32_t WRITABLE = 1u << 1 ;
+    static constexpr uint32_t CLOSED   = 1u << 2 ;   // Hangup or socket error, always reported
+
+    struct Event {
+        void* data ;
+        uint32_t events ;
+    } ;
+
+    Poller() ;
+    ~Poller() ;
+
+    Poller(const Poller&) = delete ;
+    Poller& operator=(const Poller&) = delete ;
+    Poller(Poller&&) = delete ;
+    Poller& operator=(Poller&&) = delete ;
+
+    void add(handle_t handle, uint32_t interest, void* data) ;
+    void modify(handle_t handle, uint32_t interest, void* data) ;
+    void remove(handle_t handle) noexcept ;
+
+    // Blocks up to timeout_ms (-1 = forever); returns the events filled
+    size_t wait(std::span<Event> events, int timeout_ms) ;
+
+    void wake() noexcept ;
+
+private:
+#if defined(__linux__)
+    int epoll_fd_ = -1 ;
+    int wake_fd_ = -1 ;                  // eventfd
+#else
+    #ifdef _WIN32
+    using pollfd_t = WSAPOLLFD ;
+    #else
+    using pollfd_t = pollfd ;
+    int wake_pipe_[2] = {-1, -1} ;
+    #endif
+    std::vector<pollfd_t> fds_ ;
+    std::vector<void*> data_ ;
+    std::unordered_map<handle_t, size_t> index_ ;
+#endif
+    std::atomic<bool> wake_pending_{false} ;
+
+    void drainWake() noexcept ;
+} ;
+
+} // namespace frqs::net
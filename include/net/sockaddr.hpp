@@ -53,4 +53,11 @@ private:
     void append_uint16(std::string& dst, uint16_t port) const noexcept ;
 } ;
 
-} // namespace frqs::net
\ No newline at end of file
+} // namespace frqs::net
+
+template <>
+struct std::formatter<frqs::net::SockAddr> : std::formatter<std::string_view> {
+    auto format(const frqs::net::SockAddr& addr, std::format_context& ctx) const {
+        return std::formatter<std::string_view>::format(addr.toString(), ctx) ;
+    }
+} ;
\ No newline at end of file
@@ -12,6 +12,12 @@
  */
 
 #include "sockaddr.hpp"
+#include "socket_option.hpp"
+#include <expected>
+#include <new>
+#include <optional>
+#include <span>
+#include <system_error>
 #include <utility>
 #include <vector>
 #include <string_view>
@@ -22,11 +28,21 @@
     #pragma comment(lib, "ws2_32.lib")
 #else
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <unistd.h>
 #endif
 
 namespace frqs::net {
 
+// Outcome of the non-throwing socket calls: the value, or the OS error
+template <typename T>
+using Expected = std::expected<T, std::error_code> ;
+
+// The error only means "try again when the poller says so"
+[[nodiscard]] inline bool wouldBlock(const std::error_code& error) noexcept {
+    return error == std::errc::operation_would_block || error == std::errc::resource_unavailable_try_again ;
+}
+
 class Socket {
 public:
 #ifdef _WIN32
@@ -58,14 +74,68 @@ public:
     size_t receive(void* buffer, size_t size) ;
     [[nodiscard]] std::vector<char> receive(size_t max_size = 4096) ;
     
+    // Non-blocking I/O. The try* calls return nullopt when the operation
+    // would block (or was interrupted) and throw on real errors.
+    void setNonBlocking(bool enabled = true) ;
+    [[nodiscard]] bool startConnect(const SockAddr& addr) ;   // false while in progress
+    void finishConnect() ;                                     // throws if the connect failed
+    [[nodiscard]] std::optional<size_t> trySend(const void* data, size_t size) ;
+    [[nodiscard]] std::optional<size_t> trySend(std::string_view data) ;
+    [[nodiscard]] std::optional<size_t> tryReceive(void* buffer, size_t size) ;
+    [[nodiscard]] std::optional<Socket> tryAccept(SockAddr* out_client_addr = nullptr) ;   // nullopt when none pending
+    
+    // Non-throwing forms for the event loop, where would-block, EINTR and
+    // resets are routine: every failure comes back as the OS error code
+    // (would-block too, see wouldBlock()), EINTR is retried, and nothing
+    // unwinds. Accepted sockets are already non-blocking and close-on-exec
+    // (accept4 where available).
+    [[nodiscard]] Expected<Socket> accept(std::nothrow_t, SockAddr* out_client_addr = nullptr) noexcept ;
+    // more: another write follows at once, so hold back a partial segment
+    // (MSG_MORE where available)
+    [[nodiscard]] Expected<size_t> send(std::nothrow_t, const void* data, size_t size, bool more = false) noexcept ;
+    [[nodiscard]] Expected<size_t> send(std::nothrow_t, std::string_view data, bool more = false) noexcept ;
+    // Gathers up to MAX_PARTS buffers into one call (sendmsg, WSASend on
+    // Windows), so pieces living apart leave as one write
+    static constexpr size_t MAX_PARTS = 8 ;
+    [[nodiscard]] Expected<size_t> send(std::nothrow_t, std::span<const std::string_view> parts) noexcept ;
+    [[nodiscard]] Expected<size_t> receive(std::nothrow_t, void* buffer, size_t size) noexcept ;
+    [[nodiscard]] Expected<bool> connect(std::nothrow_t, const SockAddr& addr) noexcept ;   // false while in progress
+    [[nodiscard]] Expected<void> finishConnect(std::nothrow_t) noexcept ;
+    [[nodiscard]] Expected<void> setNonBlocking(std::nothrow_t, bool enabled = true) noexcept ;
+    
+    // Typed options from socket_option.hpp, e.g. set(option::NoDelay(true))
+    template <typename Option>
+    void set(const Option& option) {
+        setOption(Option::level, Option::name, option.native()) ;
+    }
+    
+    template <typename Option>
+    [[nodiscard]] Expected<void> set(std::nothrow_t, const Option& option) noexcept {
+        return setOption(std::nothrow, Option::level, Option::name, option.native()) ;
+    }
+    
+    template <typename Option>
+    [[nodiscard]] Expected<typename Option::value_type> get(std::nothrow_t) const noexcept {
+        return getOption(std::nothrow, Option::level, Option::name).transform(Option::fromNative) ;
+    }
+    
     void close() ;
-    void shutdown(int how = 2) ;
+    // how: SHUTDOWN_READ, SHUTDOWN_WRITE or SHUTDOWN_BOTH (SHUT_* / SD_*)
+    static constexpr int SHUTDOWN_READ = 0 ;
+    static constexpr int SHUTDOWN_WRITE = 1 ;
+    static constexpr int SHUTDOWN_BOTH = 2 ;
+    void shutdown(int how = SHUTDOWN_BOTH) ;
     
     [[nodiscard]] bool invalid() const noexcept { return handle_ == invalid_handle ; }
     [[nodiscard]] native_handle_t native_handle() const noexcept { return handle_ ; }
 
 private:
     explicit Socket(native_handle_t h) ;
+    
+    void setOption(int level, int name, int value) ;
+    [[nodiscard]] Expected<void> setOption(std::nothrow_t, int level, int name, int value) noexcept ;
+    [[nodiscard]] Expected<int> getOption(std::nothrow_t, int level, int name) const noexcept ;
+    
     native_handle_t handle_ = invalid_handle ;
 } ;
 
@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * @file net/socket_option.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Typed socket options
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+#endif
+
+namespace frqs::net {
+
+// A socket option with its level, name and value type fixed at compile
+// time, so Socket::set and Socket::get cannot pair a name with the wrong
+// level or value. NAME is -1 where the platform has no such option;
+// setting one then fails with errc::not_supported.
+template <int LEVEL, int NAME, typename T>
+class SocketOption {
+public:
+    using value_type = T ;
+    static constexpr int level = LEVEL ;
+    static constexpr int name = NAME ;
+    static constexpr bool supported = NAME >= 0 ;
+
+    constexpr SocketOption() noexcept = default ;
+    constexpr explicit SocketOption(T value) noexcept : value_(value) {}
+
+    [[nodiscard]] constexpr T value() const noexcept { return value_ ; }
+    [[nodiscard]] constexpr int native() const noexcept { return static_cast<int>(value_) ; }
+    [[nodiscard]] static constexpr T fromNative(int value) noexcept { return static_cast<T>(value) ; }
+
+private:
+    T value_{} ;
+} ;
+
+namespace detail {
+#ifdef SO_REUSEPORT
+    inline constexpr int SO_REUSEPORT_NAME = SO_REUSEPORT ;
+#else
+    inline constexpr int SO_REUSEPORT_NAME = -1 ;
+#endif
+#ifdef SO_BUSY_POLL
+    inline constexpr int SO_BUSY_POLL_NAME = SO_BUSY_POLL ;
+#else
+    inline constexpr int SO_BUSY_POLL_NAME = -1 ;
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+    inline constexpr int SO_PREFER_BUSY_POLL_NAME = SO_PREFER_BUSY_POLL ;
+#else
+    inline constexpr int SO_PREFER_BUSY_POLL_NAME = -1 ;
+#endif
+#ifdef TCP_CORK
+    inline constexpr int TCP_CORK_NAME = TCP_CORK ;
+#else
+    inline constexpr int TCP_CORK_NAME = -1 ;
+#endif
+#ifdef TCP_DEFER_ACCEPT
+    inline constexpr int TCP_DEFER_ACCEPT_NAME = TCP_DEFER_ACCEPT ;
+#else
+    inline constexpr int TCP_DEFER_ACCEPT_NAME = -1 ;
+#endif
+#ifdef TCP_FASTOPEN
+    inline constexpr int TCP_FASTOPEN_NAME = TCP_FASTOPEN ;
+#else
+    inline constexpr int TCP_FASTOPEN_NAME = -1 ;
+#endif
+} // namespace detail
+
+namespace option {
+    using ReuseAddress   = SocketOption<SOL_SOCKET, SO_REUSEADDR, bool> ;
+    using ReusePort      = SocketOption<SOL_SOCKET, detail::SO_REUSEPORT_NAME, bool> ;
+    using SendBuffer     = SocketOption<SOL_SOCKET, SO_SNDBUF, int> ;                        // Bytes
+    using ReceiveBuffer  = SocketOption<SOL_SOCKET, SO_RCVBUF, int> ;                        // Bytes
+    using BusyPoll       = SocketOption<SOL_SOCKET, detail::SO_BUSY_POLL_NAME, int> ;        // Microseconds
+    using PreferBusyPoll = SocketOption<SOL_SOCKET, detail::SO_PREFER_BUSY_POLL_NAME, bool> ;
+    using NoDelay        = SocketOption<IPPROTO_TCP, TCP_NODELAY, bool> ;
+    using Cork           = SocketOption<IPPROTO_TCP, detail::TCP_CORK_NAME, bool> ;
+    using DeferAccept    = SocketOption<IPPROTO_TCP, detail::TCP_DEFER_ACCEPT_NAME, int> ;   // Seconds
+    using FastOpen       = SocketOption<IPPROTO_TCP, detail::TCP_FASTOPEN_NAME, int> ;       // Pending queue length
+} // namespace option
+
+} // namespace frqs::net
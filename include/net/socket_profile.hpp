@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file net/socket_profile.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Named socket tuning profiles
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "socket.hpp"
+
+namespace frqs::net {
+
+// Socket options for a listening socket, as named presets. Accepted
+// sockets inherit them from the listener (Linux, the BSDs and Windows all
+// copy these at accept), so a profile costs nothing per connection. Zero
+// leaves an option at the kernel default.
+struct SocketProfile {
+    bool reuse_address = true ;   // Restart while old connections sit in TIME_WAIT
+    bool reuse_port = false ;     // Several listeners on one port, the kernel spreading connections among them
+    bool no_delay = true ;        // Responses go out in one write; Nagle only delays the tail
+    int defer_accept = 0 ;        // Seconds accept waits for the first request byte
+    int fast_open = 0 ;           // TCP Fast Open queue length; also needs the net.ipv4.tcp_fastopen sysctl
+    int send_buffer = 0 ;         // Bytes; setting it turns off kernel autotuning
+    int receive_buffer = 0 ;      // Bytes; likewise
+    int busy_poll = 0 ;           // Microseconds of busy polling on blocking reads; needs CAP_NET_ADMIN
+    bool prefer_busy_poll = false ;   // Keep device interrupts off while the application polls; likewise
+    bool cork = false ;           // Cork responses that do not go out in one send, uncork when done
+
+    // Small request/response traffic: no Nagle, accept only once data is there
+    [[nodiscard]] static SocketProfile latency() ;
+
+    // Large bodies: as latency(), plus a fixed 1 MB send buffer
+    [[nodiscard]] static SocketProfile throughput() ;
+
+    // Before bind. Throws naming the option that failed; options the
+    // platform lacks are skipped.
+    void applyListener(Socket& listener) const ;
+} ;
+
+} // namespace frqs::net
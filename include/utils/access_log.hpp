@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file utils/access_log.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace frqs::utils {
+
+// Fixed-size binary access log entry. Layout is part of the file format,
+// bump ACCESS_LOG_VERSION when it changes.
+struct AccessRecord {
+    static constexpr size_t PATH_CAPACITY = 88 ;
+    static constexpr uint8_t PATH_TRUNCATED = 0x01 ;
+
+    uint64_t timestamp_ns = 0 ;   // Wall clock (unix epoch) when the request was read
+    uint64_t bytes_out = 0 ;
+    uint32_t bytes_in = 0 ;
+    uint32_t client_ip = 0 ;      // Host byte order, see net::IPv4::toUint32()
+    uint32_t total_us = 0 ;       // Accept to last byte sent
+    uint32_t handler_us = 0 ;     // Time spent producing the response
+    uint16_t client_port = 0 ;
+    uint16_t status = 0 ;
+    uint8_t method = 0 ;          // http::Method
+    uint8_t path_len = 0 ;
+    uint8_t flags = 0 ;
+    uint8_t reserved = 0 ;
+    char path[PATH_CAPACITY] = {} ;
+
+    void setPath(std::string_view p) noexcept ;
+    [[nodiscard]] std::string_view getPath() const noexcept { return {path, path_len} ; }
+} ;
+
+static_assert(sizeof(AccessRecord) == 128, "AccessRecord must stay 128 bytes") ;
+
+// Header at the start of every segment file
+struct AccessLogHeader {
+    static constexpr char MAGIC[4] = {'Z', 'H', 'A', 'L'} ;
+
+    char magic[4] = {MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3]} ;
+    uint16_t version = 0 ;
+    uint16_t record_size = sizeof(AccessRecord) ;
+    uint32_t reserved = 0 ;
+    uint64_t record_count = 0 ;   // Valid records following the header
+    uint64_t created_ns = 0 ;
+    uint8_t padding[32] = {} ;
+} ;
+
+static_assert(sizeof(AccessLogHeader) == 64, "AccessLogHeader must stay 64 bytes") ;
+
+inline constexpr uint16_t ACCESS_LOG_VERSION = 1 ;
+
+struct AccessLogConfig {
+    std::filesystem::path directory = "logs" ;
+    std::string prefix = "access" ;
+    size_t max_file_size = 64 * 1024 * 1024 ;   // Rotate once a segment reaches this size
+    size_t buffer_records = 4096 ;              // Per-producer ring capacity (rounded to power of 2)
+    std::chrono::milliseconds flush_interval{50} ;
+} ;
+
+// Binary access log. Each producer (pool worker) owns a single-producer
+// ring; a background flusher drains the rings into memory-mapped segment
+// files. Recording never locks or blocks: a full ring drops the record and
+// counts it instead.
+class AccessLog {
+public:
+    AccessLog(AccessLogConfig config, size_t producer_count) ;
+    ~AccessLog() ;
+
+    AccessLog(const AccessLog&) = delete ;
+    AccessLog& operator=(const AccessLog&) = delete ;
+    AccessLog(AccessLog&&) = delete ;
+    AccessLog& operator=(AccessLog&&) = delete ;
+
+    // Producers outside [0, producer_count) share a mutex-guarded ring
+    void record(size_t producer, const AccessRecord& record) noexcept ;
+
+    // Drain all rings to disk now (blocks until done)
+    void flush() ;
+
+    [[nodiscard]] uint64_t dropped() const noexcept ;
+    [[nodiscard]] uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed) ; }
+
+private:
+    class Ring ;
+    class Segment ;
+
+    AccessLogConfig config_ ;
+    std::vector<std::unique_ptr<Ring>> rings_ ;
+    std::unique_ptr<Ring> shared_ring_ ;
+    std::mutex shared_mutex_ ;
+
+    std::unique_ptr<Segment> segment_ ;
+    uint64_t segment_seq_ = 0 ;
+    std::atomic<uint64_t> written_{0} ;
+
+    std::mutex flush_mutex_ ;
+    std::condition_variable flush_cv_ ;
+    bool stop_ = false ;
+    std::thread flusher_ ;
+
+    void flusherThread() ;
+    void drainAll() ;
+    void drain(Ring& ring) ;
+    void rotate() ;
+} ;
+
+} // namespace frqs::utils
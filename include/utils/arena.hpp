@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file utils/arena.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Monotonic per-request memory resource
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace frqs::utils {
+
+// Bump allocator for everything one request needs: the parsed request,
+// the response under construction and whatever the handler allocates
+// through request.get_allocator(). Deallocation is a no-op; reset()
+// rewinds the whole arena at once when the request is done.
+//
+// Blocks survive reset() up to MAX_RETAINED bytes, so once a connection
+// has served a request of typical size the next ones allocate nothing
+// from the global heap. Allocations too big for a block get a block of
+// their own, which reset() frees. Single-threaded: a request is handled
+// by one thread at a time.
+class Arena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t BLOCK_SIZE = 8 * 1024 ;
+    static constexpr size_t MAX_RETAINED = 64 * 1024 ;
+
+    Arena() = default ;
+    ~Arena() override ;
+
+    Arena(const Arena&) = delete ;
+    Arena& operator=(const Arena&) = delete ;
+
+    // Invalidates everything allocated since the last reset
+    void reset() noexcept ;
+
+    // Bytes handed out since the last reset, and blocks held right now
+    [[nodiscard]] size_t used() const noexcept { return used_ ; }
+    [[nodiscard]] size_t blocks() const noexcept { return blocks_ ; }
+
+    // Blocks taken from the global heap over the arena's life
+    [[nodiscard]] uint64_t refills() const noexcept { return refills_ ; }
+
+private:
+    struct Block {
+        Block* next ;
+        size_t size ;   // Usable bytes after the header
+    } ;
+
+    Block* head_ = nullptr ;      // Block being carved, newest first
+    Block* spare_ = nullptr ;     // Retained BLOCK_SIZE blocks for after the next reset
+    std::byte* cursor_ = nullptr ;
+    std::byte* end_ = nullptr ;
+    size_t used_ = 0 ;
+    size_t blocks_ = 0 ;
+    uint64_t refills_ = 0 ;
+
+    void* do_allocate(size_t bytes, size_t alignment) override ;
+    void do_deallocate(void*, size_t, size_t) noexcept override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other ; }
+
+    void* grow(size_t bytes, size_t alignment) ;
+    static void release(Block* block) noexcept ;
+} ;
+
+} // namespace frqs::utils
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file utils/buffer_pool.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Size-class pool for connection input buffers
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace frqs::utils {
+
+class BufferPool ;
+
+// Input buffer borrowed from a BufferPool. Bytes are appended at the tail
+// and consumed from the front; once everything is consumed the memory goes
+// back to the pool, so an idle connection holds none.
+class Buffer {
+public:
+    Buffer() noexcept = default ;
+    ~Buffer() { reset() ; }
+
+    Buffer(Buffer&& other) noexcept ;
+    Buffer& operator=(Buffer&& other) noexcept ;
+
+    Buffer(const Buffer&) = delete ;
+    Buffer& operator=(const Buffer&) = delete ;
+
+    [[nodiscard]] char* data() noexcept { return data_ ; }
+    [[nodiscard]] const char* data() const noexcept { return data_ ; }
+    [[nodiscard]] size_t size() const noexcept { return size_ ; }
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_ ; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0 ; }
+    [[nodiscard]] bool full() const noexcept { return size_ == capacity_ ; }
+    [[nodiscard]] std::string_view view() const noexcept { return {data_, size_} ; }
+
+    // Free space after the data; commit() what was written there
+    [[nodiscard]] char* tail() noexcept { return data_ + size_ ; }
+    [[nodiscard]] size_t space() const noexcept { return capacity_ - size_ ; }
+    void commit(size_t bytes) noexcept { size_ += bytes ; }
+
+    // Drops bytes from the front, returning the memory once empty
+    void consume(size_t bytes) noexcept ;
+
+    // Returns the memory to the pool
+    void reset() noexcept ;
+
+private:
+    friend class BufferPool ;
+
+    char* data_ = nullptr ;
+    size_t size_ = 0 ;
+    size_t capacity_ = 0 ;
+    BufferPool* pool_ = nullptr ;
+} ;
+
+// Buffers come in 2, 8, 32 and 128KB classes; a buffer starts at the
+// smallest and moves up a class only when it fills before the request is
+// complete, so the common sub-1KB request never touches more than 2KB.
+// Anything past 128KB (a large request body) gets an exact allocation
+// that is freed rather than pooled.
+//
+// Released buffers are kept on per-class free lists and reused without
+// zero-filling. Buffers in use and on the free lists together stay under
+// a global limit: at the limit the free lists are trimmed first, and a
+// request for more than that fails.
+//
+// Loop thread only; the counters may be read from anywhere.
+class BufferPool {
+public:
+    static constexpr std::array<size_t, 4> CLASSES{2 * 1024, 8 * 1024, 32 * 1024, 128 * 1024} ;
+
+    explicit BufferPool(size_t limit = 256 * 1024 * 1024) noexcept : limit_(limit) {}
+    ~BufferPool() ;
+
+    BufferPool(const BufferPool&) = delete ;
+    BufferPool& operator=(const BufferPool&) = delete ;
+
+    void setLimit(size_t limit) noexcept { limit_ = limit ; }
+
+    // Grows buffer to hold at least min_capacity bytes, keeping its
+    // contents. false, leaving it as it was, when the limit is reached.
+    [[nodiscard]] bool reserve(Buffer& buffer, size_t min_capacity) ;
+
+    [[nodiscard]] size_t inUse() const noexcept { return in_use_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] size_t cached() const noexcept { return cached_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] uint64_t allocations() const noexcept { return allocations_.load(std::memory_order_relaxed) ; }
+    [[nodiscard]] uint64_t exhausted() const noexcept { return exhausted_.load(std::memory_order_relaxed) ; }
+
+private:
+    friend class Buffer ;
+
+    // Threaded through the free buffers themselves
+    struct FreeBuffer {
+        FreeBuffer* next ;
+    } ;
+
+    size_t limit_ ;
+    std::array<FreeBuffer*, CLASSES.size()> free_{} ;
+    std::atomic<size_t> in_use_{0} ;
+    std::atomic<size_t> cached_{0} ;
+    std::atomic<uint64_t> allocations_{0} ;
+    std::atomic<uint64_t> exhausted_{0} ;
+
+    [[nodiscard]] char* take(size_t capacity) ;
+    void release(char* data, size_t capacity) noexcept ;
+    [[nodiscard]] bool trim(size_t bytes) noexcept ;
+} ;
+
+} // namespace frqs::utils
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file utils/date_header.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Cached Date and Server header block
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace frqs::utils {
+
+// The Date header, plus an optional fixed Server header, as one ready-made
+// block of header lines. A background thread reformats it at every second
+// boundary; responses copy it whole instead of formatting a date each.
+//
+// Publication is a seqlock: the block lives in atomic words behind a
+// sequence counter, and a reader that overlaps an update retries, so
+// readers never lock and never see a torn date.
+class DateHeader {
+public:
+    static constexpr size_t CAPACITY = 128 ;
+    static constexpr size_t MAX_SERVER = CAPACITY - 48 ;   // Leaves room for the Date line
+
+    DateHeader() ;
+    ~DateHeader() ;
+
+    DateHeader(const DateHeader&) = delete ;
+    DateHeader& operator=(const DateHeader&) = delete ;
+
+    // Empty drops the Server line; longer than MAX_SERVER throws
+    void setServer(std::string_view server) ;
+
+    // "Date: <IMF-fixdate>\r\n" and the Server line, copied into buffer
+    [[nodiscard]] std::string_view read(std::array<char, CAPACITY>& buffer) const noexcept ;
+
+    // RFC 7231 IMF-fixdate, "Sun, 06 Nov 1994 08:49:37 GMT"
+    [[nodiscard]] static std::string format(std::chrono::system_clock::time_point time) ;
+
+private:
+    static constexpr size_t WORDS = CAPACITY / sizeof(uint64_t) ;
+
+    std::array<std::atomic<uint64_t>, WORDS> words_{} ;
+    std::atomic<size_t> size_{0} ;
+    std::atomic<uint64_t> sequence_{0} ;   // Odd while an update is in progress
+
+    // Writers: the refresh thread and setServer
+    std::mutex mutex_ ;
+    std::condition_variable wake_ ;
+    bool stop_ = false ;
+    std::string server_line_ ;
+    std::thread refresher_ ;
+
+    void publish(std::chrono::system_clock::time_point now) ;
+    void run() ;
+} ;
+
+} // namespace frqs::utils
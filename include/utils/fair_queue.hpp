@@ -0,0 +1,207 @@
+#pragma once
+
+/**
+ * @file utils/fair_queue.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Sharded deficit round-robin queue keyed by client
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace frqs::utils {
+
+// Deficit round-robin over flows identified by a 32-bit key (the client
+// IPv4). Flows are spread over independently locked shards; within a
+// shard every active flow is served up to `quantum` items per turn, and
+// consumers walk the shards round-robin. A flow only exists while it has
+// queued items, and each shard holds at most `max_flows` of them. Keys
+// beyond that share one overflow flow, so the table stays bounded.
+template <typename T>
+class FairQueue {
+public:
+    struct Config {
+        size_t shards = 16 ;
+        size_t max_flows = 1024 ;           // Per shard
+        size_t max_flow_items = 256 ;       // Per flow, 0 = unlimited
+        uint32_t quantum = 4 ;              // Items per flow per round
+    } ;
+
+    explicit FairQueue(Config config = {})
+        : config_(config)
+        , shards_(std::make_unique<Shard[]>(config_.shards ? config_.shards : 1)) {
+        if (config_.shards == 0) config_.shards = 1 ;
+        if (config_.quantum == 0) config_.quantum = 1 ;
+    }
+
+    FairQueue(const FairQueue&) = delete ;
+    FairQueue& operator=(const FairQueue&) = delete ;
+
+    // False when the key's flow is full
+    [[nodiscard]] bool push(uint32_t key, T item) ;
+
+    // Next item in DRR order, nullopt when empty
+    [[nodiscard]] std::optional<T> pop() ;
+
+    // Takes back an item pushed under key; false if it was popped already
+    [[nodiscard]] bool remove(uint32_t key, const T& item) ;
+
+    [[nodiscard]] size_t size() const noexcept { return size_.load(std::memory_order_relaxed) ; }
+
+private:
+    struct Flow {
+        std::deque<T> items ;
+        int64_t deficit = 0 ;
+        bool active = false ;
+    } ;
+
+    struct alignas(64) Shard {
+        std::mutex mutex ;
+        std::unordered_map<uint32_t, Flow> flows ;   // Node-based: Flow addresses are stable
+        Flow overflow ;
+        std::deque<std::pair<uint32_t, Flow*>> active ;
+        std::atomic<size_t> size{0} ;
+    } ;
+
+    Config config_ ;
+    std::unique_ptr<Shard[]> shards_ ;
+    std::atomic<size_t> cursor_{0} ;
+    std::atomic<size_t> size_{0} ;
+
+    [[nodiscard]] Shard& shardFor(uint32_t key) noexcept {
+        // Fibonacci hashing; neighbouring addresses land in different shards
+        uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull ;
+        return shards_[static_cast<size_t>(h >> 32) % config_.shards] ;
+    }
+
+    [[nodiscard]] std::optional<T> popFrom(Shard& shard) ;
+} ;
+
+template <typename T>
+bool FairQueue<T>::push(uint32_t key, T item) {
+    Shard& shard = shardFor(key) ;
+    std::lock_guard<std::mutex> lock(shard.mutex) ;
+
+    Flow* flow = nullptr ;
+    if (auto it = shard.flows.find(key) ; it != shard.flows.end()) {
+        flow = &it->second ;
+    } else if (shard.flows.size() < config_.max_flows) {
+        flow = &shard.flows[key] ;
+    } else {
+        flow = &shard.overflow ;
+    }
+
+    if (config_.max_flow_items != 0 && flow->items.size() >= config_.max_flow_items) {
+        return false ;
+    }
+
+    flow->items.push_back(std::move(item)) ;
+    if (!flow->active) {
+        flow->active = true ;
+        flow->deficit = 0 ;
+        shard.active.emplace_back(key, flow) ;
+    }
+
+    shard.size.fetch_add(1, std::memory_order_relaxed) ;
+    size_.fetch_add(1, std::memory_order_release) ;
+    return true ;
+}
+
+template <typename T>
+std::optional<T> FairQueue<T>::pop() {
+    // Items pushed concurrently may land in a shard already passed; keep
+    // walking while anything is queued
+    while (size_.load(std::memory_order_acquire) > 0) {
+        for (size_t i = 0 ; i < config_.shards ; ++i) {
+            Shard& shard = shards_[cursor_.fetch_add(1, std::memory_order_relaxed) % config_.shards] ;
+            if (shard.size.load(std::memory_order_relaxed) == 0) {
+                continue ;
+            }
+
+            std::lock_guard<std::mutex> lock(shard.mutex) ;
+            if (auto item = popFrom(shard)) {
+                size_.fetch_sub(1, std::memory_order_relaxed) ;
+                return item ;
+            }
+        }
+    }
+    return std::nullopt ;
+}
+
+template <typename T>
+bool FairQueue<T>::remove(uint32_t key, const T& item) {
+    Shard& shard = shardFor(key) ;
+    std::lock_guard<std::mutex> lock(shard.mutex) ;
+
+    // The item sits in the key's flow, or in the overflow if the table was full
+    Flow* flow = &shard.overflow ;
+    if (auto it = shard.flows.find(key) ; it != shard.flows.end()) {
+        flow = &it->second ;
+    }
+    auto found = std::find(flow->items.begin(), flow->items.end(), item) ;
+    if (found == flow->items.end() && flow != &shard.overflow) {
+        flow = &shard.overflow ;
+        found = std::find(flow->items.begin(), flow->items.end(), item) ;
+    }
+    if (found == flow->items.end()) {
+        return false ;
+    }
+
+    flow->items.erase(found) ;
+    shard.size.fetch_sub(1, std::memory_order_relaxed) ;
+    size_.fetch_sub(1, std::memory_order_relaxed) ;
+
+    if (flow->items.empty()) {
+        std::erase_if(shard.active, [flow](const auto& entry) { return entry.second == flow ; }) ;
+        flow->active = false ;
+        if (flow != &shard.overflow) {
+            shard.flows.erase(key) ;
+        }
+    }
+    return true ;
+}
+
+template <typename T>
+std::optional<T> FairQueue<T>::popFrom(Shard& shard) {
+    if (shard.active.empty()) {
+        return std::nullopt ;
+    }
+
+    auto [key, flow] = shard.active.front() ;
+
+    // A new turn for this flow
+    if (flow->deficit <= 0) {
+        flow->deficit += config_.quantum ;
+    }
+
+    T item = std::move(flow->items.front()) ;
+    flow->items.pop_front() ;
+    --flow->deficit ;
+    shard.size.fetch_sub(1, std::memory_order_relaxed) ;
+
+    if (flow->items.empty()) {
+        shard.active.pop_front() ;
+        flow->active = false ;
+        if (flow != &shard.overflow) {
+            shard.flows.erase(key) ;
+        }
+    } else if (flow->deficit <= 0) {
+        shard.active.pop_front() ;
+        shard.active.emplace_back(key, flow) ;
+    }
+
+    return item ;
+}
+
+} // namespace frqs::utils
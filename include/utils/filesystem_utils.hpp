@@ -12,6 +12,7 @@
  */
 
 #include <filesystem>
+#include <memory_resource>
 #include <optional>
 #include <string>
 
@@ -34,6 +35,10 @@ public:
     [[nodiscard]] static std::optional<std::string> 
     readFile(const std::filesystem::path& path, size_t max_size = 10 * 1024 * 1024) ;
     
+    // Same, straight into out (a response body) with a single read
+    [[nodiscard]] static bool
+    readFile(const std::filesystem::path& path, std::pmr::string& out, size_t max_size = 10 * 1024 * 1024) ;
+    
     // Normalize path (remove .., ., etc.)
     [[nodiscard]] static std::filesystem::path normalizePath(std::string_view path) ;
 } ;
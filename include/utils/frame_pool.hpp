@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file utils/frame_pool.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Size-class pool for coroutine frames
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace frqs::utils {
+
+// Recycles coroutine frames. Sizes up to 4KB are rounded to a power of two
+// and served from a per-thread free list; bigger frames go to operator
+// new. Frames often start on a worker and finish on the event loop, so a
+// thread whose list grows past its cap hands a batch to a shared depot,
+// and a thread that runs dry takes a batch back. The lock is taken once
+// per batch, not per frame.
+class FramePool {
+public:
+    static constexpr size_t MIN_SIZE = 64 ;
+    static constexpr size_t MAX_SIZE = 4096 ;
+
+    [[nodiscard]] static void* allocate(size_t size) ;
+    static void deallocate(void* frame, size_t size) noexcept ;
+
+    // Process-wide, for tests and benchmarks
+    [[nodiscard]] static uint64_t allocations() noexcept ;
+    [[nodiscard]] static uint64_t reused() noexcept ;
+} ;
+
+} // namespace frqs::utils
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file utils/histogram.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace frqs::utils {
+
+// HDR-style log-linear histogram: values below 2^(SUB_BITS+1) are exact,
+// above that every power of two is split into 2^SUB_BITS linear buckets
+// (~6% relative error). Values are unitless; the server records microseconds.
+class Histogram {
+public:
+    static constexpr uint32_t SUB_BITS = 4 ;
+    static constexpr uint32_t SUB_COUNT = 1u << SUB_BITS ;
+    static constexpr uint32_t MAX_BITS = 40 ;
+    static constexpr uint64_t MAX_VALUE = (uint64_t{1} << MAX_BITS) - 1 ;
+    static constexpr size_t BUCKET_COUNT = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT ;
+
+    [[nodiscard]] static constexpr size_t bucketIndex(uint64_t value) noexcept {
+        if (value > MAX_VALUE) value = MAX_VALUE ;
+        if (value < 2 * SUB_COUNT) return static_cast<size_t>(value) ;
+        uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - (SUB_BITS + 1) ;
+        return shift * SUB_COUNT + static_cast<size_t>(value >> shift) ;
+    }
+
+    // Largest value that maps to the bucket
+    [[nodiscard]] static constexpr uint64_t bucketUpperBound(size_t index) noexcept {
+        if (index < 2 * SUB_COUNT) return index ;
+        uint32_t shift = static_cast<uint32_t>(index / SUB_COUNT) - 1 ;
+        uint64_t mantissa = index % SUB_COUNT + SUB_COUNT ;
+        return ((mantissa + 1) << shift) - 1 ;
+    }
+
+    // Merged, non-atomic view used for reporting
+    struct Snapshot {
+        std::vector<uint64_t> counts = std::vector<uint64_t>(BUCKET_COUNT, 0) ;
+        uint64_t count = 0 ;
+        uint64_t sum = 0 ;
+        uint64_t max = 0 ;
+
+        void add(uint64_t value, uint64_t times = 1) noexcept ;
+        void merge(const Snapshot& other) noexcept ;
+
+        // q in [0, 1]; returns the bucket upper bound holding that rank
+        [[nodiscard]] uint64_t percentile(double q) const noexcept ;
+        [[nodiscard]] double mean() const noexcept {
+            return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0 ;
+        }
+    } ;
+
+    // Single writer: increments are a relaxed load and store, never an RMW.
+    // Readers may observe a slightly stale histogram but never a torn counter.
+    void record(uint64_t value) noexcept {
+        auto& bucket = counts_[bucketIndex(value)] ;
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed) ;
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed) ;
+        sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed) ;
+        if (value > max_.load(std::memory_order_relaxed)) {
+            max_.store(value, std::memory_order_relaxed) ;
+        }
+    }
+
+    void mergeInto(Snapshot& out) const noexcept ;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{} ;
+    std::atomic<uint64_t> count_{0} ;
+    std::atomic<uint64_t> sum_{0} ;
+    std::atomic<uint64_t> max_{0} ;
+} ;
+
+} // namespace frqs::utils
@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @file utils/json.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace frqs::utils {
+
+// Appends s as a quoted JSON string literal
+inline void appendJsonString(std::string& out, std::string_view s) {
+    out += '"' ;
+    for (char c : s) {
+        switch (c) {
+            case '"':  out += "\\\"" ; break ;
+            case '\\': out += "\\\\" ; break ;
+            case '\n': out += "\\n" ; break ;
+            case '\r': out += "\\r" ; break ;
+            case '\t': out += "\\t" ; break ;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c)) ;
+                } else {
+                    out += c ;
+                }
+        }
+    }
+    out += '"' ;
+}
+
+} // namespace frqs::utils
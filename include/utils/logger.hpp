@@ -15,17 +15,35 @@
 	#undef ERROR
 #endif
 
+#include <atomic>
 #include <cstdint>
+#include <filesystem>
 #include <format>
+#include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <chrono>
+#include <type_traits>
+#include <utility>
+
+// Lowest level compiled into the binary (0 = INFO, 1 = WARN, 2 = ERROR).
+// Log statements below it are removed entirely.
+#ifndef FRQS_LOG_MIN_LEVEL
+	#define FRQS_LOG_MIN_LEVEL 0
+#endif
 
 namespace frqs::utils {
 
 enum class Level : uint8_t {INFO, WARN, ERROR} ;
 
-[[nodiscard]] inline std::string CreateLog(Level level, std::string_view msg) noexcept {
+inline constexpr Level COMPILE_TIME_MIN_LEVEL = static_cast<Level>(FRQS_LOG_MIN_LEVEL) ;
+
+[[nodiscard]] inline std::string CreateLog(
+    Level level,
+    std::string_view msg,
+    std::chrono::system_clock::time_point when = std::chrono::system_clock::now()
+) noexcept {
     std::string_view level_str ;
     switch (level) {
         using enum Level ;
@@ -34,16 +52,97 @@ enum class Level : uint8_t {INFO, WARN, ERROR} ;
         case ERROR: level_str = "ERROR" ; break ;
     }
 
-    auto now = std::chrono::system_clock::now() ;
-    auto local_time = std::chrono::zoned_time{std::chrono::current_zone(), now} ;
+    auto local_time = std::chrono::zoned_time{std::chrono::current_zone(), when} ;
 
     return std::format("[{:%F %T}] [{:<5}] {}", local_time, level_str, msg) ;
 }
 
+[[nodiscard]] std::optional<Level> parseLevel(std::string_view name) noexcept ;
+
+namespace detail {
+
+inline std::atomic<uint8_t> g_min_level{FRQS_LOG_MIN_LEVEL} ;
+
+// Formats a captured message; runs on the background writer thread
+using DeferredMessage = std::move_only_function<std::string()> ;
+
+void enqueue(Level level, std::string message) ;
+void enqueue(Level level, DeferredMessage message) ;
+
+// Arguments are captured by value. Views are copied into owned strings
+// since the request buffers they point into are gone by the time the
+// writer formats them.
+template <typename T>
+[[nodiscard]] auto capture(T&& value) {
+    using U = std::remove_cvref_t<T> ;
+    if constexpr (std::is_convertible_v<const U&, std::string_view>) {
+        return std::string(std::string_view(value)) ;
+    } else if constexpr (std::is_same_v<U, std::filesystem::path>) {
+        return value.string() ;
+    } else {
+        return U(std::forward<T>(value)) ;
+    }
+}
+
+template <typename T>
+using capture_t = decltype(capture(std::declval<T>())) ;
+
+} // namespace detail
+
+// Runtime threshold, checked before any formatting or capture happens
+void setLogLevel(Level level) noexcept ;
+[[nodiscard]] inline Level getLogLevel() noexcept {
+    return static_cast<Level>(detail::g_min_level.load(std::memory_order_relaxed)) ;
+}
+
+[[nodiscard]] inline bool shouldLog(Level level) noexcept {
+    return static_cast<uint8_t>(level) >= detail::g_min_level.load(std::memory_order_relaxed) ;
+}
+
+template <Level L>
+inline void logMessage(std::string_view message) {
+    if constexpr (L >= COMPILE_TIME_MIN_LEVEL) {
+        if (shouldLog(L)) {
+            detail::enqueue(L, std::string(message)) ;
+        }
+    }
+}
+
+// Lazy variant: arguments are captured and only formatted by the writer
+template <Level L, typename... Args>
+inline void log(std::format_string<detail::capture_t<Args>...> fmt, Args&&... args) {
+    if constexpr (L >= COMPILE_TIME_MIN_LEVEL) {
+        if (shouldLog(L)) {
+            detail::enqueue(L, [fmt, ...captured = detail::capture(std::forward<Args>(args))]() {
+                return std::vformat(fmt.get(), std::make_format_args(captured...)) ;
+            }) ;
+        }
+    }
+}
+
 // Helper functions for logging
-void logInfo(std::string_view message) ;
-void logWarn(std::string_view message) ;
-void logError(std::string_view message) ;
+inline void logInfo(std::string_view message) { logMessage<Level::INFO>(message) ; }
+inline void logWarn(std::string_view message) { logMessage<Level::WARN>(message) ; }
+inline void logError(std::string_view message) { logMessage<Level::ERROR>(message) ; }
+
+template <typename... Args> requires (sizeof...(Args) > 0)
+inline void logInfo(std::format_string<detail::capture_t<Args>...> fmt, Args&&... args) {
+    log<Level::INFO>(fmt, std::forward<Args>(args)...) ;
+}
+
+template <typename... Args> requires (sizeof...(Args) > 0)
+inline void logWarn(std::format_string<detail::capture_t<Args>...> fmt, Args&&... args) {
+    log<Level::WARN>(fmt, std::forward<Args>(args)...) ;
+}
+
+template <typename... Args> requires (sizeof...(Args) > 0)
+inline void logError(std::format_string<detail::capture_t<Args>...> fmt, Args&&... args) {
+    log<Level::ERROR>(fmt, std::forward<Args>(args)...) ;
+}
+
 void enableFileLogging(const std::string& filename) ;
 
+// Block until every queued message has been written
+void flushLogs() ;
+
 } // namespace frqs::utils
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file utils/metrics.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "histogram.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace frqs::utils {
+
+// Server-wide counters. Every writer thread owns one cache-line aligned
+// slot and updates it with plain relaxed stores; a scrape sums all slots.
+// The counter slots may live in memory shared between processes (see
+// share()); latency histograms always stay in the process.
+class Metrics {
+public:
+    static constexpr size_t MAX_ROUTES = 64 ;
+    static constexpr size_t OVERFLOW_ROUTE = MAX_ROUTES - 1 ;   // Reserved for OVERFLOW_NAME
+    static constexpr std::string_view OVERFLOW_NAME = "other" ;
+
+    enum Counter : uint8_t {
+        REQUESTS_1XX,
+        REQUESTS_2XX,
+        REQUESTS_3XX,
+        REQUESTS_4XX,
+        REQUESTS_5XX,
+        BYTES_IN,
+        BYTES_OUT,
+        CONNECTIONS_OPENED,
+        CONNECTIONS_CLOSED,
+        PARSE_ERRORS,
+        TIMEOUTS,
+        SHED_CONNECTIONS,
+        SHED_QUEUE,
+        SHED_CLIENT,
+        SHED_DELAY,
+        RATE_LIMITED,
+        ACCESS_DENIED,
+        COUNTER_COUNT
+    } ;
+
+    using Source = std::function<double()> ;
+
+    struct alignas(64) CounterSlot {
+        std::array<std::atomic<uint64_t>, COUNTER_COUNT> counters{} ;
+    } ;
+
+    // Shared slots are updated by several processes through the same atomics
+    static_assert(std::atomic<uint64_t>::is_always_lock_free) ;
+
+    // slot_count writers; callers map their thread to a slot themselves
+    explicit Metrics(size_t slot_count) ;
+    ~Metrics() ;
+
+    Metrics(const Metrics&) = delete ;
+    Metrics& operator=(const Metrics&) = delete ;
+    Metrics(Metrics&&) = delete ;
+    Metrics& operator=(Metrics&&) = delete ;
+
+    // Setup-time registration. The last id is reserved: once the other
+    // MAX_ROUTES - 1 are named, every new route is labelled "other" and the
+    // first such registration logs a warning.
+    [[nodiscard]] size_t registerRoute(std::string name) ;
+
+    // Values read lazily at scrape time (queue depth, subsystem counters)
+    void addGauge(std::string name, std::string help, Source source) ;
+    void addCounter(std::string name, std::string help, Source source) ;
+
+    // Setup-time: write to slots [first, first + slotCount()) of shared,
+    // carrying over what was counted so far, and have total() sum all of
+    // shared. Processes sharing one array report one set of totals.
+    // Throws std::runtime_error if the range does not fit.
+    void share(std::span<CounterSlot> shared, size_t first) ;
+
+    // Hot path, single writer per slot
+    void add(size_t slot, Counter counter, uint64_t value = 1) noexcept {
+        auto& c = counters_[slot].counters[counter] ;
+        c.store(c.load(std::memory_order_relaxed) + value, std::memory_order_relaxed) ;
+    }
+
+    void recordRequest(size_t slot, size_t route, uint16_t status,
+                       uint64_t bytes_in, uint64_t bytes_out, uint64_t latency_us) noexcept ;
+
+    [[nodiscard]] uint64_t total(Counter counter) const noexcept ;
+    [[nodiscard]] Histogram::Snapshot latency(size_t route) const ;
+
+    // Prometheus text exposition format 0.0.4
+    [[nodiscard]] std::string renderPrometheus() const ;
+
+    [[nodiscard]] size_t slotCount() const noexcept { return slot_count_ ; }
+
+private:
+    struct alignas(64) RouteSlot {
+        std::array<std::atomic<Histogram*>, MAX_ROUTES> routes{} ;
+    } ;
+
+    struct External {
+        std::string name ;
+        std::string help ;
+        Source source ;
+        bool is_counter ;
+    } ;
+
+    size_t slot_count_ ;
+    std::unique_ptr<CounterSlot[]> own_counters_ ;
+    std::span<CounterSlot> counters_ ;   // Written, slot_count_ long
+    std::span<CounterSlot> totals_ ;     // Summed: counters_, or all of a shared array
+    std::unique_ptr<RouteSlot[]> routes_ ;
+
+    mutable std::mutex registry_mutex_ ;
+    std::vector<std::string> route_names_ ;
+    std::vector<External> externals_ ;
+
+    Histogram& routeHistogram(size_t slot, size_t route) ;
+} ;
+
+} // namespace frqs::utils
@@ -12,6 +12,8 @@
  */
 
 #include <vector>
+#include <atomic>
+#include <chrono>
 #include <queue>
 #include <thread>
 #include <mutex>
@@ -19,12 +21,15 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <span>
 #include <stdexcept>
 
 namespace frqs::utils {
 
 class ThreadPool {
 public:
+    static constexpr size_t npos = static_cast<size_t>(-1) ;
+    
     explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency()) ;
     ~ThreadPool() ;
     
@@ -43,16 +48,31 @@ public:
     
     // Get the number of pending tasks
     [[nodiscard]] size_t pendingTasks() const noexcept ;
+    
+    // Index of the calling worker thread in [0, size()), npos elsewhere
+    [[nodiscard]] static size_t workerIndex() noexcept ;
+    
+    // Busy mode: an idle worker polls the queue, pausing and then
+    // yielding, for this long before it parks on the condition variable.
+    // Zero (the default) parks at once.
+    void setSpin(std::chrono::nanoseconds spin) noexcept ;
+    
+    // Worker i runs on cpus[i % cpus.size()]; false if the OS refused any
+    bool pin(std::span<const int> cpus) ;
+    static bool pinCurrentThread(int cpu) noexcept ;
 
 private:
     std::vector<std::thread> workers_ ;
     std::queue<std::function<void()>> tasks_ ;
+    std::atomic<size_t> pending_{0} ;   // tasks_.size(), readable without the lock
+    std::atomic<int64_t> spin_ns_{0} ;
     
     mutable std::mutex queue_mutex_ ;
     std::condition_variable condition_ ;
     bool stop_ = false ;
     
-    void workerThread() ;
+    void workerThread(size_t index) ;
+    void spin(std::chrono::nanoseconds limit) const noexcept ;
 } ;
 
 // Template implementation must be in header
@@ -76,6 +96,7 @@ auto ThreadPool::submit(F&& f, Args&&... args)
         }
         
         tasks_.emplace([task]() { (*task)() ; }) ;
+        pending_.fetch_add(1, std::memory_order_release) ;
     }
     
     condition_.notify_one() ;
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file utils/timer_wheel.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace frqs::utils {
+
+// Hierarchical timing wheel (4 levels x 64 slots). Timers are intrusive
+// nodes embedded in their owner, so arming and cancelling are a couple of
+// pointer writes with no allocation. Expiry cascades a slot of the next
+// level every 64 ticks. Not thread safe; owned by a single event loop.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock ;
+
+    static constexpr uint32_t SLOT_BITS = 6 ;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS ;
+    static constexpr uint32_t LEVELS = 4 ;
+    static constexpr uint64_t MAX_SPAN = uint64_t{1} << (SLOT_BITS * LEVELS) ;   // Ticks
+
+    struct Link {
+        Link* prev = this ;
+        Link* next = this ;
+
+        [[nodiscard]] bool linked() const noexcept { return next != this ; }
+        void unlink() noexcept {
+            prev->next = next ;
+            next->prev = prev ;
+            prev = next = this ;
+        }
+    } ;
+
+    // Embed (or inherit) in the object that owns the deadline
+    class Timer : private Link {
+    public:
+        Timer() = default ;
+        ~Timer() { cancel() ; }
+
+        Timer(const Timer&) = delete ;
+        Timer& operator=(const Timer&) = delete ;
+
+        [[nodiscard]] bool armed() const noexcept { return linked() ; }
+        void cancel() noexcept ;
+
+    private:
+        friend class TimerWheel ;
+        TimerWheel* wheel_ = nullptr ;
+        uint64_t expiry_ = 0 ;   // Absolute tick
+    } ;
+
+    explicit TimerWheel(
+        std::chrono::milliseconds resolution = std::chrono::milliseconds(10),
+        Clock::time_point now = Clock::now()
+    ) ;
+
+    TimerWheel(const TimerWheel&) = delete ;
+    TimerWheel& operator=(const TimerWheel&) = delete ;
+
+    // (Re)arm; the timer fires on the first advance() at or past deadline
+    void arm(Timer& timer, Clock::time_point deadline) noexcept ;
+    void arm(Timer& timer, Clock::duration delay) noexcept { arm(timer, Clock::now() + delay) ; }
+
+    // Fire every timer due by now. The timer is unlinked before the
+    // callback runs, so it may re-arm it or destroy its owner.
+    template <typename F>
+    size_t advance(Clock::time_point now, F&& on_expire) ;
+
+    // Time until the wheel next needs advance(); nullopt when empty
+    [[nodiscard]] std::optional<Clock::duration> nextTimeout(Clock::time_point now) const noexcept ;
+
+    [[nodiscard]] size_t size() const noexcept { return size_ ; }
+
+private:
+    Clock::duration resolution_ ;
+    Clock::time_point origin_ ;
+    uint64_t current_ = 0 ;   // Last processed tick
+    size_t size_ = 0 ;
+    std::array<std::array<Link, SLOTS>, LEVELS> slots_ ;
+
+    [[nodiscard]] uint64_t tickAt(Clock::time_point t) const noexcept ;
+    void place(Timer& timer) noexcept ;
+    void cascade(uint32_t level) noexcept ;
+
+    // Move the due slot onto a private list so callbacks can touch the wheel
+    static void splice(Link& from, Link& to) noexcept ;
+} ;
+
+inline void TimerWheel::Timer::cancel() noexcept {
+    if (linked()) {
+        unlink() ;
+        --wheel_->size_ ;
+    }
+}
+
+template <typename F>
+size_t TimerWheel::advance(Clock::time_point now, F&& on_expire) {
+    uint64_t target = tickAt(now) ;
+    size_t fired = 0 ;
+
+    while (current_ < target) {
+        ++current_ ;
+        uint32_t index = static_cast<uint32_t>(current_ & (SLOTS - 1)) ;
+        if (index == 0) {
+            cascade(1) ;
+        }
+
+        Link due ;
+        splice(slots_[0][index], due) ;
+
+        while (due.linked()) {
+            auto& timer = static_cast<Timer&>(*due.next) ;
+            timer.unlink() ;
+            --size_ ;
+
+            // Clamped far-future timers go around again
+            if (timer.expiry_ > current_) {
+                place(timer) ;
+                continue ;
+            }
+
+            ++fired ;
+            on_expire(timer) ;
+        }
+    }
+
+    return fired ;
+}
+
+} // namespace frqs::utils
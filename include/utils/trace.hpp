@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file utils/trace.hpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+    #include <intrin.h>
+#endif
+
+// Set to 0 to compile per-request tracing out entirely
+#ifndef FRQS_ENABLE_TRACING
+    #define FRQS_ENABLE_TRACING 1
+#endif
+
+namespace frqs::utils::trace {
+
+// Request lifecycle, in the order a static file request passes through it.
+// ACCEPTED is the accept for a connection's first request and the first
+// byte for later keep-alive requests.
+enum class Phase : uint8_t {
+    ACCEPTED,
+    RECEIVED,
+    DEQUEUED,
+    PARSED,
+    RESOLVED,
+    FILE_READ,
+    HANDLED,
+    BUILT,
+    SENT,
+    COUNT
+} ;
+
+// Raw timestamp: TSC on x86, steady_clock nanoseconds elsewhere
+[[nodiscard]] inline uint64_t ticks() noexcept {
+#if !FRQS_ENABLE_TRACING
+    return 0 ;
+#elif defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc() ;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count()) ;
+#endif
+}
+
+// Calibrated once on first use
+[[nodiscard]] double ticksPerMicrosecond() noexcept ;
+
+struct RequestTrace {
+#if FRQS_ENABLE_TRACING
+    std::array<uint64_t, static_cast<size_t>(Phase::COUNT)> marks{} ;   // 0 = not reached
+
+    void mark(Phase phase) noexcept { marks[static_cast<size_t>(phase)] = ticks() ; }
+    void mark(Phase phase, uint64_t at) noexcept { marks[static_cast<size_t>(phase)] = at ; }
+    [[nodiscard]] uint64_t at(Phase phase) const noexcept { return marks[static_cast<size_t>(phase)] ; }
+#else
+    void mark(Phase) noexcept {}
+    void mark(Phase, uint64_t) noexcept {}
+    [[nodiscard]] uint64_t at(Phase) const noexcept { return 0 ; }
+#endif
+} ;
+
+// Trace of the request running on this thread, null when not tracing
+inline thread_local RequestTrace* t_current = nullptr ;
+
+inline void mark(Phase phase) noexcept {
+#if FRQS_ENABLE_TRACING
+    if (t_current) {
+        t_current->mark(phase) ;
+    }
+#else
+    (void)phase ;
+#endif
+}
+
+// Installs a trace as current for the lifetime of the scope
+class Scope {
+public:
+    explicit Scope(RequestTrace* trace) noexcept : previous_(t_current) { t_current = trace ; }
+    ~Scope() { t_current = previous_ ; }
+
+    Scope(const Scope&) = delete ;
+    Scope& operator=(const Scope&) = delete ;
+
+private:
+    RequestTrace* previous_ ;
+} ;
+
+struct TracerConfig {
+    std::filesystem::path output = "zhttp_trace.json" ;
+    uint32_t sample_every = 0 ;                          // 1-in-N requests, 0 disables sampling
+    std::chrono::microseconds slow_threshold{10'000} ;   // Always keep slower requests, 0 disables
+} ;
+
+// Writes selected request traces as Chrome trace-event JSON (open in
+// Perfetto or chrome://tracing). Selection is per thread and lock-free;
+// only kept traces take the file mutex.
+class Tracer {
+public:
+    explicit Tracer(TracerConfig config) ;
+    ~Tracer() ;
+
+    Tracer(const Tracer&) = delete ;
+    Tracer& operator=(const Tracer&) = delete ;
+    Tracer(Tracer&&) = delete ;
+    Tracer& operator=(Tracer&&) = delete ;
+
+    // Called once per request after the response is sent
+    void finish(const RequestTrace& trace, size_t thread_id,
+                std::string_view method, std::string_view path, uint16_t status) ;
+
+    [[nodiscard]] uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed) ; }
+
+private:
+    TracerConfig config_ ;
+    uint64_t slow_ticks_ = 0 ;
+    uint64_t origin_ticks_ = 0 ;
+    double ticks_per_us_ = 1.0 ;
+
+    std::mutex file_mutex_ ;
+    std::ofstream file_ ;
+    std::atomic<uint64_t> written_{0} ;
+    uint64_t next_id_ = 0 ;
+
+    [[nodiscard]] bool keep(const RequestTrace& trace) const noexcept ;
+    [[nodiscard]] double toMicros(uint64_t t) const noexcept ;
+} ;
+
+} // namespace frqs::utils::trace
+
+#define FRQS_TRACE_MARK(phase) ::frqs::utils::trace::mark(::frqs::utils::trace::Phase::phase)
@@ -0,0 +1,78 @@
+#!/usr/bin/env bash
+# Loopback load test: starts FRQS_NET against a generated document root,
+# drives it with zhttp_load and records one JSON file per scenario.
+#
+# Usage: scripts/loadtest.sh [duration_s] [server_threads]
+#   BIN_DIR  directory holding FRQS_NET and zhttp_load (default ./bin)
+#   PORT     listen port (default 18080)
+#   OUT_DIR  results directory (default results/loadtest-<timestamp>)
+
+set -euo pipefail
+
+DURATION="${1:-10}"
+SERVER_THREADS="${2:-4}"
+BIN_DIR="${BIN_DIR:-./bin}"
+PORT="${PORT:-18080}"
+OUT_DIR="${OUT_DIR:-results/loadtest-$(date +%Y%m%d-%H%M%S)}"
+
+SERVER="$BIN_DIR/FRQS_NET"
+LOAD="$BIN_DIR/zhttp_load"
+
+for bin in "$SERVER" "$LOAD"; do
+    [[ -x "$bin" ]] || { echo "missing $bin (build first)" >&2; exit 1; }
+done
+
+DOC_ROOT="$(mktemp -d)"
+SERVER_PID=""
+
+cleanup() {
+    [[ -n "$SERVER_PID" ]] && kill "$SERVER_PID" 2>/dev/null && wait "$SERVER_PID" 2>/dev/null || true
+    rm -rf "$DOC_ROOT"
+}
+trap cleanup EXIT
+
+# Document root: a small page plus fixed-size payloads
+echo '<!doctype html><html><body><h1>zhttp</h1></body></html>' > "$DOC_ROOT/index.html"
+head -c 1024   /dev/urandom > "$DOC_ROOT/1k.bin"
+head -c 16384  /dev/urandom > "$DOC_ROOT/16k.bin"
+head -c 262144 /dev/urandom > "$DOC_ROOT/256k.bin"
+
+mkdir -p "$OUT_DIR"
+
+ZHTTP_LOG_LEVEL=error "$SERVER" "$PORT" "$DOC_ROOT" "$SERVER_THREADS" > "$OUT_DIR/server.log" 2>&1 &
+SERVER_PID=$!
+
+# Wait for the listener
+for _ in $(seq 50); do
+    if (exec 3<>"/dev/tcp/127.0.0.1/$PORT") 2>/dev/null; then
+        break
+    fi
+    sleep 0.1
+done
+
+run() {
+    local label="$1"; shift
+    echo "== $label"
+    "$LOAD" --port="$PORT" --duration="$DURATION" --label="$label" \
+            --json="$OUT_DIR/$label.json" "$@" | tee "$OUT_DIR/$label.txt"
+    echo
+}
+
+run closed-index-c64      --connections=64  --path=/
+run closed-1k-c64         --connections=64  --path=/1k.bin
+run closed-16k-c64        --connections=64  --path=/16k.bin
+run closed-256k-c16       --connections=16  --path=/256k.bin
+run closed-index-c256     --connections=256 --path=/
+run closed-pipeline8-c16  --connections=16  --pipeline=8 --path=/
+run open-index-r5000      --connections=64  --rate=5000 --path=/
+run open-mixed-r2000      --connections=64  --rate=2000 --path=/ --path=/1k.bin --path=/16k.bin
+
+{
+    echo "commit: $(git rev-parse --short HEAD 2>/dev/null || echo unknown)"
+    echo "host: $(uname -srm)"
+    echo "cpus: $(nproc 2>/dev/null || echo unknown)"
+    echo "server_threads: $SERVER_THREADS"
+    echo "duration_s: $DURATION"
+} > "$OUT_DIR/env.txt"
+
+echo "Results written to $OUT_DIR"
@@ -0,0 +1,68 @@
+#include "core/admission.hpp"
+#include "http/response.hpp"
+#include <format>
+#include <limits>
+
+namespace frqs::core {
+
+namespace {
+    constexpr uint64_t NO_SAMPLE = std::numeric_limits<uint64_t>::max();
+
+    uint64_t toNanos(std::chrono::steady_clock::duration d) noexcept {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+        return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+    }
+}
+
+AdmissionControl::AdmissionControl(AdmissionConfig config)
+    : config_(config)
+    , target_ns_(toNanos(config.target_delay))
+    , interval_ns_(toNanos(config.interval))
+    , window_min_ns_(NO_SAMPLE)
+{
+    overload_response_ = http::HTTPResponse()
+        .setStatus(503)
+        .setHeader("Retry-After", std::format("{}", config_.retry_after.count()))
+        .setHeader("Connection", "close")
+        .setContentType("text/html")
+        .setBody("<h1>503 - Service Unavailable</h1>")
+        .build();
+}
+
+bool AdmissionControl::tryEnqueue() noexcept {
+    // Only the event loop enqueues, so load + add cannot overshoot
+    if (config_.max_queued != 0 && queued_.load(std::memory_order_relaxed) >= config_.max_queued) {
+        return false;
+    }
+    queued_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AdmissionControl::dequeued(Clock::duration waited, Clock::time_point now) noexcept {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (target_ns_ == 0) {
+        return false;
+    }
+
+    uint64_t sample = toNanos(waited);
+    auto now_ns = static_cast<int64_t>(toNanos(now.time_since_epoch()));
+
+    // Close the window: overloaded if no request got through quickly
+    int64_t end = window_end_ns_.load(std::memory_order_relaxed);
+    if (now_ns >= end &&
+        window_end_ns_.compare_exchange_strong(end, now_ns + static_cast<int64_t>(interval_ns_),
+                                               std::memory_order_relaxed)) {
+        uint64_t window_min = window_min_ns_.exchange(sample, std::memory_order_relaxed);
+        overloaded_.store(window_min != NO_SAMPLE && window_min > target_ns_, std::memory_order_relaxed);
+    } else {
+        uint64_t current = window_min_ns_.load(std::memory_order_relaxed);
+        while (sample < current &&
+               !window_min_ns_.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t limit = overloaded_.load(std::memory_order_relaxed) ? target_ns_ : interval_ns_;
+    return sample > limit;
+}
+
+} // namespace frqs::core
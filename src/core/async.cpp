@@ -0,0 +1,126 @@
+#include "core/async.hpp"
+
+namespace frqs::core {
+
+namespace {
+    void* tagged(AsyncLoop::IoWait& wait) noexcept {
+        return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(&wait) | 1);
+    }
+
+    AsyncLoop::IoWait& untagged(void* data) noexcept {
+        return *reinterpret_cast<AsyncLoop::IoWait*>(reinterpret_cast<uintptr_t>(data) & ~uintptr_t{1});
+    }
+}
+
+void detail::taskFinished(AsyncLoop& loop, void* tag) noexcept {
+    loop.on_finished_(tag);
+}
+
+AsyncLoop::AsyncLoop(net::Poller& poller, utils::ThreadPool& pool, std::function<void(void*)> on_finished)
+    : poller_(poller), pool_(pool), on_finished_(std::move(on_finished)) {}
+
+void AsyncLoop::post(Op& op) noexcept {
+    {
+        std::lock_guard lock(posted_mutex_);
+        op.next = posted_;
+        posted_ = &op;
+    }
+    poller_.wake();
+}
+
+void AsyncLoop::offload(std::function<void()> work) {
+    pool_.submit(std::move(work));
+}
+
+void AsyncLoop::watch(net::Poller::handle_t handle, uint32_t interest, IoWait& wait) {
+    poller_.add(handle, interest, tagged(wait));
+}
+
+void AsyncLoop::run(Clock::time_point now) {
+    Op* list;
+    {
+        std::lock_guard lock(posted_mutex_);
+        list = std::exchange(posted_, nullptr);
+    }
+
+    // Posted LIFO, run FIFO
+    Op* ordered = nullptr;
+    while (list) {
+        Op* next = list->next;
+        list->next = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    // An op usually resumes a coroutine, which may post again or finish
+    // and release the memory the op lives in, so next is read first
+    while (ordered) {
+        Op* next = ordered->next;
+        ordered->run(*ordered);
+        ordered = next;
+    }
+
+    timers_.advance(now, [](utils::TimerWheel::Timer& expired) {
+        auto& timer = static_cast<Timer&>(expired);
+        timer.fire(timer);
+    });
+}
+
+void AsyncLoop::dispatch(const net::Poller::Event& event) noexcept {
+    IoWait& wait = untagged(event.data);
+    wait.ready(wait, event.events);
+}
+
+namespace detail {
+
+// The awaiting thread may be a worker; the timer wheel belongs to the loop
+void SleepAwaiter::suspend() noexcept {
+    run = [](AsyncLoop::Op& op) {
+        auto& self = static_cast<SleepAwaiter&>(op);
+        self.fire = [](AsyncLoop::Timer& timer) { static_cast<SleepAwaiter&>(timer).waiter.resume(); };
+        self.loop->arm(self, self.deadline_);
+    };
+    loop->post(*this);
+}
+
+IoAwaiter::~IoAwaiter() {
+    // Only reached while watching when the coroutine is torn down mid-wait
+    if (watching_) {
+        loop->unwatch(handle_);
+    }
+}
+
+void IoAwaiter::suspend() noexcept {
+    run = [](AsyncLoop::Op& op) {
+        auto& self = static_cast<IoAwaiter&>(op);
+        self.ready = [](AsyncLoop::IoWait& wait, uint32_t) { static_cast<IoAwaiter&>(wait).finish(true); };
+        self.fire = [](AsyncLoop::Timer& timer) { static_cast<IoAwaiter&>(timer).finish(false); };
+
+        try {
+            self.loop->watch(self.handle_, self.interest_, self);
+        } catch (...) {
+            // Already registered or not a socket: await_resume() rethrows
+            self.error_ = std::current_exception();
+            self.waiter.resume();
+            return;
+        }
+
+        self.watching_ = true;
+        if (self.timeout_ > AsyncLoop::Clock::duration::zero()) {
+            self.loop->arm(self, AsyncLoop::Clock::now() + self.timeout_);
+        }
+    };
+    loop->post(*this);
+}
+
+void IoAwaiter::finish(bool signalled) noexcept {
+    loop->unwatch(handle_);
+    watching_ = false;
+    AsyncLoop::Timer::cancel();
+    ready_ = signalled;
+    waiter.resume();
+}
+
+} // namespace detail
+
+} // namespace frqs::core
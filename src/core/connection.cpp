@@ -0,0 +1,224 @@
+#include "core/connection.hpp"
+#include "http/request.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <system_error>
+
+namespace frqs::core {
+
+namespace {
+    constexpr size_t READ_BUDGET = 256 * 1024;   // Per readiness event, level-triggered resumes
+}
+
+Connection::Connection(net::Socket client, net::SockAddr client_addr,
+                       Clock::time_point accepted_at, uint64_t accepted_ticks)
+    : socket(std::move(client))
+    , peer(client_addr)
+    , started_at(accepted_at)
+{
+    trace.mark(utils::trace::Phase::ACCEPTED, accepted_ticks);
+}
+
+net::Expected<bool> Connection::receive(utils::BufferPool& pool, const ConnectionConfig& config) noexcept {
+    size_t budget = READ_BUDGET;
+
+    while (budget > 0) {
+        if (in.full()) {
+            // Headers not found yet: next class up, until frame() can
+            // reject them. Request framed: exactly what it still needs;
+            // anything pipelined behind it waits in the socket.
+            size_t needed = 0;
+            if (header_size == 0) {
+                if (in.size() > config.max_header_size) {
+                    return true;
+                }
+                needed = in.size() + 1;
+            } else {
+                if (in.size() >= request_size) {
+                    return true;
+                }
+                needed = request_size;
+            }
+            if (!pool.reserve(in, needed)) {
+                return std::unexpected(std::make_error_code(std::errc::no_buffer_space));
+            }
+        }
+
+        auto received = socket.receive(std::nothrow, in.tail(), in.space());
+        if (!received) {
+            if (net::wouldBlock(received.error())) {
+                return true;
+            }
+            return std::unexpected(received.error());
+        }
+        if (*received == 0) {
+            return false;
+        }
+        in.commit(*received);
+        if (!in.full()) {
+            return true;
+        }
+        budget -= std::min(budget, *received);
+    }
+
+    return true;
+}
+
+Connection::Framing Connection::frame(const ConnectionConfig& config) {
+    if (header_size == 0) {
+        // Resume the search just before what was already scanned
+        size_t from = scanned > 3 ? scanned - 3 : 0;
+        auto end = in.view().find("\r\n\r\n", from);
+
+        if (end == std::string_view::npos) {
+            scanned = in.size();
+            return in.size() > config.max_header_size ? Framing::HEADERS_TOO_LARGE : Framing::NEED_HEADERS;
+        }
+
+        header_size = end + 4;
+        if (header_size > config.max_header_size) {
+            return Framing::HEADERS_TOO_LARGE;
+        }
+
+        // Only the framing headers are looked at here; the worker parses the rest
+        std::optional<size_t> content_length;
+        std::string_view headers(in.data(), end);
+        size_t pos = headers.find("\r\n");
+        while (pos != std::string_view::npos && pos < headers.size()) {
+            pos += 2;
+            size_t eol = headers.find("\r\n", pos);
+            auto line = headers.substr(pos, eol == std::string_view::npos ? std::string_view::npos : eol - pos);
+            pos = eol;
+
+            auto colon = line.find(':');
+            if (colon == std::string_view::npos) {
+                continue;
+            }
+            // Whitespace before the colon must be rejected (RFC 9112 5.1)
+            auto name = line.substr(0, colon);
+            if (!name.empty() && (name.back() == ' ' || name.back() == '\t')) {
+                return Framing::INVALID;
+            }
+            name = http::trim(name);
+            auto value = http::trim(line.substr(colon + 1));
+
+            if (http::equalsIgnoreCase(name, "Content-Length")) {
+                size_t length = 0;
+                auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+                if (ec != std::errc{} || ptr != value.data() + value.size()) {
+                    return Framing::INVALID;
+                }
+                // Differing lengths leave the framing ambiguous (RFC 9112 6.3)
+                if (content_length && *content_length != length) {
+                    return Framing::INVALID;
+                }
+                content_length = length;
+            } else if (http::equalsIgnoreCase(name, "Transfer-Encoding")) {
+                return Framing::UNSUPPORTED;
+            }
+        }
+
+        size_t body_size = content_length.value_or(0);
+        if (body_size > http::HTTPRequest::MAX_REQUEST_SIZE - std::min(header_size, http::HTTPRequest::MAX_REQUEST_SIZE)) {
+            return Framing::BODY_TOO_LARGE;
+        }
+        request_size = header_size + body_size;
+    }
+
+    return in.size() >= request_size ? Framing::COMPLETE : Framing::NEED_BODY;
+}
+
+net::Expected<bool> Connection::discard() noexcept {
+    std::array<char, 4096> sink;
+    size_t budget = READ_BUDGET;
+
+    while (budget > 0) {
+        auto received = socket.receive(std::nothrow, sink.data(), sink.size());
+        if (!received) {
+            if (net::wouldBlock(received.error())) {
+                return true;
+            }
+            return std::unexpected(received.error());
+        }
+        if (*received == 0) {
+            return false;
+        }
+        budget -= std::min(budget, *received);
+    }
+
+    return true;
+}
+
+void Connection::serialize(http::HTTPResponse& response, std::string_view headers) {
+    if (!keep_alive) {
+        response.setHeader("Connection", "close");
+    } else if (!http11) {
+        response.setHeader("Connection", "keep-alive");
+    }
+
+    status = response.getStatus();
+    out.clear();
+    out_tail = {};
+    out_owner.reset();
+    response.buildInto(out, headers);
+
+    // HEAD gets the GET headers, Content-Length included, without the body
+    if (method == http::Method::HEAD) {
+        out.resize(out.find("\r\n\r\n") + 4);
+    }
+}
+
+net::Expected<bool> Connection::flush() noexcept {
+    while (out_offset < outSize()) {
+        net::Expected<size_t> sent;
+        if (out_tail.empty()) {
+            sent = socket.send(std::nothrow, out.data() + out_offset, out.size() - out_offset);
+        } else {
+            // What is left of both in one call
+            size_t head = std::min(out_offset, out.size());
+            std::array<std::string_view, 2> parts = {
+                std::string_view(out).substr(head),
+                out_tail.substr(out_offset - head),
+            };
+            sent = socket.send(std::nothrow, parts);
+        }
+        if (!sent) {
+            if (net::wouldBlock(sent.error())) {
+                return false;
+            }
+            return std::unexpected(sent.error());
+        }
+        out_offset += *sent;
+    }
+    return true;
+}
+
+void Connection::advance() {
+    in.consume(request_size);
+    scanned = 0;
+    header_size = 0;
+    request_size = 0;
+
+    out.clear();
+    out_tail = {};
+    out_owner.reset();
+    out_offset = 0;
+
+    task.reset();
+    request.reset();
+    arena.reset();
+    relayed = false;
+    bytes_relayed = 0;
+
+    ++requests_served;
+    trace = {};
+    method = http::Method::UNKNOWN;
+    path.clear();
+    status = 0;
+    handler_us = 0;
+}
+
+} // namespace frqs::core
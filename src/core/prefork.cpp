@@ -0,0 +1,333 @@
+#include "core/prefork.hpp"
+
+#ifdef ERROR
+	#undef ERROR
+#endif
+
+#include "utils/logger.hpp"
+#include "utils/thread_pool.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifndef _WIN32
+    #include <csignal>
+    #include <sys/mman.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+#ifdef __linux__
+    #include <sys/prctl.h>
+#endif
+
+namespace frqs::core {
+
+// Head of the shared mapping; the counter slots follow it
+struct alignas(64) Prefork::Shared {
+    std::atomic<uint64_t> restarts{0} ;
+} ;
+
+#ifdef _WIN32
+
+Prefork::Prefork(uint16_t, PreforkConfig config)
+    : config_(std::move(config))
+    , slots_per_worker_(0)
+{
+    throw std::runtime_error("Prefork needs fork(), which Windows does not have");
+}
+
+Prefork::~Prefork() = default;
+std::optional<size_t> Prefork::run() { return std::nullopt; }
+void Prefork::attach(Server&) {}
+void Prefork::stop() noexcept {}
+uint64_t Prefork::total(utils::Metrics::Counter) const noexcept { return 0; }
+uint64_t Prefork::restarts() const noexcept { return 0; }
+void Prefork::settle(size_t) noexcept {}
+void Prefork::becomeWorker(size_t) {}
+void Prefork::shutdown() {}
+
+#else
+
+namespace {
+    std::string describeExit(int status) {
+        if (WIFSIGNALED(status)) {
+            return "was killed by signal " + std::to_string(WTERMSIG(status));
+        }
+        return "exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+}
+
+Prefork::Prefork(uint16_t port, PreforkConfig config)
+    : config_(std::move(config))
+    , slots_per_worker_(std::max<size_t>(config_.threads, 1) + 1)
+{
+    if (config_.workers == 0) {
+        config_.workers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    if (config_.reuse_port && !net::option::ReusePort::supported) {
+        utils::logWarn("SO_REUSEPORT is not available; workers will share one listener");
+        config_.reuse_port = false;
+    }
+
+    // One slot per thread of every worker, cache-line aligned like the
+    // in-process ones, behind a header
+    size_t slot_count = config_.workers * slots_per_worker_;
+    mapping_size_ = sizeof(Shared) + slot_count * sizeof(utils::Metrics::CounterSlot);
+    mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("Failed to map prefork shared memory: " +
+                                 std::error_code(errno, std::system_category()).message());
+    }
+
+    shared_ = new (mapping_) Shared();
+    auto* slots = reinterpret_cast<utils::Metrics::CounterSlot*>(static_cast<char*>(mapping_) + sizeof(Shared));
+    std::uninitialized_value_construct_n(slots, slot_count);
+    slots_ = std::span(slots, slot_count);
+
+    master_pid_ = ::getpid();
+    pids_ = std::make_unique<std::atomic<pid_t>[]>(config_.workers);
+
+    if (!config_.reuse_port) {
+        listener_.emplace();
+        config_.listener.applyListener(*listener_);
+
+        net::SockAddr bind_addr(net::IPv4(0u), port);
+        listener_->bind(bind_addr);
+        listener_->listen();
+        listener_->setNonBlocking();
+        utils::logInfo("Prefork master listening on {}", bind_addr);
+    }
+}
+
+Prefork::~Prefork() {
+    if (!worker_) {
+        for (size_t i = 0; i < config_.workers; ++i) {
+            if (pid_t pid = pids_[i].load(); pid > 0) {
+                ::kill(pid, SIGTERM);
+            }
+        }
+    }
+    if (mapping_) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+std::optional<size_t> Prefork::run() {
+    size_t count = config_.workers;
+    std::vector<std::optional<Clock::time_point>> start_at(count, Clock::time_point{});
+    std::vector<Clock::time_point> started(count);
+    std::vector<std::chrono::milliseconds> backoff(count, config_.restart_backoff);
+
+    utils::logInfo("Prefork master (pid {}) starting {} workers, {}", master_pid_, count,
+                   config_.reuse_port ? "one SO_REUSEPORT listener each" : "sharing one listener");
+
+    while (!stopping_.load()) {
+        auto now = Clock::now();
+        std::optional<Clock::time_point> next;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (!start_at[i]) {
+                continue;
+            }
+            if (*start_at[i] > now) {
+                next = next ? std::min(*next, *start_at[i]) : *start_at[i];
+                continue;
+            }
+
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                becomeWorker(i);
+                return i;
+            }
+            if (pid < 0) {
+                utils::logError("Failed to fork worker {}: {}", i, std::error_code(errno, std::system_category()).message());
+                start_at[i] = now + backoff[i];
+                next = next ? std::min(*next, *start_at[i]) : *start_at[i];
+                continue;
+            }
+
+            pids_[i].store(pid);
+            started[i] = now;
+            start_at[i].reset();
+            if (stopping_.load()) {
+                ::kill(pid, SIGTERM);   // stop() ran before the pid was visible to it
+            }
+            utils::logInfo("Worker {} started (pid {})", i, pid);
+        }
+
+        int status = 0;
+        pid_t pid = ::waitpid(-1, &status, next ? WNOHANG : 0);
+        if (pid <= 0) {
+            if (pid < 0 && errno != EINTR && errno != ECHILD) {
+                utils::logError("waitpid failed: {}", std::error_code(errno, std::system_category()).message());
+                break;
+            }
+            if (next) {
+                // A restart is pending; stay responsive to stop() meanwhile
+                std::this_thread::sleep_for(std::min<Clock::duration>(*next - Clock::now(), std::chrono::milliseconds(10)));
+            }
+            continue;
+        }
+
+        auto worker = std::find_if(pids_.get(), pids_.get() + count, [pid](const auto& p) { return p.load() == pid; });
+        if (worker == pids_.get() + count) {
+            continue;
+        }
+        size_t i = static_cast<size_t>(worker - pids_.get());
+        pids_[i].store(0);
+        settle(i);
+        if (stopping_.load()) {
+            break;
+        }
+
+        // Crash loops back off; a worker that ran a while restarts quickly
+        now = Clock::now();
+        if (now - started[i] >= std::chrono::seconds(1)) {
+            backoff[i] = config_.restart_backoff;
+        }
+        start_at[i] = now + backoff[i];
+        backoff[i] = std::min(backoff[i] * 2, config_.max_restart_backoff);
+
+        shared_->restarts.fetch_add(1, std::memory_order_relaxed);
+        utils::logWarn("Worker {} (pid {}) {}; restarting in {} ms", i, pid, describeExit(status),
+                       std::chrono::duration_cast<std::chrono::milliseconds>(*start_at[i] - now).count());
+    }
+
+    shutdown();
+    return std::nullopt;
+}
+
+void Prefork::becomeWorker(size_t worker) {
+    worker_ = worker;
+
+#ifdef __linux__
+    // Follow the master down; it may have died before this took effect
+    ::prctl(PR_SET_PDEATHSIG, SIGTERM);
+    if (::getppid() != master_pid_) {
+        ::_exit(0);
+    }
+#endif
+
+    // Threads created from here on, the pool included, inherit the mask
+    if (!config_.cpus.empty()) {
+        int cpu = config_.cpus[worker % config_.cpus.size()];
+        if (!utils::ThreadPool::pinCurrentThread(cpu)) {
+            utils::logWarn("Could not pin worker {} to CPU {}", worker, cpu);
+        }
+    }
+}
+
+void Prefork::attach(Server& server) {
+    if (!worker_) {
+        throw std::runtime_error("Prefork::attach called outside a worker");
+    }
+
+    auto profile = config_.listener;
+    if (listener_) {
+        server.setListener(std::move(*listener_));
+        listener_.reset();
+    } else {
+        profile.reuse_port = true;
+    }
+    server.setSocketProfile(profile);
+
+    if (auto* metrics = server.getMetrics()) {
+        metrics->share(slots_, *worker_ * slots_per_worker_);
+        metrics->addCounter("zhttp_prefork_restarts_total", "Worker processes restarted after dying", [shared = shared_] {
+            return static_cast<double>(shared->restarts.load(std::memory_order_relaxed));
+        });
+        metrics->addGauge("zhttp_prefork_worker", "Index of the worker process that answered", [worker = *worker_] {
+            return static_cast<double>(worker);
+        });
+    }
+}
+
+void Prefork::stop() noexcept {
+    if (::getpid() != master_pid_) {
+        ::_exit(0);
+    }
+
+    stopping_.store(true);
+    for (size_t i = 0; i < config_.workers; ++i) {
+        if (pid_t pid = pids_[i].load(); pid > 0) {
+            ::kill(pid, SIGTERM);
+        }
+    }
+}
+
+uint64_t Prefork::total(utils::Metrics::Counter counter) const noexcept {
+    uint64_t sum = 0;
+    for (const auto& slot : slots_) {
+        sum += slot.counters[counter].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+uint64_t Prefork::restarts() const noexcept {
+    return shared_->restarts.load(std::memory_order_relaxed);
+}
+
+void Prefork::settle(size_t worker) noexcept {
+    // The worker is gone, so the master is now the only writer of its slots
+    for (auto& slot : slots_.subspan(worker * slots_per_worker_, slots_per_worker_)) {
+        auto opened = slot.counters[utils::Metrics::CONNECTIONS_OPENED].load(std::memory_order_relaxed);
+        auto closed = slot.counters[utils::Metrics::CONNECTIONS_CLOSED].load(std::memory_order_relaxed);
+        slot.counters[utils::Metrics::CONNECTIONS_CLOSED].store(std::max(opened, closed), std::memory_order_relaxed);
+    }
+}
+
+void Prefork::shutdown() {
+    size_t count = config_.workers;
+    stop();
+
+    auto alive = [this, count] {
+        return std::any_of(pids_.get(), pids_.get() + count, [](const auto& p) { return p.load() > 0; });
+    };
+    auto reap = [this, count](pid_t pid) {
+        for (size_t i = 0; i < count; ++i) {
+            if (pids_[i].load() == pid) {
+                pids_[i].store(0);
+                settle(i);
+            }
+        }
+    };
+
+    auto deadline = Clock::now() + config_.shutdown_timeout;
+    while (alive()) {
+        int status = 0;
+        pid_t pid = ::waitpid(-1, &status, WNOHANG);
+        if (pid > 0) {
+            reap(pid);
+            continue;
+        }
+        if (pid < 0 && errno == ECHILD) {
+            break;
+        }
+
+        if (Clock::now() >= deadline) {
+            utils::logWarn("Workers still running after {} ms; killing them", config_.shutdown_timeout.count());
+            for (size_t i = 0; i < count; ++i) {
+                if (pid_t straggler = pids_[i].load(); straggler > 0) {
+                    ::kill(straggler, SIGKILL);
+                    ::waitpid(straggler, &status, 0);
+                    reap(straggler);
+                }
+            }
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    utils::logInfo("Prefork master stopped; {} worker restarts", restarts());
+}
+
+#endif
+
+} // namespace frqs::core
@@ -0,0 +1,173 @@
+#include "core/rate_limiter.hpp"
+#include "http/response.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <limits>
+
+namespace frqs::core {
+
+namespace {
+    constexpr size_t PROBE_WINDOW = 8;              // Slots a client may occupy, two cache lines
+    constexpr uint64_t ONE_TOKEN = 256;
+    constexpr uint64_t TOKEN_BITS = 24;
+    constexpr uint64_t TOKEN_MASK = (uint64_t{1} << TOKEN_BITS) - 1;
+    constexpr uint64_t MAX_STAMP = (uint64_t{1} << (64 - TOKEN_BITS)) - 1;
+
+    constexpr uint64_t pack(uint64_t stamp_ms, uint64_t tokens) noexcept {
+        return (stamp_ms << TOKEN_BITS) | tokens;
+    }
+    constexpr uint64_t stampOf(uint64_t bucket) noexcept { return bucket >> TOKEN_BITS; }
+    constexpr uint64_t tokensOf(uint64_t bucket) noexcept { return bucket & TOKEN_MASK; }
+
+    // 0 marks an empty slot; 0.0.0.0 never connects, so it can share with 0.0.0.1
+    constexpr uint32_t keyFor(uint32_t client) noexcept { return client != 0 ? client : 1; }
+
+    // Fibonacci hashing; neighbouring addresses land far apart
+    constexpr size_t homeSlot(uint32_t key) noexcept {
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+}
+
+RateLimiter::RateLimiter(RateLimitConfig config)
+    : config_(config)
+    , epoch_(Clock::now())
+{
+    limited_response_ = http::HTTPResponse()
+        .setStatus(429)
+        .setHeader("Retry-After", std::format("{}", config_.retry_after.count()))
+        .setHeader("Connection", "close")
+        .setContentType("text/html")
+        .setBody("<h1>429 - Too Many Requests</h1>")
+        .build();
+
+    if (!(config_.rate > 0)) {
+        return;
+    }
+
+    constexpr uint64_t MAX_BURST = TOKEN_MASK / ONE_TOKEN;
+    uint64_t burst = config_.burst != 0 ? config_.burst : static_cast<uint64_t>(std::ceil(config_.rate));
+    burst = std::clamp<uint64_t>(burst, 1, MAX_BURST);
+
+    refill_per_s_ = std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(
+        std::min(config_.rate, static_cast<double>(MAX_BURST)) * ONE_TOKEN)));
+    capacity_ = burst * ONE_TOKEN;
+    fill_ms_ = (capacity_ * 1000 + refill_per_s_ - 1) / refill_per_s_;
+
+    size_t slots = std::bit_ceil(std::max(config_.max_clients, PROBE_WINDOW));
+    mask_ = slots - 1;
+    table_ = std::make_unique<Entry[]>(slots);
+    overflow_.bucket.store(pack(0, capacity_), std::memory_order_relaxed);
+}
+
+RateLimiter::~RateLimiter() = default;
+
+uint64_t RateLimiter::stamp(Clock::time_point now) const noexcept {
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch_).count();
+    return std::clamp<uint64_t>(ms > 0 ? static_cast<uint64_t>(ms) : 0, 0, MAX_STAMP);
+}
+
+uint64_t RateLimiter::refill(uint64_t bucket, uint64_t now_ms) const noexcept {
+    uint64_t last = stampOf(bucket);
+    uint64_t tokens = tokensOf(bucket);
+    if (now_ms <= last || tokens >= capacity_) {
+        return pack(std::max(last, now_ms), tokens);
+    }
+
+    // Capped at the fill time so the product cannot overflow
+    uint64_t elapsed = std::min(now_ms - last, fill_ms_);
+    uint64_t added = elapsed * refill_per_s_ / 1000;
+
+    // Less than 1/256 token so far: keep the old stamp so slow rates still accrue
+    if (added == 0) {
+        return bucket;
+    }
+    return pack(now_ms, std::min(capacity_, tokens + added));
+}
+
+bool RateLimiter::take(Entry& entry, uint64_t now_ms) noexcept {
+    uint64_t current = entry.bucket.load(std::memory_order_relaxed);
+    for (;;) {
+        uint64_t refilled = refill(current, now_ms);
+        if (tokensOf(refilled) < ONE_TOKEN) {
+            return false;
+        }
+        if (entry.bucket.compare_exchange_weak(current, refilled - ONE_TOKEN, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void RateLimiter::reset(Entry& entry, uint32_t key, uint64_t now_ms) noexcept {
+    // A new client starts with a full bucket, less this request
+    entry.key.store(key, std::memory_order_relaxed);
+    entry.bucket.store(pack(now_ms, capacity_ - ONE_TOKEN), std::memory_order_relaxed);
+}
+
+bool RateLimiter::allow(uint32_t client, Clock::time_point now) noexcept {
+    if (!enabled()) {
+        return true;
+    }
+
+    uint32_t key = keyFor(client);
+    uint64_t now_ms = stamp(now);
+    size_t home = homeSlot(key);
+
+    Entry* coldest = nullptr;
+    uint64_t coldest_stamp = std::numeric_limits<uint64_t>::max();
+
+    for (size_t i = 0; i < PROBE_WINDOW; ++i) {
+        Entry& entry = table_[(home + i) & mask_];
+        uint32_t owner = entry.key.load(std::memory_order_relaxed);
+
+        if (owner == 0) {
+            if (entry.key.compare_exchange_strong(owner, key, std::memory_order_relaxed)) {
+                reset(entry, key, now_ms);
+                return true;
+            }
+            // Someone else got the slot first; it may have been this client
+        }
+        if (owner == key) {
+            return take(entry, now_ms);
+        }
+
+        uint64_t last = stampOf(entry.bucket.load(std::memory_order_relaxed));
+        if (last < coldest_stamp) {
+            coldest = &entry;
+            coldest_stamp = last;
+        }
+    }
+
+    // Window full: the client refilled longest ago gives up its slot, but
+    // only once its bucket has sat idle for the whole fill time, when it was
+    // full anyway and nothing is lost. Otherwise every client without a slot
+    // draws from one shared bucket, so rotating addresses buys nothing.
+    if (now_ms - std::min(now_ms, coldest_stamp) >= fill_ms_) {
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+        reset(*coldest, key, now_ms);
+        return true;
+    }
+    overflows_.fetch_add(1, std::memory_order_relaxed);
+    return take(overflow_, now_ms);
+}
+
+bool RateLimiter::exhausted(uint32_t client, Clock::time_point now) const noexcept {
+    if (!enabled()) {
+        return false;
+    }
+
+    uint32_t key = keyFor(client);
+    size_t home = homeSlot(key);
+
+    for (size_t i = 0; i < PROBE_WINDOW; ++i) {
+        const Entry& entry = table_[(home + i) & mask_];
+        if (entry.key.load(std::memory_order_relaxed) == key) {
+            uint64_t bucket = refill(entry.bucket.load(std::memory_order_relaxed), stamp(now));
+            return tokensOf(bucket) < ONE_TOKEN;
+        }
+    }
+    return false;
+}
+
+} // namespace frqs::core
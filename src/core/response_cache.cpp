@@ -0,0 +1,274 @@
+#include "core/response_cache.hpp"
+#include "http/request.hpp"
+#include <algorithm>
+#include <charconv>
+#include <functional>
+
+namespace frqs::core {
+
+namespace {
+    constexpr size_t ITEM_OVERHEAD = 128;   // List node, index slot, Entry
+
+    // Calls on_item(item) for each element of a comma-separated list
+    template <typename F>
+    void forEachItem(std::string_view list, F&& on_item) {
+        while (!list.empty()) {
+            size_t comma = list.find(',');
+            auto item = http::trim(list.substr(0, comma));
+            list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+            if (!item.empty()) {
+                on_item(item);
+            }
+        }
+    }
+
+    std::optional<uint32_t> seconds(std::string_view value) noexcept {
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+        uint32_t out = 0;
+        auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+        if (ec != std::errc{} || ptr != value.data() + value.size()) {
+            return std::nullopt;
+        }
+        return out;
+    }
+
+    // Heuristically cacheable statuses (RFC 9111); here they still need
+    // max-age or default_ttl
+    bool cacheableStatus(uint16_t status) noexcept {
+        switch (status) {
+            case 200: case 203: case 204: case 300: case 301:
+            case 308: case 404: case 405: case 410: case 414:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    struct Freshness {
+        std::chrono::seconds ttl{0};
+        std::chrono::seconds stale{0};
+    };
+
+    std::optional<Freshness> freshness(const http::HTTPResponse& response, const ResponseCacheConfig& config) {
+        if (!cacheableStatus(response.getStatus()) || response.getHeader("Set-Cookie")) {
+            return std::nullopt;
+        }
+
+        // Vary on anything the key does not cover would serve one client's
+        // variant to another
+        if (auto vary = response.getHeader("Vary")) {
+            bool covered = true;
+            forEachItem(*vary, [&](std::string_view name) {
+                covered = covered && std::ranges::any_of(config.vary, [name](const std::string& configured) {
+                    return http::equalsIgnoreCase(configured, name);
+                });
+            });
+            if (!covered) {
+                return std::nullopt;
+            }
+        }
+
+        Freshness result{config.default_ttl, config.stale_ttl};
+        std::optional<uint32_t> max_age;
+        std::optional<uint32_t> s_maxage;
+        bool forbidden = false;
+
+        if (auto cache_control = response.getHeader("Cache-Control")) {
+            forEachItem(*cache_control, [&](std::string_view directive) {
+                size_t eq = directive.find('=');
+                auto name = http::trim(directive.substr(0, eq));
+                auto value = eq == std::string_view::npos ? std::string_view{} : http::trim(directive.substr(eq + 1));
+
+                if (http::equalsIgnoreCase(name, "no-store") || http::equalsIgnoreCase(name, "no-cache")
+                    || http::equalsIgnoreCase(name, "private")) {
+                    forbidden = true;
+                } else if (http::equalsIgnoreCase(name, "max-age")) {
+                    max_age = seconds(value);
+                } else if (http::equalsIgnoreCase(name, "s-maxage")) {
+                    s_maxage = seconds(value);
+                } else if (http::equalsIgnoreCase(name, "stale-while-revalidate")) {
+                    if (auto stale = seconds(value)) {
+                        result.stale = std::chrono::seconds(*stale);
+                    }
+                }
+            });
+        }
+
+        if (forbidden) {
+            return std::nullopt;
+        }
+        if (s_maxage) {
+            result.ttl = std::chrono::seconds(*s_maxage);
+        } else if (max_age) {
+            result.ttl = std::chrono::seconds(*max_age);
+        }
+        if (result.ttl.count() <= 0) {
+            return std::nullopt;
+        }
+        return result;
+    }
+}
+
+ResponseCache::ResponseCache(ResponseCacheConfig config)
+    : config_(std::move(config))
+    , shard_budget_(std::max<size_t>(config_.max_bytes / SHARDS, 1))
+{
+    config_.max_entry_bytes = std::min(config_.max_entry_bytes, shard_budget_);
+}
+
+bool ResponseCache::accepts(const http::HTTPRequest& request) const noexcept {
+    auto method = request.getMethod();
+    return (method == http::Method::GET || method == http::Method::HEAD)
+        && !request.getHeader("Authorization");
+}
+
+std::string ResponseCache::key(const http::HTTPRequest& request) const {
+    auto path = request.getPath();
+    auto query = request.getQueryString();
+
+    std::string key;
+    key.reserve(path.size() + query.size() + 16);
+    key.append(http::methodToString(request.getMethod())).append(" ").append(path);
+
+    // a=1&b=2 and b=2&a=1 are the same resource; repeated names keep
+    // their relative order
+    std::vector<std::string_view> params;
+    while (!query.empty()) {
+        size_t amp = query.find('&');
+        auto param = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view{} : query.substr(amp + 1);
+        if (!param.empty()) {
+            params.push_back(param);
+        }
+    }
+    std::ranges::stable_sort(params, {}, [](std::string_view param) {
+        return param.substr(0, param.find('='));
+    });
+
+    char separator = '?';
+    for (auto param : params) {
+        key.push_back(separator);
+        key.append(param);
+        separator = '&';
+    }
+
+    for (const auto& name : config_.vary) {
+        key.push_back('\n');
+        key.append(request.getHeader(name).value_or(""));
+    }
+    return key;
+}
+
+ResponseCache::Shard& ResponseCache::shardFor(std::string_view key) noexcept {
+    return shards_[std::hash<std::string_view>{}(key) % SHARDS];
+}
+
+void ResponseCache::erase(Shard& shard, std::list<Item>::iterator item) noexcept {
+    shard.bytes -= item->bytes;
+    bytes_.fetch_sub(item->bytes, std::memory_order_relaxed);
+    entries_.fetch_sub(1, std::memory_order_relaxed);
+    shard.index.erase(item->key);
+    shard.lru.erase(item);
+}
+
+std::optional<ResponseCache::Hit> ResponseCache::find(std::string_view key, Clock::time_point now) {
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto item = it->second;
+    const auto& entry = *item->entry;
+    if (now >= entry.stale_until) {
+        erase(shard, item);
+        expired_.fetch_add(1, std::memory_order_relaxed);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, item);
+
+    Hit hit{item->entry};
+    if (now >= entry.fresh_until) {
+        hit.stale = true;
+        hit.refresh = !item->refreshing;
+        item->refreshing = true;
+        stale_hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return hit;
+}
+
+std::shared_ptr<const ResponseCache::Entry> ResponseCache::store(std::string key, const http::HTTPResponse& response,
+                                                                  Clock::time_point now) {
+    auto policy = freshness(response, config_);
+    size_t bytes = 0;
+    std::shared_ptr<Entry> entry;
+
+    if (policy) {
+        entry = std::make_shared<Entry>();
+        entry->wire = response.build();
+        entry->head_size = entry->wire.find("\r\n\r\n") + 4;
+        entry->status = response.getStatus();
+        entry->fresh_until = now + policy->ttl;
+        entry->stale_until = entry->fresh_until + policy->stale;
+        bytes = entry->wire.size() + key.size() + ITEM_OVERHEAD;
+    }
+    if (entry && bytes > config_.max_entry_bytes) {
+        entry.reset();
+    }
+
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    // A fresh answer, cacheable or not, replaces what was there
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        erase(shard, it->second);
+    }
+    if (!entry) {
+        return nullptr;
+    }
+
+    while (shard.bytes + bytes > shard_budget_ && !shard.lru.empty()) {
+        erase(shard, std::prev(shard.lru.end()));
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(Item{std::move(key), entry, bytes, false});
+    shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+    shard.bytes += bytes;
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    entries_.fetch_add(1, std::memory_order_relaxed);
+    stores_.fetch_add(1, std::memory_order_relaxed);
+    return entry;
+}
+
+void ResponseCache::abandon(std::string_view key) {
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    // The stale entry stays; the next stale hit hands out a new refresh
+    if (auto it = shard.index.find(key); it != shard.index.end()) {
+        it->second->refreshing = false;
+    }
+}
+
+ResponseCache::Stats ResponseCache::stats() const noexcept {
+    return Stats{
+        hits_.load(std::memory_order_relaxed),
+        stale_hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed),
+        stores_.load(std::memory_order_relaxed),
+        evictions_.load(std::memory_order_relaxed),
+        expired_.load(std::memory_order_relaxed)
+    };
+}
+
+} // namespace frqs::core
@@ -0,0 +1,353 @@
+#include "core/reverse_proxy.hpp"
+#include "core/async.hpp"
+#include "http/proxy.hpp"
+
+#ifdef ERROR
+	#undef ERROR
+#endif
+
+#include "utils/logger.hpp"
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace frqs::core {
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Body = http::UpstreamResponse::Body;
+
+    constexpr size_t READ_SIZE = 16 * 1024;          // Relay buffer, the most a response holds in memory
+    constexpr size_t MAX_RESPONSE_HEAD = 64 * 1024;
+
+    enum class Outcome : uint8_t {
+        OK,
+        FAILED,
+        TIMEOUT
+    };
+
+    struct Received {
+        Outcome outcome = Outcome::OK;
+        size_t bytes = 0;   // 0 with OK means the peer closed
+    };
+
+    // readable()/writable() as an Outcome: a socket the poller refuses is
+    // a broken connection, not a slow one
+    Task<Outcome> waitFor(const net::Socket& socket, uint32_t interest, Clock::duration timeout) {
+        try {
+            auto wait = interest == net::Poller::READABLE ? readable(socket, timeout) : writable(socket, timeout);
+            bool ready = co_await wait;
+            co_return ready ? Outcome::OK : Outcome::TIMEOUT;
+        } catch (const std::exception&) {
+            co_return Outcome::FAILED;
+        }
+    }
+
+    Task<Outcome> connectTo(net::Socket& socket, const net::SockAddr& address, Clock::duration timeout) {
+        if (!socket.setNonBlocking(std::nothrow)) {
+            co_return Outcome::FAILED;
+        }
+        auto connected = socket.connect(std::nothrow, address);
+        if (!connected) {
+            co_return Outcome::FAILED;
+        }
+        if (*connected) {
+            co_return Outcome::OK;
+        }
+
+        if (Outcome waited = co_await waitFor(socket, net::Poller::WRITABLE, timeout); waited != Outcome::OK) {
+            co_return waited;
+        }
+
+        co_return socket.finishConnect(std::nothrow) ? Outcome::OK : Outcome::FAILED;
+    }
+
+    // more: the next sendAll follows at once, so a partial last segment
+    // can wait for it
+    Task<Outcome> sendAll(net::Socket& socket, std::string_view data, Clock::duration timeout, bool more = false) {
+        while (!data.empty()) {
+            auto sent = socket.send(std::nothrow, data, more);
+            if (!sent) {
+                if (!net::wouldBlock(sent.error())) {
+                    co_return Outcome::FAILED;
+                }
+                if (Outcome waited = co_await waitFor(socket, net::Poller::WRITABLE, timeout); waited != Outcome::OK) {
+                    co_return waited;
+                }
+                continue;
+            }
+            data.remove_prefix(*sent);
+        }
+        co_return Outcome::OK;
+    }
+
+    // Appends what the socket has, up to READ_SIZE bytes
+    Task<Received> receiveSome(net::Socket& socket, std::string& buffer, Clock::duration timeout) {
+        size_t old_size = buffer.size();
+        buffer.resize(old_size + READ_SIZE);
+
+        for (;;) {
+            auto received = socket.receive(std::nothrow, buffer.data() + old_size, READ_SIZE);
+            if (received) {
+                buffer.resize(old_size + *received);
+                co_return Received{Outcome::OK, *received};
+            }
+            if (!net::wouldBlock(received.error())) {
+                buffer.resize(old_size);
+                co_return Received{Outcome::FAILED, 0};
+            }
+            if (Outcome waited = co_await waitFor(socket, net::Poller::READABLE, timeout); waited != Outcome::OK) {
+                buffer.resize(old_size);
+                co_return Received{waited, 0};
+            }
+        }
+    }
+
+    // Sends the request and reads until a final (non-1xx) response head
+    // is in buffer. Connects first when the lease has no pooled socket.
+    Task<Outcome> exchange(Upstream::Lease& lease, const UpstreamConfig& config,
+                           std::string_view head, std::string_view body, bool head_request,
+                           std::string& buffer, std::optional<http::UpstreamResponse>& response) {
+        if (!lease.socket) {
+            lease.socket.emplace();
+            Outcome connected = co_await connectTo(*lease.socket, config.backends[lease.backend], config.connect_timeout);
+            if (connected != Outcome::OK) {
+                co_return connected;
+            }
+        }
+
+        auto& socket = *lease.socket;
+        Outcome sent = co_await sendAll(socket, head, config.response_timeout, !body.empty());
+        if (sent == Outcome::OK) {
+            sent = co_await sendAll(socket, body, config.response_timeout);
+        }
+        if (sent != Outcome::OK) {
+            co_return sent;
+        }
+
+        for (;;) {
+            auto [outcome, bytes] = co_await receiveSome(socket, buffer, config.response_timeout);
+            if (outcome != Outcome::OK) {
+                co_return outcome;
+            }
+            if (bytes == 0) {
+                co_return Outcome::FAILED;   // Closed before a complete head
+            }
+
+            try {
+                response = http::UpstreamResponse::parse(buffer, head_request);
+            } catch (const std::exception&) {
+                co_return Outcome::FAILED;
+            }
+
+            if (response && response->status < 200) {
+                // 100 Continue, 103 Early Hints: interim, wait for the real one
+                buffer.erase(0, response->head_size);
+                response.reset();
+            }
+            if (response) {
+                co_return Outcome::OK;
+            }
+            if (buffer.size() > MAX_RESPONSE_HEAD) {
+                co_return Outcome::FAILED;
+            }
+        }
+    }
+
+    http::HTTPResponse gatewayError(uint16_t status, std::string_view message) {
+        std::pmr::string body;
+        std::format_to(std::back_inserter(body), "<h1>{} - {}</h1>", status, message);
+        return http::HTTPResponse()
+            .setStatus(status)
+            .setBody(std::move(body))
+            .setContentType("text/html");
+    }
+}
+
+ReverseProxy::ReverseProxy(std::shared_ptr<Upstream> upstream, net::Poller& poller, const ConnectionConfig& connection_config)
+    : upstream_(std::move(upstream))
+    , poller_(poller)
+    , connection_config_(connection_config)
+{}
+
+Task<http::HTTPResponse> ReverseProxy::relay(Connection& conn) const {
+    // The rest runs on the event loop, which owns the client socket
+    co_await resumeOnLoop();
+
+    const auto& config = upstream_->config();
+    auto write_timeout = connection_config_.write_timeout;
+    bool head_request = conn.method == http::Method::HEAD;
+
+    std::string_view request_body(conn.in.data() + conn.header_size, conn.request_size - conn.header_size);
+    auto request_head = http::forwardRequestHead(std::string_view(conn.in.data(), conn.header_size),
+                                                 request_body.size(), conn.peer.getAddress().toString());
+
+    auto lease = upstream_->acquire(Clock::now());
+    if (!lease) {
+        co_return gatewayError(503, "No Upstream Available");
+    }
+
+    // A pooled connection the backend has just closed fails before any
+    // response byte arrives; that gets one retry on a fresh connection.
+    // A timeout does not: the backend may still be working on it. Nor does
+    // a non-idempotent request with a body, which the backend may have
+    // acted on before the connection dropped.
+    bool retryable = http::isIdempotent(conn.method) || request_body.empty();
+    std::string buffer;
+    std::optional<http::UpstreamResponse> response;
+    Outcome outcome;
+    for (;;) {
+        bool reused = lease->reused;
+        outcome = co_await exchange(*lease, config, request_head, request_body, head_request, buffer, response);
+        if (outcome != Outcome::FAILED || !reused || !retryable || !buffer.empty()) {
+            break;
+        }
+        lease->socket.reset();
+        lease->reused = false;
+    }
+
+    if (outcome != Outcome::OK) {
+        utils::logWarn("Upstream {} failed for {} {}", config.backends[lease->backend],
+                       http::methodToString(conn.method), conn.path);
+        upstream_->release(*lease, false, false, Clock::now());
+        co_return outcome == Outcome::TIMEOUT
+            ? gatewayError(504, "Gateway Timeout")
+            : gatewayError(502, "Bad Gateway");
+    }
+
+    // Client hung up while the backend worked; nothing to relay to
+    if (conn.hung_up) {
+        upstream_->release(*lease, true, false, Clock::now());
+        co_return gatewayError(502, "Bad Gateway");
+    }
+
+    // Chunked bodies pass through untouched unless the client speaks
+    // HTTP/1.0; without a length the end of the body is the close
+    Body body = response->body;
+    bool dechunk = body == Body::CHUNKED && !conn.http11;
+    if (body == Body::UNTIL_CLOSE || dechunk) {
+        conn.keep_alive = false;
+    }
+
+    std::string head = std::move(response->head);
+    head[7] = '1';   // We answer as HTTP/1.1 whatever the backend spoke
+    // Transfer-Encoding is hop-by-hop, so it is left out of the head and
+    // put back as the backend sent it: codings other than chunked (gzip,
+    // ...) must reach the client too. Decoding removes only the final chunked.
+    std::string_view codings = body == Body::NONE ? std::string_view{} : response->transfer_encoding;
+    if (dechunk) {
+        size_t comma = codings.rfind(',');
+        codings = comma == std::string_view::npos ? std::string_view{} : codings.substr(0, comma);
+    }
+    if (!codings.empty()) {
+        head += "\r\nTransfer-Encoding: ";
+        head += codings;
+    }
+    if (!conn.keep_alive) {
+        head += "\r\nConnection: close";
+    } else if (!conn.http11) {
+        head += "\r\nConnection: keep-alive";
+    }
+    head += "\r\n\r\n";
+
+    conn.status = response->status;
+    conn.relayed = true;
+    poller_.remove(conn.socket.native_handle());
+
+    uint64_t remaining = response->content_length;
+    bool complete = body == Body::NONE || (body == Body::LENGTH && remaining == 0);
+
+    // Body bytes that came with the head are sent right behind it (a
+    // chunked body may not yield any until more arrives)
+    bool body_buffered = !complete && body != Body::CHUNKED && response->head_size < buffer.size();
+    bool client_ok = co_await sendAll(conn.socket, head, write_timeout, body_buffered) == Outcome::OK;
+    conn.bytes_relayed += head.size();
+    bool upstream_ok = true;
+    size_t offset = response->head_size;
+    http::ChunkedDecoder decoder;
+
+    while (client_ok && !complete) {
+        if (offset == buffer.size()) {
+            buffer.clear();
+            offset = 0;
+            auto [received, bytes] = co_await receiveSome(*lease->socket, buffer, config.response_timeout);
+            if (received != Outcome::OK || bytes == 0) {
+                // A close ends an UNTIL_CLOSE body and truncates any other
+                complete = received == Outcome::OK && body == Body::UNTIL_CLOSE;
+                upstream_ok = complete;
+                break;
+            }
+        }
+
+        std::string_view data(buffer.data() + offset, buffer.size() - offset);
+        std::string_view out;
+        size_t consumed = 0;
+
+        switch (body) {
+            case Body::LENGTH:
+                consumed = static_cast<size_t>(std::min<uint64_t>(remaining, data.size()));
+                out = data.substr(0, consumed);
+                remaining -= consumed;
+                complete = remaining == 0;
+                break;
+
+            case Body::CHUNKED: {
+                http::ChunkedDecoder::Step step;
+                try {
+                    step = decoder.next(data);
+                } catch (const std::exception&) {
+                    upstream_ok = false;
+                    break;
+                }
+                consumed = step.consumed;
+                out = dechunk ? step.payload : data.substr(0, consumed);
+                complete = decoder.done();
+                break;
+            }
+
+            case Body::UNTIL_CLOSE:
+            case Body::NONE:
+                consumed = data.size();
+                out = data;
+                break;
+        }
+
+        if (!upstream_ok) {
+            break;
+        }
+        offset += consumed;
+
+        if (!out.empty()) {
+            client_ok = co_await sendAll(conn.socket, out, write_timeout) == Outcome::OK;
+            conn.bytes_relayed += out.size();
+        }
+    }
+
+    bool reusable = complete && response->reusable && offset == buffer.size();
+    upstream_->release(*lease, upstream_ok, reusable, Clock::now());
+
+    // A truncated body is only visible to the client as a close
+    if (!complete) {
+        conn.keep_alive = false;
+    }
+
+    // Back to the event loop for the next request, or closed by it
+    if (!client_ok) {
+        conn.hung_up = true;
+    } else {
+        try {
+            poller_.add(conn.socket.native_handle(), conn.interest, &conn);
+        } catch (const std::exception& e) {
+            utils::logError("Poller update failed for {}: {}", conn.peer, e.what());
+            conn.hung_up = true;
+        }
+    }
+
+    co_return http::HTTPResponse();
+}
+
+} // namespace frqs::core
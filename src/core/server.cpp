@@ -7,6 +7,8 @@
 
 #include "utils/logger.hpp"
 #include "utils/filesystem_utils.hpp"
+#include <algorithm>
+#include <array>
 #include <format>
 #include <thread>
 
@@ -16,28 +18,220 @@ Server::Server(uint16_t port, size_t thread_count)
     : port_(port)
     , document_root_(std::filesystem::current_path() / "public")
     , thread_pool_(std::make_unique<utils::ThreadPool>(thread_count))
+    , admission_(std::make_unique<AdmissionControl>())
+    , rate_limiter_(std::make_unique<RateLimiter>())
+    , fair_queue_(std::make_unique<utils::FairQueue<Connection*>>())
+    , poller_(std::make_unique<net::Poller>())
+    , async_(std::make_unique<AsyncLoop>(*poller_, *thread_pool_, [this](void* conn) {
+          finishAsync(*static_cast<Connection*>(conn));
+      }))
 {
-    utils::logInfo(std::format("Server initialized on port {} with {} threads", 
-                                port_, thread_count));
+    utils::logInfo("Server initialized on port {} with {} threads", 
+                   port_, thread_count);
 }
 
 Server::~Server() {
     stop();
+    
+    // Join workers before the connections and sinks they write to go away
+    thread_pool_.reset();
 }
 
 void Server::setDocumentRoot(const std::filesystem::path& root) {
     document_root_ = root;
-    utils::logInfo(std::format("Document root set to: {}", root.string()));
+    utils::logInfo("Document root set to: {}", root);
 }
 
 void Server::setDefaultFile(std::string filename) {
     default_file_ = std::move(filename);
 }
 
+void Server::setServerHeader(std::string_view name) {
+    date_header_.setServer(name);
+}
+
 void Server::setRequestHandler(RequestHandler handler) {
     custom_handler_ = std::move(handler);
 }
 
+void Server::route(http::Method method, std::string_view pattern, RequestHandler handler) {
+    router_.add(method, pattern, std::move(handler));
+}
+
+void Server::route(http::Method method, std::string_view pattern, http::CannedResponse response) {
+    size_t index = router_.add(method, pattern, {});
+    canned_routes_.resize(index + 1);
+    canned_routes_[index] = std::make_unique<const http::CannedResponse>(std::move(response));
+}
+
+void Server::routeAsync(http::Method method, std::string_view pattern, AsyncHandler handler) {
+    size_t index = router_.add(method, pattern, {});
+    async_routes_.resize(index + 1);
+    async_routes_[index] = std::move(handler);
+}
+
+void Server::proxy(std::string_view pattern, std::shared_ptr<Upstream> upstream) {
+    auto relay = std::make_shared<const ReverseProxy>(std::move(upstream), *poller_, connection_config_);
+    
+    std::array<http::Method, static_cast<size_t>(http::Method::UNKNOWN)> methods;
+    for (size_t i = 0; i < methods.size(); ++i) {
+        methods[i] = static_cast<http::Method>(i);
+    }
+
+    // One route for every method: a conflict registers nothing and the
+    // pattern gets a single metrics label
+    size_t index = router_.add(methods, pattern, {});
+    proxy_routes_.resize(index + 1);
+    proxy_routes_[index] = std::move(relay);
+}
+
+void Server::enableAccessLog(utils::AccessLogConfig config) {
+    auto directory = config.directory;
+    
+    // Records are written by the event loop once the response is sent
+    access_log_ = std::make_unique<utils::AccessLog>(std::move(config), 1);
+    utils::logInfo("Access log enabled in: {}", directory);
+}
+
+void Server::setConnectionConfig(ConnectionConfig config) {
+    connection_config_ = config;
+    buffers_.setLimit(config.max_buffer_memory);
+}
+
+void Server::setSocketProfile(net::SocketProfile profile) {
+    socket_profile_ = profile;
+}
+
+void Server::setListener(net::Socket listener) {
+    inherited_listener_ = std::move(listener);
+}
+
+void Server::enableBusyPolling(BusyPollConfig config) {
+    size_t spinning = thread_pool_->size() + 1;
+    if (std::thread::hardware_concurrency() < spinning) {
+        utils::logWarn("Busy polling {} threads on {} CPUs; they will take turns instead of spinning",
+                       spinning, std::thread::hardware_concurrency());
+    }
+    
+    thread_pool_->setSpin(config.idle_timeout);
+    if (config.cpus.size() > 1) {
+        if (!thread_pool_->pin(std::span(config.cpus).subspan(1))) {
+            utils::logWarn("Could not pin every worker thread");
+        }
+    }
+    busy_poll_ = std::move(config);
+}
+
+void Server::setAdmissionConfig(AdmissionConfig config) {
+    utils::FairQueue<Connection*>::Config fair_config;
+    fair_config.max_flow_items = config.max_queued_per_client;
+    
+    admission_ = std::make_unique<AdmissionControl>(config);
+    fair_queue_ = std::make_unique<utils::FairQueue<Connection*>>(fair_config);
+}
+
+void Server::setRateLimit(RateLimitConfig config) {
+    rate_limiter_ = std::make_unique<RateLimiter>(config);
+}
+
+void Server::setAccessList(std::shared_ptr<const net::AccessList> list) {
+    if (list) {
+        utils::logInfo("Access list loaded: {} rules, {} KB", list->size(), list->memoryUsage() / 1024);
+    }
+    access_list_.store(std::move(list), std::memory_order_release);
+}
+
+void Server::enableMetrics(std::string path) {
+    // One slot per worker plus one for the accept thread
+    metrics_ = std::make_unique<utils::Metrics>(thread_pool_->size() + 1);
+    metrics_path_ = std::move(path);
+    
+    static_route_ = metrics_->registerRoute("static");
+    handler_route_ = metrics_->registerRoute("handler");
+    metrics_route_ = metrics_->registerRoute("metrics");
+    
+    metrics_->addGauge("zhttp_queue_depth", "Tasks waiting for a worker", [this] {
+        return static_cast<double>(thread_pool_->pendingTasks());
+    });
+    metrics_->addGauge("zhttp_worker_threads", "Worker threads in the pool", [this] {
+        return static_cast<double>(thread_pool_->size());
+    });
+    metrics_->addGauge("zhttp_overloaded", "1 while queueing delay stays above the CoDel target", [this] {
+        return admission_->overloaded() ? 1.0 : 0.0;
+    });
+    metrics_->addGauge("zhttp_accept_paused", "1 while accept is paused at the connection limit", [this] {
+        return accept_paused_.load(std::memory_order_relaxed) ? 1.0 : 0.0;
+    });
+    metrics_->addCounter("zhttp_rate_limit_evictions_total", "Clients dropped from the full rate limit table", [this] {
+        return static_cast<double>(rate_limiter_->evictions());
+    });
+    metrics_->addCounter("zhttp_rate_limit_overflows_total", "Requests charged to the shared bucket while the table was full", [this] {
+        return static_cast<double>(rate_limiter_->overflows());
+    });
+    metrics_->addCounter("zhttp_access_log_dropped_total", "Access records dropped on full buffers", [this] {
+        return access_log_ ? static_cast<double>(access_log_->dropped()) : 0.0;
+    });
+    
+    // Response cache, zero until enableResponseCache
+    auto cache_counter = [this](uint64_t ResponseCache::Stats::* field) {
+        return [this, field] {
+            return response_cache_ ? static_cast<double>(response_cache_->stats().*field) : 0.0;
+        };
+    };
+    metrics_->addCounter("zhttp_cache_hits_total", "Responses served fresh from the cache",
+                         cache_counter(&ResponseCache::Stats::hits));
+    metrics_->addCounter("zhttp_cache_stale_hits_total", "Responses served stale while revalidating",
+                         cache_counter(&ResponseCache::Stats::stale_hits));
+    metrics_->addCounter("zhttp_cache_misses_total", "Cache lookups that found nothing usable",
+                         cache_counter(&ResponseCache::Stats::misses));
+    metrics_->addCounter("zhttp_cache_stores_total", "Responses stored in the cache",
+                         cache_counter(&ResponseCache::Stats::stores));
+    metrics_->addCounter("zhttp_cache_evictions_total", "Entries evicted to stay within the memory limit",
+                         cache_counter(&ResponseCache::Stats::evictions));
+    metrics_->addCounter("zhttp_cache_expired_total", "Entries dropped past their stale window",
+                         cache_counter(&ResponseCache::Stats::expired));
+    metrics_->addGauge("zhttp_cache_bytes", "Memory held by cached responses", [this] {
+        return response_cache_ ? static_cast<double>(response_cache_->bytes()) : 0.0;
+    });
+    metrics_->addGauge("zhttp_cache_entries", "Responses in the cache", [this] {
+        return response_cache_ ? static_cast<double>(response_cache_->entries()) : 0.0;
+    });
+    metrics_->addGauge("zhttp_buffer_bytes", "Input buffer memory held by connections", [this] {
+        return static_cast<double>(buffers_.inUse());
+    });
+    metrics_->addGauge("zhttp_buffer_pooled_bytes", "Input buffer memory kept for reuse", [this] {
+        return static_cast<double>(buffers_.cached());
+    });
+    metrics_->addCounter("zhttp_buffer_exhausted_total", "Connections dropped at the input buffer limit", [this] {
+        return static_cast<double>(buffers_.exhausted());
+    });
+    metrics_->addCounter("zhttp_coalesced_total", "Requests that waited on an identical one instead of computing", [this] {
+        return static_cast<double>(flights_.coalesced());
+    });
+    
+    utils::logInfo("Metrics exposed at {}", metrics_path_);
+}
+
+void Server::enableResponseCache(ResponseCacheConfig config) {
+    response_cache_ = std::make_unique<ResponseCache>(std::move(config));
+    utils::logInfo("Response cache enabled, {} MB", response_cache_->config().max_bytes / (1024 * 1024));
+}
+
+void Server::enableTracing(utils::trace::TracerConfig config) {
+#if FRQS_ENABLE_TRACING
+    auto output = config.output;
+    tracer_ = std::make_unique<utils::trace::Tracer>(std::move(config));
+    utils::logInfo("Request tracing enabled, writing to {}", output);
+#else
+    (void)config;
+    utils::logWarn("Request tracing was compiled out (FRQS_ENABLE_TRACING=0)");
+#endif
+}
+
+size_t Server::metricsSlot() const noexcept {
+    return std::min(utils::ThreadPool::workerIndex(), thread_pool_->size());
+}
+
 void Server::start() {
     if (running_) {
         utils::logWarn("Server is already running");
@@ -45,22 +239,45 @@ void Server::start() {
     }
     
     try {
-        server_socket_ = std::make_unique<net::Socket>();
+        if (inherited_listener_) {
+            server_socket_ = std::make_unique<net::Socket>(std::move(*inherited_listener_));
+            inherited_listener_.reset();
+            server_socket_->setNonBlocking();
+            utils::logInfo("Server accepting on an inherited listener, port {}", port_);
+        } else {
+            server_socket_ = std::make_unique<net::Socket>();
+            
+            auto profile = socket_profile_;
+            if (busy_poll_) {
+                profile.busy_poll = std::max(profile.busy_poll, busy_poll_->socket_busy_poll);
+                profile.prefer_busy_poll = profile.prefer_busy_poll || busy_poll_->prefer_busy_poll;
+            }
+            profile.applyListener(*server_socket_);
+            
+            net::SockAddr bind_addr(net::IPv4(0u), port_);
+            server_socket_->bind(bind_addr);
+            server_socket_->listen();
+            server_socket_->setNonBlocking();
+            utils::logInfo("Server listening on {}", bind_addr);
+        }
         
-        net::SockAddr bind_addr(net::IPv4(0u), port_);
-        server_socket_->bind(bind_addr);
-        server_socket_->listen();
+        // The route table is final once the server starts
+        if (metrics_) {
+            for (size_t i = route_metrics_.size(); i < router_.size(); ++i) {
+                route_metrics_.push_back(metrics_->registerRoute(router_.name(i)));
+            }
+        }
         
         running_ = true;
         
-        utils::logInfo(std::format("Server listening on {}", bind_addr.toString()));
-        utils::logInfo(std::format("Document root: {}", document_root_.string()));
+        utils::logInfo("Document root: {}", document_root_);
         
-        acceptLoop();
+        eventLoop();
         
     } catch (const std::exception& e) {
-        utils::logError(std::format("Server error: {}", e.what()));
+        utils::logError("Server error: {}", e.what());
         running_ = false;
+        closeAll();
         throw;
     }
 }
@@ -70,107 +287,1054 @@ void Server::stop() {
         return;
     }
     
-    running_ = false;
-    
-    if (server_socket_) {
-        server_socket_->close();
-    }
+    requestStop();
     
     utils::logInfo("Server stopped");
 }
 
-void Server::acceptLoop() {
+void Server::requestStop() noexcept {
+    running_ = false;
+    
+    // The loop closes the listener and idle connections on its way out
+    poller_->wake();
+}
+
+void Server::eventLoop() {
+    poller_->add(server_socket_->native_handle(), net::Poller::READABLE, server_socket_.get());
+    
+    std::array<net::Poller::Event, 256> events;
+    auto last_active = Clock::now();
+    
+    if (busy_poll_ && !busy_poll_->cpus.empty() && !utils::ThreadPool::pinCurrentThread(busy_poll_->cpus.front())) {
+        utils::logWarn("Could not pin the event loop to CPU {}", busy_poll_->cpus.front());
+    }
+    
     while (running_) {
-        try {
-            net::SockAddr client_addr;
-            net::Socket client = server_socket_->accept(&client_addr);
+        int timeout_ms = -1;
+        auto now = Clock::now();
+        auto next = timers_.nextTimeout(now);
+        if (auto async_next = async_->nextTimeout(now); async_next && (!next || *async_next < *next)) {
+            next = async_next;
+        }
+        if (next) {
+            timeout_ms = static_cast<int>(std::min<int64_t>(
+                std::chrono::ceil<std::chrono::milliseconds>(*next).count(), 1000));
+        }
+        
+        // Busy polling: never block while there is traffic. The round after
+        // the flag clears is still non-blocking, so a completion whose
+        // worker saw the flag set and skipped the wakeup is not stranded.
+        if (busy_poll_) {
+            if (now - last_active < busy_poll_->idle_timeout) {
+                loop_spinning_.store(true);
+                timeout_ms = 0;
+            } else if (loop_spinning_.exchange(false)) {
+                timeout_ms = 0;
+            }
+        }
+        
+        size_t ready = poller_->wait(events, timeout_ms);
+        loop_time_ = Clock::now();
+        if (ready > 0) {
+            last_active = loop_time_;
+        }
+        
+        for (size_t i = 0; i < ready; ++i) {
+            if (events[i].data == server_socket_.get()) {
+                acceptConnections();
+                continue;
+            }
+            
+            // A socket a coroutine handler is waiting on
+            if (AsyncLoop::owns(events[i].data)) {
+                AsyncLoop::dispatch(events[i]);
+                continue;
+            }
             
-            utils::logInfo(std::format("Connection from {}", client_addr.toString()));
+            auto& conn = *static_cast<Connection*>(events[i].data);
             
-            // Dispatch to thread pool
-            thread_pool_->submit([this, client = std::move(client), client_addr]() mutable {
-                handleClient(std::move(client), client_addr);
-            });
+            // A worker owns the buffers; just note the hangup and stop polling
+            if (conn.state == Connection::State::PROCESSING) {
+                conn.peer_closed = true;
+                conn.hung_up = true;
+                poller_->remove(conn.socket.native_handle());
+                continue;
+            }
+            
+            if (conn.state == Connection::State::WRITING) {
+                if (events[i].events & (net::Poller::WRITABLE | net::Poller::CLOSED)) {
+                    writeResponse(conn);
+                }
+                continue;
+            }
             
-        } catch (const std::exception& e) {
-            if (running_) {
-                utils::logError(std::format("Accept error: {}", e.what()));
+            if (conn.state == Connection::State::LINGERING) {
+                onLingering(conn);
+                continue;
             }
+            
+            onReadable(conn);
+        }
+        
+        // Resume coroutine handlers before writing what finished
+        async_->run(Clock::now());
+        if (drainCompletions() > 0) {
+            last_active = loop_time_;
+        } else if (ready == 0 && timeout_ms == 0) {
+            // An empty spin: let a thread sharing this core (a worker, or
+            // the client on loopback) have it
+            std::this_thread::yield();
         }
+        
+        timers_.advance(Clock::now(), [this](utils::TimerWheel::Timer& timer) {
+            onTimeout(static_cast<Connection&>(timer));
+        });
     }
+    
+    closeAll();
 }
 
-void Server::handleClient(net::Socket client, net::SockAddr client_addr) {
+void Server::acceptConnections() {
+    // One snapshot per batch; a reload swaps the pointer, never the table
+    auto access_list = access_list_.load(std::memory_order_acquire);
+    
+    while (running_) {
+        bool over_limit = !admission_->connectionAllowed(connections_.size());
+        if (over_limit && admission_->config().on_max_connections == OverloadAction::PAUSE_ACCEPT) {
+            pauseAccept(true);
+            return;
+        }
+        
+        net::SockAddr client_addr;
+        auto client = server_socket_->accept(std::nothrow, &client_addr);
+        
+        if (!client) {
+            // The peer gave up while queued; try the next one
+            if (client.error() == std::errc::connection_aborted) {
+                continue;
+            }
+            if (!net::wouldBlock(client.error())) {
+                utils::logError("Accept error: {}", client.error().message());
+            }
+            return;
+        }
+        
+        // Blocked peers are closed before anything is read or sent
+        if (access_list && !access_list->permits(client_addr.getAddress().toUint32())) {
+            if (metrics_) {
+                metrics_->add(metricsSlot(), utils::Metrics::ACCESS_DENIED);
+            }
+            continue;
+        }
+        
+        auto accepted_at = Clock::now();
+        auto accepted_ticks = utils::trace::ticks();
+        
+        if (over_limit) {
+            shedConnection(std::move(*client), client_addr, utils::Metrics::SHED_CONNECTIONS,
+                           503, admission_->overloadResponse());
+            continue;
+        }
+        
+        // Already over its rate: answer before reading anything
+        if (rate_limiter_->exhausted(client_addr.getAddress().toUint32(), accepted_at)) {
+            shedConnection(std::move(*client), client_addr, utils::Metrics::RATE_LIMITED,
+                           429, rate_limiter_->limitedResponse());
+            continue;
+        }
+        
+        utils::logInfo("Connection from {}", client_addr);
+        
+        auto* conn = addConnection(std::move(*client), client_addr, accepted_at, accepted_ticks);
+        if (conn) {
+            // Slowloris defence: the whole header must arrive in time
+            timers_.arm(*conn, accepted_at + connection_config_.header_timeout);
+        }
+    }
+}
+
+Connection* Server::addConnection(net::Socket client, const net::SockAddr& client_addr,
+                                  Clock::time_point accepted_at, uint64_t accepted_ticks) {
+    Connection* raw = nullptr;
     try {
-        // Read request (with timeout consideration in production)
-        auto buffer = client.receive(8192);
+        auto conn = std::make_unique<Connection>(std::move(client), client_addr, accepted_at, accepted_ticks);
+        poller_->add(conn->socket.native_handle(), net::Poller::READABLE, conn.get());
+        conn->interest = net::Poller::READABLE;
         
-        if (buffer.empty()) {
-            utils::logWarn(std::format("Empty request from {}", client_addr.toString()));
+        raw = conn.get();
+        connections_.emplace(raw, std::move(conn));
+    } catch (const std::exception& e) {
+        utils::logError("Failed to register {}: {}", client_addr, e.what());
+        return nullptr;
+    }
+    
+    if (metrics_) {
+        metrics_->add(metricsSlot(), utils::Metrics::CONNECTIONS_OPENED);
+    }
+    return raw;
+}
+
+void Server::shedConnection(net::Socket client, const net::SockAddr& client_addr, utils::Metrics::Counter reason,
+                            uint16_t status, std::string_view wire) {
+    if (metrics_) {
+        metrics_->add(metricsSlot(), reason);
+    }
+    
+    // Answered like any other reply (Date block, write deadline) and closed
+    // with a linger, so the unread request does not turn into an RST
+    if (auto* conn = addConnection(std::move(client), client_addr, Clock::now(), utils::trace::ticks())) {
+        respondAndClose(*conn, status, wire);
+    }
+}
+
+void Server::pauseAccept(bool paused) {
+    if (accept_paused_ == paused) {
+        return;
+    }
+    accept_paused_ = paused;
+    
+    try {
+        poller_->modify(server_socket_->native_handle(), paused ? 0 : net::Poller::READABLE, server_socket_.get());
+    } catch (const std::exception& e) {
+        utils::logError("Poller update failed for listener: {}", e.what());
+    }
+    
+    if (paused) {
+        utils::logWarn("Connection limit reached ({}), pausing accept", connections_.size());
+    } else {
+        utils::logInfo("Resuming accept");
+    }
+}
+
+void Server::onReadable(Connection& conn) {
+    auto open = conn.receive(buffers_, connection_config_);
+    if (!open) {
+        closeConnection(conn);
+        return;
+    }
+    
+    if (!*open) {
+        conn.peer_closed = true;
+    }
+    
+    if (conn.state == Connection::State::IDLE) {
+        if (conn.in.empty()) {
+            closeConnection(conn);
             return;
         }
+        beginRequest(conn);
+    }
+    
+    processInput(conn);
+}
+
+void Server::beginRequest(Connection& conn) {
+    conn.state = Connection::State::READING_HEADERS;
+    conn.started_at = Clock::now();
+    conn.trace.mark(utils::trace::Phase::ACCEPTED);
+    timers_.arm(conn, conn.started_at + connection_config_.header_timeout);
+}
+
+void Server::processInput(Connection& conn) {
+    switch (conn.frame(connection_config_)) {
+        using enum Connection::Framing;
         
-        // Parse request
-        http::HTTPRequest request;
-        std::string_view raw_request(buffer.data(), buffer.size());
+        case NEED_HEADERS:
+            break;
+        
+        case NEED_BODY:
+            if (conn.state == Connection::State::READING_HEADERS) {
+                conn.state = Connection::State::READING_BODY;
+                timers_.arm(conn, Clock::now() + connection_config_.body_timeout);
+            }
+            break;
+        
+        case COMPLETE:
+            dispatch(conn);
+            return;
+        
+        case HEADERS_TOO_LARGE:
+            reject(conn, http::CannedResponse::headersTooLarge());
+            return;
+        
+        case BODY_TOO_LARGE:
+            reject(conn, http::CannedResponse::payloadTooLarge());
+            return;
+        
+        case UNSUPPORTED:
+            reject(conn, http::CannedResponse::notImplemented());
+            return;
+        
+        case INVALID:
+            reject(conn, http::CannedResponse::badRequest());
+            return;
+    }
+    
+    // Incomplete request and nothing more will arrive
+    if (conn.peer_closed) {
+        closeConnection(conn);
+    }
+}
+
+void Server::dispatch(Connection& conn) {
+    conn.trace.mark(utils::trace::Phase::RECEIVED);
+    
+    uint32_t client = conn.peer.getAddress().toUint32();
+    
+    // Framed but not parsed; a limited client costs no parser or worker time
+    if (!rate_limiter_->allow(client, loop_time_)) {
+        if (metrics_) {
+            metrics_->add(metricsSlot(), utils::Metrics::RATE_LIMITED);
+        }
+        respondAndClose(conn, 429, rate_limiter_->limitedResponse());
+        return;
+    }
+    
+    if (!admission_->tryEnqueue()) {
+        if (metrics_) {
+            metrics_->add(metricsSlot(), utils::Metrics::SHED_QUEUE);
+        }
+        respondAndClose(conn, 503, admission_->overloadResponse());
+        return;
+    }
+    
+    // One client cannot fill the queue for everyone else
+    if (!fair_queue_->push(client, &conn)) {
+        admission_->cancelEnqueue();
+        if (metrics_) {
+            metrics_->add(metricsSlot(), utils::Metrics::SHED_CLIENT);
+        }
+        respondAndClose(conn, 503, admission_->overloadResponse());
+        return;
+    }
+    
+    conn.cancel();
+    conn.state = Connection::State::PROCESSING;
+    conn.queued_at = Clock::now();
+    
+    // Stop reading until the response is out; pipelined bytes wait in the buffer
+    setInterest(conn, 0);
+    
+    // Each task serves whichever request is next in fair order, not
+    // necessarily this one
+    try {
+        thread_pool_->submit([this] {
+            if (auto next = fair_queue_->pop()) {
+                process(**next);
+            }
+        });
+    } catch (const std::exception& e) {
+        utils::logError("Failed to dispatch request from {}: {}", conn.peer, e.what());
+        
+        // No task will pop for this item. If another task has taken it
+        // already, the item left without one is someone else's.
+        Connection* orphan = &conn;
+        if (!fair_queue_->remove(client, &conn)) {
+            auto next = fair_queue_->pop();
+            orphan = next ? *next : nullptr;
+        }
+        if (orphan) {
+            admission_->cancelEnqueue();
+            orphan->state = Connection::State::READING_HEADERS;
+            closeConnection(*orphan);
+        }
+    }
+}
+
+void Server::reject(Connection& conn, const http::CannedResponse& response) {
+    utils::logWarn("Rejected request from {} with {}", conn.peer, response.status());
+    
+    if (metrics_) {
+        metrics_->add(metricsSlot(), utils::Metrics::PARSE_ERRORS);
+    }
+    
+    respondAndClose(conn, response);
+}
+
+void Server::respondAndClose(Connection& conn, const http::CannedResponse& response) {
+    respondAndClose(conn, response.status(), response.wire(http::CannedResponse::Persistence::CLOSE));
+}
+
+void Server::respondAndClose(Connection& conn, uint16_t status, std::string_view wire) {
+    spliceWire(conn, wire, {});
+    conn.keep_alive = false;
+    conn.status = status;
+    conn.route = static_route_;
+    conn.request_size = conn.in.size();
+    conn.out_offset = 0;
+    conn.state = Connection::State::WRITING;
+    conn.linger = true;
+    conn.cancel();
+    writeResponse(conn);
+}
+
+void Server::process(Connection& conn) {
+    utils::trace::Scope trace_scope(tracer_ ? &conn.trace : nullptr);
+    FRQS_TRACE_MARK(DEQUEUED);
+    
+    conn.worker = utils::ThreadPool::workerIndex();
+    
+    // Waited too long to be worth serving; answer 503 without parsing
+    auto dequeued_at = Clock::now();
+    if (admission_->dequeued(dequeued_at - conn.queued_at, dequeued_at)) {
+        if (metrics_) {
+            metrics_->add(metricsSlot(), utils::Metrics::SHED_DELAY);
+        }
+        conn.keep_alive = false;
+        conn.status = 503;
+        conn.route = static_route_;
+        spliceWire(conn, admission_->overloadResponse(), {});
+        complete(conn);
+        return;
+    }
+    
+    // Both live in the connection's arena; emplacing keeps the response's
+    // allocator, where assigning would copy it back onto the heap
+    std::optional<http::HTTPResponse> response;
+    
+    try {
+        auto& request = conn.request.emplace(&conn.arena);
+        bool parsed = request.parse(std::string_view(conn.in.data(), conn.request_size));
+        FRQS_TRACE_MARK(PARSED);
         
-        if (!request.parse(raw_request)) {
-            utils::logWarn(std::format("Invalid request from {}: {}", 
-                                      client_addr.toString(), 
-                                      request.getError()));
+        if (!parsed) {
+            utils::logWarn("Invalid request from {}: {}", 
+                           conn.peer, 
+                           request.getError());
             
-            auto response = http::HTTPResponse().badRequest();
-            client.send(response.build());
+            conn.keep_alive = false;
+            conn.route = static_route_;
+            
+            if (metrics_) {
+                metrics_->add(metricsSlot(), utils::Metrics::PARSE_ERRORS);
+            }
+            respondCanned(conn, http::CannedResponse::badRequest());
             return;
+        } else {
+            utils::logInfo("{} {} from {}", 
+                           http::methodToString(request.getMethod()),
+                           request.getPath(),
+                           conn.peer);
+            
+            conn.method = request.getMethod();
+            conn.path = request.getPath();
+            
+            // HTTP/1.1 defaults to keep-alive, HTTP/1.0 has to ask for it
+            auto connection = request.getHeader("Connection");
+            bool wants_close = connection && http::containsToken(*connection, "close");
+            bool wants_keep = connection && http::containsToken(*connection, "keep-alive");
+            conn.http11 = request.getVersion() == "HTTP/1.1";
+            conn.keep_alive = connection_config_.keep_alive
+                && (conn.http11 ? !wants_close : wants_keep)
+                && (connection_config_.max_requests == 0 || conn.requests_served + 1 < connection_config_.max_requests);
+            
+            conn.handler_start = Clock::now();
+            if (metrics_ && request.getPath() == metrics_path_) {
+                conn.route = metrics_route_;
+                // Copied into the arena with the rest of the response
+                auto text = metrics_->renderPrometheus();
+                response.emplace(&conn.arena).ok(std::string_view(text))
+                                             .setContentType("text/plain; version=0.0.4");
+            } else if (auto handled = handleRequest(conn)) {
+                response.emplace(std::move(*handled));
+            } else {
+                // Answered from the cache, or a coroutine handler owns the
+                // request now and may already have responded; conn is not
+                // ours to touch
+                return;
+            }
+            auto handler_end = Clock::now();
+            FRQS_TRACE_MARK(HANDLED);
+            
+            conn.handler_us = static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(handler_end - conn.handler_start).count());
         }
+    } catch (const std::exception& e) {
+        utils::logError("Error handling client {}: {}", 
+                        conn.peer, 
+                        e.what());
+        
+        conn.keep_alive = false;
+        respondCanned(conn, http::CannedResponse::internalError());
+        return;
+    }
+    
+    respond(conn, response);
+}
+
+void Server::respond(Connection& conn, std::optional<http::HTTPResponse>& response) {
+    std::array<char, utils::DateHeader::CAPACITY> block;
+    conn.serialize(*response, date_header_.read(block));
+    response.reset();
+    FRQS_TRACE_MARK(BUILT);
+    
+    complete(conn);
+}
+
+void Server::finishAsync(Connection& conn) {
+    utils::trace::Scope trace_scope(tracer_ ? &conn.trace : nullptr);
+    
+    std::optional<http::HTTPResponse> response;
+    try {
+        response.emplace(conn.task.result());
+    } catch (const std::exception& e) {
+        utils::logError("Error handling client {}: {}", 
+                        conn.peer, 
+                        e.what());
+        
+        conn.keep_alive = false;
+    }
+    FRQS_TRACE_MARK(HANDLED);
+    
+    conn.handler_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - conn.handler_start).count());
+    
+    // The proxy has already written the response itself
+    if (conn.relayed) {
+        complete(conn);
+        return;
+    }
+    
+    if (!response) {
+        respondCanned(conn, http::CannedResponse::internalError());
+        return;
+    }
+    respond(conn, response);
+}
+
+void Server::complete(Connection& conn) {
+    {
+        std::lock_guard<std::mutex> lock(completions_mutex_);
+        completions_.push_back(&conn);
+    }
+    if (!loop_spinning_.load()) {
+        poller_->wake();
+    }
+}
+
+size_t Server::drainCompletions() {
+    // Swapped with a member, not a local, so both vectors keep their
+    // capacity and a steady stream of completions does not allocate
+    auto& ready = draining_;
+    {
+        std::lock_guard<std::mutex> lock(completions_mutex_);
+        ready.swap(completions_);
+    }
+    
+    for (auto* conn : ready) {
+        conn->state = Connection::State::WRITING;
+        conn->out_offset = 0;
+        
+        // Hung up while the worker ran; nothing to deliver to
+        if (conn->hung_up) {
+            closeConnection(*conn);
+            continue;
+        }
+        
+        writeResponse(*conn);
+    }
+    size_t drained = ready.size();
+    ready.clear();
+    return drained;
+}
+
+void Server::writeResponse(Connection& conn) {
+    auto done = conn.flush();
+    if (!done) {
+        closeConnection(conn);
+        return;
+    }
+    
+    if (!*done) {
+        // Whatever is left goes out in full segments, not the socket
+        // buffer's worth at a time
+        if (socket_profile_.cork && !conn.corked) {
+            conn.corked = conn.socket.set(std::nothrow, net::option::Cork(true)).has_value();
+        }
+        setInterest(conn, net::Poller::WRITABLE);
+        if (!conn.armed()) {
+            timers_.arm(conn, Clock::now() + connection_config_.write_timeout);
+        }
+        return;
+    }
+    
+    if (conn.corked) {
+        conn.corked = !conn.socket.set(std::nothrow, net::option::Cork(false)).has_value();
+    }
+    
+    conn.cancel();
+    conn.trace.mark(utils::trace::Phase::SENT);
+    finishRequest(conn);
+    
+    if (conn.linger && !conn.peer_closed && running_) {
+        lingerClose(conn);
+        return;
+    }
+    if (!conn.keep_alive || conn.peer_closed || !running_) {
+        closeConnection(conn);
+        return;
+    }
+    
+    conn.advance();
+    conn.state = Connection::State::IDLE;
+    setInterest(conn, net::Poller::READABLE);
+    
+    // Pipelined request already buffered
+    if (!conn.in.empty()) {
+        beginRequest(conn);
+        processInput(conn);
+        return;
+    }
+    
+    timers_.arm(conn, Clock::now() + connection_config_.keep_alive_timeout);
+}
+
+void Server::lingerClose(Connection& conn) {
+    // Closing with request bytes still unread makes the kernel answer them
+    // with an RST, which can destroy the reply before the client reads it.
+    // Send a FIN instead and drop input until the client closes too.
+    conn.socket.shutdown(net::Socket::SHUTDOWN_WRITE);
+    conn.advance();
+    conn.in.consume(conn.in.size());
+    conn.state = Connection::State::LINGERING;
+    setInterest(conn, net::Poller::READABLE);
+    timers_.arm(conn, Clock::now() + connection_config_.linger_timeout);
+}
+
+void Server::onLingering(Connection& conn) {
+    auto open = conn.discard();
+    if (!open || !*open) {
+        closeConnection(conn);
+    }
+}
+
+void Server::finishRequest(Connection& conn) {
+    utils::logInfo("Responded {} to {}", 
+                   conn.status,
+                   conn.peer);
+    
+    if (tracer_) {
+        tracer_->finish(conn.trace, conn.worker, 
+                        http::methodToString(conn.method), 
+                        conn.path, conn.status);
+    }
+    
+    if (metrics_) {
+        metrics_->recordRequest(metricsSlot(), conn.route, conn.status, conn.request_size, conn.outSize() + conn.bytes_relayed,
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - conn.started_at).count()));
+    }
+    
+    if (access_log_) {
+        recordAccess(conn);
+    }
+}
+
+void Server::onTimeout(Connection& conn) {
+    switch (conn.state) {
+        using enum Connection::State;
         
-        utils::logInfo(std::format("{} {} from {}", 
-                                  http::methodToString(request.getMethod()),
-                                  request.getPath(),
-                                  client_addr.toString()));
+        case IDLE:
+            // Keep-alive expiry is routine
+            closeConnection(conn);
+            return;
         
-        // Handle request
-        auto response = handleRequest(request);
+        case READING_HEADERS:
+        case READING_BODY:
+            utils::logWarn("Timed out reading request from {}", conn.peer);
+            if (metrics_) {
+                metrics_->add(metricsSlot(), utils::Metrics::TIMEOUTS);
+            }
+            
+            // Nothing sent at all: just drop it
+            if (conn.in.empty()) {
+                closeConnection(conn);
+                return;
+            }
+            
+            // Best effort 408; the write deadline still bounds it
+            respondAndClose(conn, http::CannedResponse::requestTimeout());
+            return;
         
-        // Send response
-        client.send(response.build());
+        case LINGERING:
+            closeConnection(conn);
+            return;
         
-        utils::logInfo(std::format("Responded {} to {}", 
-                                  response.getStatus(),
-                                  client_addr.toString()));
+        case WRITING:
+            utils::logWarn("Timed out writing response to {}", conn.peer);
+            if (metrics_) {
+                metrics_->add(metricsSlot(), utils::Metrics::TIMEOUTS);
+            }
+            closeConnection(conn);
+            return;
         
+        // Never armed: a worker or a suspended coroutine owns the
+        // connection, and neither can be interrupted safely. Handlers bound
+        // their own waits (readable()/writable() timeouts, the proxy's
+        // response_timeout); a client hangup is still noticed meanwhile.
+        case PROCESSING:
+            return;
+    }
+}
+
+void Server::setInterest(Connection& conn, uint32_t interest) {
+    if (conn.interest == interest) {
+        return;
+    }
+    conn.interest = interest;
+    try {
+        poller_->modify(conn.socket.native_handle(), interest, &conn);
     } catch (const std::exception& e) {
-        utils::logError(std::format("Error handling client {}: {}", 
-                                   client_addr.toString(), 
-                                   e.what()));
-        
-        try {
-            auto response = http::HTTPResponse().internalError();
-            client.send(response.build());
-        } catch (...) {
-            // Best effort
+        utils::logError("Poller update failed for {}: {}", conn.peer, e.what());
+    }
+}
+
+void Server::closeConnection(Connection& conn) {
+    poller_->remove(conn.socket.native_handle());
+    conn.cancel();
+    conn.socket.close();
+    
+    if (metrics_) {
+        metrics_->add(metricsSlot(), utils::Metrics::CONNECTIONS_CLOSED);
+    }
+    
+    connections_.erase(&conn);
+    
+    if (accept_paused_ && running_ && admission_->connectionAllowed(connections_.size())) {
+        pauseAccept(false);
+    }
+}
+
+void Server::closeAll() {
+    if (server_socket_) {
+        poller_->remove(server_socket_->native_handle());
+        server_socket_->close();
+    }
+    
+    // Connections a worker still holds are released after the pool joins
+    std::vector<Connection*> idle;
+    for (auto& [raw, conn] : connections_) {
+        if (conn->state != Connection::State::PROCESSING) {
+            idle.push_back(raw);
         }
     }
+    for (auto* conn : idle) {
+        closeConnection(*conn);
+    }
+}
+
+void Server::recordAccess(const Connection& conn) {
+    utils::AccessRecord record;
+    record.timestamp_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    record.client_ip = conn.peer.getAddress().toUint32();
+    record.client_port = conn.peer.getPort();
+    record.method = static_cast<uint8_t>(conn.method);
+    record.setPath(conn.path);
+    record.status = conn.status;
+    record.bytes_in = static_cast<uint32_t>(conn.request_size);
+    record.bytes_out = conn.outSize() + conn.bytes_relayed;
+    record.handler_us = conn.handler_us;
+    record.total_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - conn.started_at).count());
+    
+    // The event loop is the only producer
+    access_log_->record(0, record);
 }
 
-http::HTTPResponse Server::handleRequest(const http::HTTPRequest& request) {
+std::optional<http::HTTPResponse> Server::handleRequest(Connection& conn) {
+    auto& request = *conn.request;
+    
+    // Registered routes first
+    if (!router_.empty()) {
+        auto match = router_.match(request.getMethod(), request.getPath());
+        
+        if (match.handler) {
+            conn.route = match.route < route_metrics_.size() ? route_metrics_[match.route] : handler_route_;
+            request.setParams(match.getParams());
+            
+            if (match.route < canned_routes_.size() && canned_routes_[match.route]) {
+                respondCanned(conn, *canned_routes_[match.route]);
+                return std::nullopt;
+            }
+            
+            // Answered later through finishAsync
+            if (match.route < proxy_routes_.size() && proxy_routes_[match.route]) {
+                conn.task = proxy_routes_[match.route]->relay(conn);
+                async_->start(conn.task, &conn);
+                return std::nullopt;
+            }
+            if (match.route < async_routes_.size() && async_routes_[match.route]) {
+                conn.task = async_routes_[match.route](request);
+                async_->start(conn.task, &conn);
+                return std::nullopt;
+            }
+            return callHandler(conn, *match.handler);
+        }
+        
+        if (match.path_found) {
+            conn.route = handler_route_;
+            return http::HTTPResponse(request.get_allocator())
+                .setStatus(405)
+                .setHeader("Allow", http::Router::allowHeader(match.allowed))
+                .setBody("<h1>405 - Method Not Allowed</h1>")
+                .setContentType("text/html");
+        }
+    }
+    
     // Use custom handler if provided
     if (custom_handler_) {
-        return custom_handler_(request);
+        conn.route = handler_route_;
+        return callHandler(conn, custom_handler_);
     }
     
     // Default: serve static files
-    return serveStaticFile(request);
+    conn.route = static_route_;
+    return serveStatic(conn);
 }
 
-http::HTTPResponse Server::serveStaticFile(const http::HTTPRequest& request) {
+std::optional<http::HTTPResponse> Server::callHandler(Connection& conn, const RequestHandler& handler) {
+    auto& request = *conn.request;
+    if (!response_cache_ || !response_cache_->accepts(request)) {
+        return handler(request);
+    }
+    
+    auto key = response_cache_->key(request);
+    if (auto hit = response_cache_->find(key, Clock::now())) {
+        // Only the first stale hit refreshes; it needs its own copy of
+        // the request, conn moves on once the response is out
+        if (hit->refresh) {
+            try {
+                thread_pool_->submit([this, raw = std::string(conn.in.data(), conn.request_size), key] {
+                    revalidate(raw, key);
+                });
+            } catch (const std::exception& e) {
+                utils::logError("Failed to schedule cache refresh: {}", e.what());
+                response_cache_->abandon(key);
+            }
+        }
+        const auto& entry = *hit->entry;
+        respondWire(conn, std::shared_ptr<const std::string>(hit->entry, &entry.wire), entry.head_size, entry.status);
+        return std::nullopt;
+    }
+    
+    // Concurrent misses on the same key wait for this one
+    if (!flights_.join(key, conn)) {
+        return std::nullopt;
+    }
+    
+    std::optional<http::HTTPResponse> response;
+    std::shared_ptr<const ResponseCache::Entry> entry;
+    try {
+        response.emplace(handler(request));
+        entry = response_cache_->store(key, *response, Clock::now());
+    } catch (...) {
+        computeAlone(flights_.finish(key), handler);
+        throw;
+    }
+    
+    // Not cacheable means not shareable either; the waiters ask for themselves
+    auto waiters = flights_.finish(key);
+    if (!entry) {
+        computeAlone(std::move(waiters), handler);
+        return response;
+    }
+    
+    response.reset();   // Arena-backed; must not outlive the handoff below
+    FRQS_TRACE_MARK(HANDLED);
+    conn.handler_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - conn.handler_start).count());
+    std::shared_ptr<const std::string> wire(entry, &entry->wire);
+    respondWaiters(waiters, wire, entry->head_size, entry->status);
+    respondWire(conn, std::move(wire), entry->head_size, entry->status);
+    return std::nullopt;
+}
+
+std::optional<http::HTTPResponse> Server::serveStatic(Connection& conn) {
+    auto& request = *conn.request;
+    
+    // Misses, traversal attempts and other methods go out canned; under
+    // scanner traffic they are most of what this path serves
+    std::filesystem::path file;
+    if (const auto* canned = resolveStatic(request, file)) {
+        FRQS_TRACE_MARK(HANDLED);
+        conn.handler_us = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - conn.handler_start).count());
+        respondCanned(conn, *canned);
+        return std::nullopt;
+    }
+    
+    // GET and HEAD of a path read the same file
+    std::string key = std::string("static ").append(request.getPath());
+    if (!flights_.join(key, conn)) {
+        return std::nullopt;
+    }
+    
+    auto read = [this, file](const http::HTTPRequest& r) { return serveStaticFile(r, file); };
+    std::optional<http::HTTPResponse> response;
+    try {
+        response.emplace(serveStaticFile(request, file));
+    } catch (...) {
+        computeAlone(flights_.finish(key), read);
+        throw;
+    }
+    
+    auto waiters = flights_.finish(key);
+    if (waiters.empty()) {
+        return response;
+    }
+    
+    FRQS_TRACE_MARK(HANDLED);
+    conn.handler_us = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - conn.handler_start).count());
+    auto wire = std::make_shared<const std::string>(response->build());
+    size_t head_size = wire->find("\r\n\r\n") + 4;
+    uint16_t status = response->getStatus();
+    response.reset();   // Arena-backed; must not outlive the handoff below
+    respondWaiters(waiters, wire, head_size, status);
+    respondWire(conn, std::move(wire), head_size, status);
+    return std::nullopt;
+}
+
+void Server::respondWaiters(const std::vector<Connection*>& waiters, const std::shared_ptr<const std::string>& wire,
+                            size_t head_size, uint16_t status) {
+    auto now = Clock::now();
+    for (auto* waiter : waiters) {
+        utils::trace::Scope trace_scope(tracer_ ? &waiter->trace : nullptr);
+        FRQS_TRACE_MARK(HANDLED);
+        waiter->handler_us = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - waiter->handler_start).count());
+        respondWire(*waiter, wire, head_size, status);
+    }
+}
+
+void Server::computeAlone(std::vector<Connection*> waiters, const RequestHandler& handler) {
+    for (auto* waiter : waiters) {
+        auto run = [this, waiter, handler] {
+            utils::trace::Scope trace_scope(tracer_ ? &waiter->trace : nullptr);
+            
+            std::optional<http::HTTPResponse> response;
+            try {
+                response.emplace(handler(*waiter->request));
+            } catch (const std::exception& e) {
+                utils::logError("Error handling client {}: {}", waiter->peer, e.what());
+                waiter->keep_alive = false;
+            }
+            FRQS_TRACE_MARK(HANDLED);
+            
+            waiter->handler_us = static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - waiter->handler_start).count());
+            if (!response) {
+                respondCanned(*waiter, http::CannedResponse::internalError());
+                return;
+            }
+            respond(*waiter, response);
+        };
+        
+        // A parked connection must be answered; without the pool, answer here
+        try {
+            thread_pool_->submit(run);
+        } catch (const std::exception&) {
+            run();
+        }
+    }
+}
+
+void Server::respondWire(Connection& conn, std::shared_ptr<const std::string> wire, size_t head_size, uint16_t status) {
+    std::string_view bytes = *wire;
+    if (conn.method == http::Method::HEAD) {
+        bytes = bytes.substr(0, head_size);
+    }
+    
+    // Stored without Connection; added after the status line when needed
+    std::string_view connection;
+    if (!conn.keep_alive) {
+        connection = "Connection: close\r\n";
+    } else if (!conn.http11) {
+        connection = "Connection: keep-alive\r\n";
+    }
+    
+    spliceWire(conn, bytes, connection, std::move(wire));
+    conn.status = status;
+    FRQS_TRACE_MARK(BUILT);
+    
+    complete(conn);
+}
+
+void Server::respondCanned(Connection& conn, const http::CannedResponse& response) {
+    using Persistence = http::CannedResponse::Persistence;
+    auto persistence = !conn.keep_alive ? Persistence::CLOSE
+                     : conn.http11 ? Persistence::DEFAULT
+                     : Persistence::KEEP_ALIVE;
+    
+    conn.status = response.status();
+    spliceWire(conn, response.wire(persistence, conn.method == http::Method::HEAD), {});
+    FRQS_TRACE_MARK(BUILT);
+    
+    complete(conn);
+}
+
+void Server::spliceWire(Connection& conn, std::string_view wire, std::string_view connection,
+                        std::shared_ptr<const std::string> owner) {
+    std::array<char, utils::DateHeader::CAPACITY> block;
+    auto headers = date_header_.read(block);
+    
+    // Copy only what differs per response; flush() gathers the rest in
+    size_t status_line = wire.find("\r\n") + 2;
+    conn.out.clear();
+    conn.out.append(wire.substr(0, status_line));
+    conn.out.append(headers);
+    conn.out.append(connection);
+    conn.out_tail = wire.substr(status_line);
+    conn.out_owner = std::move(owner);
+}
+
+void Server::revalidate(const std::string& raw, const std::string& key) {
+    std::optional<http::HTTPResponse> response;
+    try {
+        http::HTTPRequest request;
+        if (request.parse(raw)) {
+            if (auto* handler = findHandler(request)) {
+                response = (*handler)(request);
+            }
+        }
+    } catch (const std::exception& e) {
+        utils::logError("Cache refresh failed: {}", e.what());
+    }
+    
+    if (response) {
+        (void)response_cache_->store(key, *response, Clock::now());
+    } else {
+        response_cache_->abandon(key);
+    }
+}
+
+const Server::RequestHandler* Server::findHandler(http::HTTPRequest& request) const {
+    if (!router_.empty()) {
+        auto match = router_.match(request.getMethod(), request.getPath());
+        if (match.handler) {
+            bool coroutine = (match.route < async_routes_.size() && async_routes_[match.route])
+                          || (match.route < proxy_routes_.size() && proxy_routes_[match.route]);
+            bool canned = match.route < canned_routes_.size() && canned_routes_[match.route];
+            if (coroutine || canned) {
+                return nullptr;
+            }
+            request.setParams(match.getParams());
+            return match.handler;
+        }
+        if (match.path_found) {
+            return nullptr;
+        }
+    }
+    return custom_handler_ ? &custom_handler_ : nullptr;
+}
+
+const http::CannedResponse* Server::resolveStatic(const http::HTTPRequest& request, std::filesystem::path& file) const {
     // Only support GET and HEAD
     if (request.getMethod() != http::Method::GET && 
         request.getMethod() != http::Method::HEAD) {
-        return http::HTTPResponse()
-            .setStatus(405, "Method Not Allowed")
-            .setBody("<h1>405 - Method Not Allowed</h1>")
-            .setContentType("text/html");
+        return &http::CannedResponse::methodNotAllowed();
     }
     
     // Get requested path
@@ -183,41 +1347,42 @@ http::HTTPResponse Server::serveStaticFile(const http::HTTPRequest& request) {
     
     // Security check: resolve path safely
     auto safe_path = utils::FileSystemUtils::securePath(document_root_, requested_path);
+    FRQS_TRACE_MARK(RESOLVED);
     
     if (!safe_path) {
-        utils::logWarn(std::format("Path traversal attempt: {}", requested_path));
-        return http::HTTPResponse().forbidden(
-            "<h1>403 - Forbidden</h1><p>Path traversal detected.</p>"
-        );
+        utils::logWarn("Path traversal attempt: {}", requested_path);
+        return &http::CannedResponse::forbidden();
     }
     
     // Check if file exists
     if (!std::filesystem::exists(*safe_path)) {
-        utils::logWarn(std::format("File not found: {}", safe_path->string()));
-        return http::HTTPResponse().notFound();
+        utils::logWarn("File not found: {}", *safe_path);
+        return &http::CannedResponse::notFound();
     }
     
     // Check if it's a regular file
     if (!std::filesystem::is_regular_file(*safe_path)) {
-        return http::HTTPResponse().forbidden(
-            "<h1>403 - Forbidden</h1><p>Not a regular file.</p>"
-        );
+        return &http::CannedResponse::forbidden();
     }
     
-    // Read file
-    auto content = utils::FileSystemUtils::readFile(*safe_path);
+    file = std::move(*safe_path);
+    return nullptr;
+}
+
+http::HTTPResponse Server::serveStaticFile(const http::HTTPRequest& request, const std::filesystem::path& file) {
+    // Read file straight into the body, in the request's arena
+    http::HTTPResponse response(request.get_allocator());
+    bool read = utils::FileSystemUtils::readFile(file, response.getBody());
+    FRQS_TRACE_MARK(FILE_READ);
     
-    if (!content) {
-        utils::logError(std::format("Failed to read file: {}", safe_path->string()));
-        return http::HTTPResponse().internalError();
+    if (!read) {
+        utils::logError("Failed to read file: {}", file);
+        return http::HTTPResponse(request.get_allocator()).internalError();
     }
     
     // Detect MIME type
-    auto mime_type = http::MimeTypes::fromPath(*safe_path);
-    
-    return http::HTTPResponse()
-        .ok(std::move(*content))
-        .setContentType(mime_type);
+    response.ok().setContentType(http::MimeTypes::fromPath(file));
+    return response;
 }
 
 } // namespace frqs::core
\ No newline at end of file
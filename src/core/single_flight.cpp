@@ -0,0 +1,35 @@
+#include "core/single_flight.hpp"
+#include <functional>
+
+namespace frqs::core {
+
+SingleFlight::Shard& SingleFlight::shardFor(const std::string& key) noexcept {
+    return shards_[std::hash<std::string>{}(key) % SHARDS];
+}
+
+bool SingleFlight::join(const std::string& key, Connection& conn) {
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto [flight, leader] = shard.flights.try_emplace(key);
+    if (!leader) {
+        flight->second.push_back(&conn);
+        coalesced_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return leader;
+}
+
+std::vector<Connection*> SingleFlight::finish(const std::string& key) {
+    auto& shard = shardFor(key);
+    std::lock_guard lock(shard.mutex);
+
+    auto flight = shard.flights.find(key);
+    if (flight == shard.flights.end()) {
+        return {};
+    }
+    auto waiters = std::move(flight->second);
+    shard.flights.erase(flight);
+    return waiters;
+}
+
+} // namespace frqs::core
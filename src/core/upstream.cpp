@@ -0,0 +1,194 @@
+#include "core/upstream.hpp"
+
+#ifdef ERROR
+	#undef ERROR
+#endif
+
+#include "utils/logger.hpp"
+#include <charconv>
+#include <format>
+#include <stdexcept>
+
+namespace frqs::core {
+
+namespace {
+    constexpr size_t NONE = SIZE_MAX;
+
+    bool parseNumber(std::string_view text, uint32_t max, uint32_t& out) noexcept {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return !text.empty() && ec == std::errc{} && ptr == text.data() + text.size() && out <= max;
+    }
+
+    std::optional<net::SockAddr> parseBackend(std::string_view text) noexcept {
+        size_t colon = text.rfind(':');
+        if (colon == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        uint32_t port = 0;
+        if (!parseNumber(text.substr(colon + 1), 65535, port) || port == 0) {
+            return std::nullopt;
+        }
+
+        uint32_t address = 0;
+        auto host = text.substr(0, colon);
+        for (int octet = 0; octet < 4; ++octet) {
+            size_t dot = host.find('.');
+            if ((octet < 3) == (dot == std::string_view::npos)) {
+                return std::nullopt;
+            }
+
+            uint32_t value = 0;
+            if (!parseNumber(host.substr(0, dot), 255, value)) {
+                return std::nullopt;
+            }
+            address = (address << 8) | value;
+            host = dot == std::string_view::npos ? std::string_view{} : host.substr(dot + 1);
+        }
+
+        return net::SockAddr(net::IPv4(address), static_cast<uint16_t>(port));
+    }
+
+    // A pooled connection the backend has since closed reads as EOF (or
+    // stray bytes) instead of would-block
+    bool stillOpen(net::Socket& socket) noexcept {
+        char byte;
+        auto received = socket.receive(std::nothrow, &byte, 1);
+        return !received && net::wouldBlock(received.error());
+    }
+}
+
+Upstream::Upstream(UpstreamConfig config)
+    : config_(std::move(config))
+    , backends_(config_.backends.size())
+{
+    if (backends_.empty()) {
+        throw std::runtime_error("Upstream needs at least one backend");
+    }
+    if (config_.max_failures == 0) {
+        config_.max_failures = 1;
+    }
+}
+
+std::vector<net::SockAddr> Upstream::parseBackends(std::string_view list) {
+    std::vector<net::SockAddr> backends;
+
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        auto item = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        while (!item.empty() && item.front() == ' ') {
+            item.remove_prefix(1);
+        }
+        while (!item.empty() && item.back() == ' ') {
+            item.remove_suffix(1);
+        }
+        if (item.empty()) {
+            continue;
+        }
+
+        auto backend = parseBackend(item);
+        if (!backend) {
+            throw std::runtime_error(std::format("Invalid upstream '{}', expected a.b.c.d:port", item));
+        }
+        backends.push_back(*backend);
+    }
+
+    return backends;
+}
+
+std::optional<Upstream::Lease> Upstream::acquire(Clock::time_point now) {
+    std::lock_guard lock(mutex_);
+
+    size_t count = backends_.size();
+    size_t chosen = NONE;
+
+    // A down backend due for a probe takes this request; if it fails the
+    // probe, it waits another retry_interval
+    for (size_t i = 0; i < count; ++i) {
+        auto& backend = backends_[i];
+        if (down(backend) && now >= backend.retry_at) {
+            backend.retry_at = now + config_.retry_interval;
+            chosen = i;
+            break;
+        }
+    }
+
+    if (chosen == NONE) {
+        for (size_t i = 0; i < count; ++i) {
+            size_t index = (next_ + i) % count;
+            if (down(backends_[index])) {
+                continue;
+            }
+            if (chosen == NONE || backends_[index].outstanding < backends_[chosen].outstanding) {
+                chosen = index;
+            }
+        }
+    }
+
+    if (chosen == NONE) {
+        return std::nullopt;
+    }
+
+    next_ = (chosen + 1) % count;
+    auto& backend = backends_[chosen];
+    ++backend.outstanding;
+
+    Lease lease;
+    lease.backend = chosen;
+
+    // Newest first; once one is past idle_timeout, so is everything below it
+    while (!backend.idle.empty()) {
+        Idle idle = std::move(backend.idle.back());
+        backend.idle.pop_back();
+
+        if (now - idle.since >= config_.idle_timeout) {
+            backend.idle.clear();
+            break;
+        }
+        if (stillOpen(idle.socket)) {
+            lease.socket = std::move(idle.socket);
+            lease.reused = true;
+            break;
+        }
+    }
+
+    return lease;
+}
+
+void Upstream::release(Lease& lease, bool ok, bool keep, Clock::time_point now) {
+    std::optional<net::Socket> closing = std::exchange(lease.socket, std::nullopt);
+
+    std::lock_guard lock(mutex_);
+    auto& backend = backends_[lease.backend];
+    --backend.outstanding;
+
+    if (ok) {
+        if (down(backend)) {
+            utils::logInfo("Upstream {} is back", config_.backends[lease.backend]);
+        }
+        backend.failures = 0;
+    } else if (++backend.failures >= config_.max_failures) {
+        backend.retry_at = now + config_.retry_interval;
+        if (backend.failures == config_.max_failures) {
+            utils::logWarn("Upstream {} marked down after {} failures", config_.backends[lease.backend], backend.failures);
+        }
+    }
+
+    if (ok && keep && closing && backend.idle.size() < config_.max_idle) {
+        backend.idle.push_back(Idle{std::move(*closing), now});
+    }
+}
+
+size_t Upstream::outstanding(size_t backend) const {
+    std::lock_guard lock(mutex_);
+    return backends_[backend].outstanding;
+}
+
+bool Upstream::healthy(size_t backend) const {
+    std::lock_guard lock(mutex_);
+    return !down(backends_[backend]);
+}
+
+} // namespace frqs::core
@@ -0,0 +1,99 @@
+/**
+ * @file http/canned_response.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Immutable pre-serialized responses
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "http/canned_response.hpp"
+
+namespace frqs::http {
+
+CannedResponse::CannedResponse(const HTTPResponse& response)
+    : status_(response.getStatus())
+{
+    constexpr std::array<std::string_view, 3> CONNECTION{
+        "",
+        "Connection: close\r\n",
+        "Connection: keep-alive\r\n"
+    } ;
+
+    std::string wire = response.build() ;
+    size_t status_line = wire.find("\r\n") + 2 ;
+
+    for (size_t i = 0 ; i < wire_.size() ; ++i) {
+        wire_[i].reserve(wire.size() + CONNECTION[i].size()) ;
+        wire_[i].append(wire, 0, status_line).append(CONNECTION[i]).append(wire, status_line) ;
+        head_size_[i] = wire_[i].find("\r\n\r\n") + 4 ;
+    }
+}
+
+std::string_view CannedResponse::wire(Persistence persistence, bool head_only) const noexcept {
+    auto index = static_cast<size_t>(persistence) ;
+    std::string_view wire = wire_[index] ;
+    return head_only ? wire.substr(0, head_size_[index]) : wire ;
+}
+
+const CannedResponse& CannedResponse::badRequest() {
+    static const CannedResponse response(HTTPResponse().badRequest()) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::forbidden() {
+    static const CannedResponse response(HTTPResponse().forbidden()) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::notFound() {
+    static const CannedResponse response(HTTPResponse().notFound()) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::methodNotAllowed() {
+    static const CannedResponse response(HTTPResponse()
+        .setStatus(405)
+        .setHeader("Allow", "GET, HEAD")
+        .setBody("<h1>405 - Method Not Allowed</h1>")
+        .setContentType("text/html")) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::requestTimeout() {
+    static const CannedResponse response(HTTPResponse().setStatus(408)) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::payloadTooLarge() {
+    static const CannedResponse response(HTTPResponse()
+        .setStatus(413)
+        .setBody("<h1>413 - Payload Too Large</h1>")
+        .setContentType("text/html")) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::headersTooLarge() {
+    static const CannedResponse response(HTTPResponse()
+        .setStatus(431)
+        .setBody("<h1>431 - Request Header Fields Too Large</h1>")
+        .setContentType("text/html")) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::internalError() {
+    static const CannedResponse response(HTTPResponse().internalError()) ;
+    return response ;
+}
+
+const CannedResponse& CannedResponse::notImplemented() {
+    static const CannedResponse response(HTTPResponse()
+        .setStatus(501)
+        .setBody("<h1>501 - Not Implemented</h1>")
+        .setContentType("text/html")) ;
+    return response ;
+}
+
+} // namespace frqs::http
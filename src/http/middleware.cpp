@@ -0,0 +1,62 @@
+/**
+ * @file http/middleware.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Compile-time and runtime middleware chains
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "http/middleware.hpp"
+#include <string>
+#include <string_view>
+
+namespace frqs::http {
+
+MiddlewareChain& MiddlewareChain::use(Layer layer) {
+    layers_.push_back(std::move(layer)) ;
+    return *this ;
+}
+
+MiddlewareChain::Handler MiddlewareChain::wrap(Handler handler) const {
+    auto chain = std::make_shared<const Next::Chain>(Next::Chain{layers_, std::move(handler)}) ;
+    return [chain](const HTTPRequest& request) {
+        return Next(chain.get(), 0)(request) ;
+    } ;
+}
+
+void Cors::decorate(HTTPResponse& response) const {
+    response.setHeader("Access-Control-Allow-Origin", origin) ;
+    if (origin == "*") {
+        return ;
+    }
+
+    // Keep whatever the handler already varies on
+    auto vary = response.getHeader("Vary") ;
+    if (!vary || vary->empty()) {
+        response.setHeader("Vary", "Origin") ;
+    } else if (!containsToken(*vary, "Origin") && !containsToken(*vary, "*")) {
+        response.setHeader("Vary", std::string(*vary) + ", Origin") ;
+    }
+}
+
+bool BearerAuth::authorized(const HTTPRequest& request) const noexcept {
+    constexpr std::string_view SCHEME = "Bearer " ;
+
+    auto header = request.getHeader("Authorization") ;
+    if (!header || !header->starts_with(SCHEME) || token.empty()) {
+        return false ;
+    }
+
+    // Compare every byte so the time taken does not reveal the prefix matched
+    std::string_view presented = header->substr(SCHEME.size()) ;
+    unsigned char diff = presented.size() == token.size() ? 0 : 1 ;
+    for (size_t i = 0 ; i < token.size() ; ++i) {
+        diff |= static_cast<unsigned char>(token[i] ^ (i < presented.size() ? presented[i] : 0)) ;
+    }
+    return diff == 0 ;
+}
+
+} // namespace frqs::http
@@ -0,0 +1,277 @@
+/**
+ * @file http/proxy.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Message rewriting and framing for the reverse proxy
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "http/proxy.hpp"
+#include "http/request.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+namespace frqs::http {
+
+namespace {
+    // Calls on_header(line, name, value) for each header line of a head
+    // whose first line has been cut off
+    template <typename F>
+    void forEachHeader(std::string_view headers, F&& on_header) {
+        while (!headers.empty()) {
+            size_t end = headers.find('\n') ;
+            auto line = headers.substr(0, end) ;
+            headers = end == std::string_view::npos ? std::string_view{} : headers.substr(end + 1) ;
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1) ;
+            }
+            if (line.empty()) {
+                break ;
+            }
+
+            size_t colon = line.find(':') ;
+            if (colon == std::string_view::npos || colon == 0) {
+                throw std::runtime_error("Malformed header line") ;
+            }
+            on_header(line, line.substr(0, colon), trim(line.substr(colon + 1))) ;
+        }
+    }
+
+    // Connection: close, foo  names more headers to drop
+    bool namedByConnection(std::string_view connection, std::string_view name) noexcept {
+        return !connection.empty() && containsToken(connection, name) ;
+    }
+}
+
+bool isHopByHop(std::string_view name) noexcept {
+    static constexpr std::array<std::string_view, 9> HOP_BY_HOP = {
+        "Connection", "Keep-Alive", "Proxy-Connection", "Proxy-Authorization",
+        "TE", "Trailer", "Transfer-Encoding", "Upgrade", "Expect"
+    } ;
+    return std::ranges::any_of(HOP_BY_HOP, [name](std::string_view hop) { return equalsIgnoreCase(name, hop) ; }) ;
+}
+
+std::string forwardRequestHead(std::string_view raw_head, uint64_t body_size, std::string_view client_ip) {
+    size_t line_end = raw_head.find("\r\n") ;
+    if (line_end == std::string_view::npos) {
+        throw std::runtime_error("Malformed request line") ;
+    }
+
+    // Method and target as received, version pinned to HTTP/1.1
+    auto request_line = raw_head.substr(0, line_end) ;
+    size_t version = request_line.rfind(' ') ;
+    if (version == std::string_view::npos) {
+        throw std::runtime_error("Malformed request line") ;
+    }
+
+    auto headers = raw_head.substr(line_end + 2) ;
+    std::string_view connection ;
+    std::string_view forwarded_for ;
+    bool had_length = false ;
+    forEachHeader(headers, [&](std::string_view, std::string_view name, std::string_view value) {
+        if (equalsIgnoreCase(name, "Connection")) {
+            connection = value ;
+        } else if (equalsIgnoreCase(name, "X-Forwarded-For")) {
+            forwarded_for = value ;
+        } else if (equalsIgnoreCase(name, "Content-Length")) {
+            had_length = true ;
+        }
+    }) ;
+
+    std::string head ;
+    head.reserve(raw_head.size() + client_ip.size() + 64) ;
+    head.append(request_line.substr(0, version)).append(" HTTP/1.1\r\n") ;
+
+    forEachHeader(headers, [&](std::string_view line, std::string_view name, std::string_view) {
+        if (isHopByHop(name) || namedByConnection(connection, name) || equalsIgnoreCase(name, "X-Forwarded-For")
+            || equalsIgnoreCase(name, "Content-Length")) {
+            return ;
+        }
+        head.append(line).append("\r\n") ;
+    }) ;
+
+    if (body_size != 0 || had_length) {
+        std::format_to(std::back_inserter(head), "Content-Length: {}\r\n", body_size) ;
+    }
+
+    head.append("X-Forwarded-For: ") ;
+    if (!forwarded_for.empty()) {
+        head.append(forwarded_for).append(", ") ;
+    }
+    head.append(client_ip).append("\r\n\r\n") ;
+    return head ;
+}
+
+std::optional<UpstreamResponse> UpstreamResponse::parse(std::string_view data, bool head_request) {
+    size_t end = data.find("\r\n\r\n") ;
+    if (end == std::string_view::npos) {
+        return std::nullopt ;
+    }
+
+    UpstreamResponse response ;
+    response.head_size = end + 4 ;
+
+    auto raw = data.substr(0, end) ;
+    size_t line_end = raw.find("\r\n") ;
+    auto status_line = raw.substr(0, line_end) ;
+    auto headers = line_end == std::string_view::npos ? std::string_view{} : raw.substr(line_end + 2) ;
+
+    // HTTP/1.x SP 3DIGIT [SP reason]
+    if (status_line.size() < 12 || !status_line.starts_with("HTTP/1.") || status_line[8] != ' ') {
+        throw std::runtime_error("Malformed status line") ;
+    }
+    auto code = status_line.substr(9, 3) ;
+    if (std::from_chars(code.data(), code.data() + code.size(), response.status).ec != std::errc{}
+        || response.status < 100 || response.status > 999) {
+        throw std::runtime_error("Malformed status code") ;
+    }
+
+    bool http11 = status_line[7] == '1' ;
+    std::string_view connection ;
+    std::string& transfer_encoding = response.transfer_encoding ;
+    std::optional<uint64_t> content_length ;
+
+    forEachHeader(headers, [&](std::string_view, std::string_view name, std::string_view value) {
+        if (equalsIgnoreCase(name, "Connection")) {
+            connection = value ;
+        } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+            // Repeated fields form one list (RFC 9110 5.3)
+            if (!transfer_encoding.empty()) {
+                transfer_encoding += ", " ;
+            }
+            transfer_encoding += value ;
+        } else if (equalsIgnoreCase(name, "Content-Length")) {
+            uint64_t length = 0 ;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), length) ;
+            if (ec != std::errc{} || ptr != value.data() + value.size()
+                || (content_length && *content_length != length)) {
+                throw std::runtime_error("Malformed Content-Length") ;
+            }
+            content_length = length ;
+        }
+    }) ;
+
+    // Transfer-Encoding overrides Content-Length (RFC 9112 6.3), so a length
+    // sent alongside it must not reach the client
+    bool drop_length = !transfer_encoding.empty() ;
+
+    response.head.reserve(raw.size()) ;
+    response.head.append(status_line) ;
+    forEachHeader(headers, [&](std::string_view line, std::string_view name, std::string_view) {
+        if (isHopByHop(name) || namedByConnection(connection, name)
+            || (drop_length && equalsIgnoreCase(name, "Content-Length"))) {
+            return ;
+        }
+        response.head.append("\r\n").append(line) ;
+    }) ;
+
+    bool no_body = head_request || response.status < 200 || response.status == 204 || response.status == 304 ;
+    if (no_body) {
+        response.body = Body::NONE ;
+    } else if (!transfer_encoding.empty()) {
+        // Chunked must be the final coding; anything else runs to close
+        std::string_view last = transfer_encoding ;
+        bool chunked = equalsIgnoreCase(trim(last.substr(last.rfind(',') + 1)), "chunked") ;
+        response.body = chunked ? Body::CHUNKED : Body::UNTIL_CLOSE ;
+    } else if (content_length) {
+        response.body = Body::LENGTH ;
+        response.content_length = *content_length ;
+    } else {
+        response.body = Body::UNTIL_CLOSE ;
+    }
+
+    bool wants_close = containsToken(connection, "close") ;
+    bool wants_keep = containsToken(connection, "keep-alive") ;
+    response.reusable = response.body != Body::UNTIL_CLOSE && (http11 ? !wants_close : wants_keep) ;
+    return response ;
+}
+
+ChunkedDecoder::Step ChunkedDecoder::next(std::string_view input) {
+    Step step ;
+
+    while (step.consumed < input.size() && state_ != State::DONE) {
+        char c = input[step.consumed] ;
+
+        switch (state_) {
+            case State::SIZE: {
+                int digit = c >= '0' && c <= '9' ? c - '0'
+                          : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                          : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                          : -1 ;
+                if (digit >= 0) {
+                    if (++digits_ > 15) {
+                        throw std::runtime_error("Chunk size too large") ;
+                    }
+                    remaining_ = remaining_ * 16 + static_cast<uint64_t>(digit) ;
+                    ++step.consumed ;
+                    break ;
+                }
+                if (digits_ == 0) {
+                    throw std::runtime_error("Malformed chunk size") ;
+                }
+                state_ = State::EXTENSION ;
+                break ;
+            }
+
+            case State::EXTENSION:
+                ++step.consumed ;
+                if (c == '\n') {
+                    digits_ = 0 ;
+                    state_ = remaining_ == 0 ? State::TRAILER : State::DATA ;
+                }
+                break ;
+
+            case State::DATA: {
+                // At most one payload span per step
+                size_t take = static_cast<size_t>(std::min<uint64_t>(remaining_, input.size() - step.consumed)) ;
+                step.payload = input.substr(step.consumed, take) ;
+                step.consumed += take ;
+                remaining_ -= take ;
+                if (remaining_ == 0) {
+                    state_ = State::DATA_END ;
+                }
+                return step ;
+            }
+
+            case State::DATA_END:
+                ++step.consumed ;
+                if (c == '\n') {
+                    state_ = State::SIZE ;
+                } else if (c != '\r') {
+                    throw std::runtime_error("Missing CRLF after chunk data") ;
+                }
+                break ;
+
+            case State::TRAILER:
+                ++step.consumed ;
+                if (c == '\n') {
+                    state_ = State::DONE ;
+                } else if (c != '\r') {
+                    state_ = State::TRAILER_LINE ;
+                }
+                break ;
+
+            case State::TRAILER_LINE:
+                ++step.consumed ;
+                if (c == '\n') {
+                    state_ = State::TRAILER ;
+                }
+                break ;
+
+            case State::DONE:
+                break ;
+        }
+    }
+
+    return step ;
+}
+
+} // namespace frqs::http
@@ -15,6 +15,12 @@
 
 namespace frqs::http {
 
+HTTPRequest::HTTPRequest(allocator_type allocator)
+    : raw_request_(allocator)
+    , headers_(allocator)
+    , query_params_(allocator)
+{}
+
 bool HTTPRequest::parse(std::string_view raw_data) noexcept {
     // Security: Check size limit
     if (raw_data.size() > MAX_REQUEST_SIZE) {
@@ -22,8 +28,10 @@ bool HTTPRequest::parse(std::string_view raw_data) noexcept {
         return false ;
     }
     
-    // Store the raw request (this is the ONLY allocation)
+    // Store the raw request, and size the header table once instead of
+    // rehashing as headers arrive
     raw_request_ = raw_data ;
+    headers_.reserve(16) ;
     
     // Now work with views into raw_request_
     std::string_view view = raw_request_ ;
@@ -173,14 +181,7 @@ void HTTPRequest::parseQueryString() noexcept {
 
 std::optional<std::string_view> HTTPRequest::getHeader(std::string_view name) const noexcept {
     auto it = std::find_if(headers_.begin(), headers_.end(),
-        [name](const auto& pair) {
-            return std::equal(pair.first.begin(), pair.first.end(),
-                             name.begin(), name.end(),
-                             [](char a, char b) {
-                                 return std::tolower(static_cast<unsigned char>(a)) == 
-                                        std::tolower(static_cast<unsigned char>(b)) ;
-                             }) ;
-        }) ;
+        [name](const auto& pair) { return equalsIgnoreCase(pair.first, name) ; }) ;
     
     if (it != headers_.end()) {
         return it->second ;
@@ -196,6 +197,20 @@ std::optional<std::string_view> HTTPRequest::getQueryParam(std::string_view name
     return std::nullopt ;
 }
 
+std::optional<std::string_view> HTTPRequest::getParam(std::string_view name) const noexcept {
+    for (const auto& param : getParams()) {
+        if (param.name == name) {
+            return param.value ;
+        }
+    }
+    return std::nullopt ;
+}
+
+void HTTPRequest::setParams(std::span<const Param> params) noexcept {
+    param_count_ = std::min(params.size(), MAX_PARAMS) ;
+    std::copy_n(params.begin(), param_count_, params_.begin()) ;
+}
+
 size_t HTTPRequest::CaseInsensitiveHash::operator()(std::string_view sv) const noexcept {
     size_t hash = 0 ;
     for (char c : sv) {
@@ -205,6 +220,10 @@ size_t HTTPRequest::CaseInsensitiveHash::operator()(std::string_view sv) const n
 }
 
 bool HTTPRequest::CaseInsensitiveEqual::operator()(std::string_view a, std::string_view b) const noexcept {
+    return equalsIgnoreCase(a, b) ;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
     return std::equal(a.begin(), a.end(), b.begin(), b.end(),
         [](char ca, char cb) {
             return std::tolower(static_cast<unsigned char>(ca)) == 
@@ -212,4 +231,23 @@ bool HTTPRequest::CaseInsensitiveEqual::operator()(std::string_view a, std::stri
         }) ;
 }
 
+std::string_view trim(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1) ;
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1) ;
+    return text ;
+}
+
+bool containsToken(std::string_view list, std::string_view token) noexcept {
+    while (!list.empty()) {
+        auto comma = list.find(',') ;
+        auto item = trim(list.substr(0, comma)) ;
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1) ;
+        
+        if (equalsIgnoreCase(item, token)) {
+            return true ;
+        }
+    }
+    return false ;
+}
+
 } // namespace frqs::http
\ No newline at end of file
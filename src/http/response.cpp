@@ -10,25 +10,62 @@
  */
 
 #include "http/response.hpp"
-#include <sstream>
+#include "http/request.hpp"
+#include <algorithm>
+#include <charconv>
 
 namespace frqs::http {
 
+HTTPResponse::HTTPResponse(allocator_type allocator)
+    : status_message_("OK", allocator)
+    , body_(allocator)
+    , headers_(allocator)
+{}
+
+HTTPResponse::HTTPResponse(const HTTPResponse& other)
+    : status_code_(other.status_code_)
+    , status_message_(other.status_message_, other.get_allocator())
+    , body_(other.body_, other.get_allocator())
+    , headers_(other.headers_, other.get_allocator())
+{}
+
 HTTPResponse& HTTPResponse::setStatus(uint16_t code, std::string_view message) {
     status_code_ = code;
-    status_message_ = message.empty() ? 
-        std::string(getDefaultStatusMessage(code)) : 
-        std::string(message);
+    status_message_ = message.empty() ? getDefaultStatusMessage(code) : message;
     return *this;
 }
 
+HTTPResponse::Header* HTTPResponse::findHeader(std::string_view name) noexcept {
+    for (auto& header : headers_) {
+        if (equalsIgnoreCase(header.first, name)) {
+            return &header;
+        }
+    }
+    return nullptr;
+}
+
+const HTTPResponse::Header* HTTPResponse::findHeader(std::string_view name) const noexcept {
+    return const_cast<HTTPResponse*>(this)->findHeader(name);
+}
+
 HTTPResponse& HTTPResponse::setHeader(std::string_view name, std::string_view value) {
-    headers_[std::string(name)] = value;
+    if (auto* header = findHeader(name)) {
+        header->second = value;
+    } else {
+        headers_.emplace_back(name, value);
+    }
     return *this;
 }
 
-HTTPResponse& HTTPResponse::setBody(std::string body) {
-    body_ = std::move(body);
+std::optional<std::string_view> HTTPResponse::getHeader(std::string_view name) const noexcept {
+    if (const auto* header = findHeader(name)) {
+        return header->second;
+    }
+    return std::nullopt;
+}
+
+HTTPResponse& HTTPResponse::setBody(std::string_view body) {
+    body_ = body;
     return *this;
 }
 
@@ -36,80 +73,80 @@ HTTPResponse& HTTPResponse::setContentType(std::string_view type) {
     return setHeader("Content-Type", type);
 }
 
-HTTPResponse& HTTPResponse::ok(std::string body) {
+HTTPResponse& HTTPResponse::ok(std::string_view body) {
     setStatus(200, "OK");
     if (!body.empty()) {
-        setBody(std::move(body));
+        setBody(body);
     }
     return *this;
 }
 
-HTTPResponse& HTTPResponse::notFound(std::string body) {
+HTTPResponse& HTTPResponse::notFound(std::string_view body) {
     setStatus(404, "Not Found");
-    if (body.empty()) {
-        body = "<html><body><h1>404 - Not Found</h1></body></html>";
-    }
-    setBody(std::move(body));
+    setBody(body.empty() ? "<html><body><h1>404 - Not Found</h1></body></html>" : body);
     setContentType("text/html");
     return *this;
 }
 
-HTTPResponse& HTTPResponse::badRequest(std::string body) {
+HTTPResponse& HTTPResponse::badRequest(std::string_view body) {
     setStatus(400, "Bad Request");
-    if (body.empty()) {
-        body = "<html><body><h1>400 - Bad Request</h1></body></html>";
-    }
-    setBody(std::move(body));
+    setBody(body.empty() ? "<html><body><h1>400 - Bad Request</h1></body></html>" : body);
     setContentType("text/html");
     return *this;
 }
 
-HTTPResponse& HTTPResponse::internalError(std::string body) {
+HTTPResponse& HTTPResponse::internalError(std::string_view body) {
     setStatus(500, "Internal Server Error");
-    if (body.empty()) {
-        body = "<html><body><h1>500 - Internal Server Error</h1></body></html>";
-    }
-    setBody(std::move(body));
+    setBody(body.empty() ? "<html><body><h1>500 - Internal Server Error</h1></body></html>" : body);
     setContentType("text/html");
     return *this;
 }
 
-HTTPResponse& HTTPResponse::forbidden(std::string body) {
+HTTPResponse& HTTPResponse::forbidden(std::string_view body) {
     setStatus(403, "Forbidden");
-    if (body.empty()) {
-        body = "<html><body><h1>403 - Forbidden</h1></body></html>";
-    }
-    setBody(std::move(body));
+    setBody(body.empty() ? "<html><body><h1>403 - Forbidden</h1></body></html>" : body);
     setContentType("text/html");
     return *this;
 }
 
 std::string HTTPResponse::build() const {
-    std::ostringstream oss;
+    std::string out;
+    buildInto(out);
+    return out;
+}
+
+void HTTPResponse::buildInto(std::string& out, std::string_view headers) const {
+    // Always frame the body (even when empty) so the connection can be reused
+    bool bodyless = status_code_ < 200 || status_code_ == 204 || status_code_ == 304;
+    bool frame = !bodyless && !findHeader("Content-Length");
+    
+    size_t size = 32 + status_message_.size() + headers.size() + body_.size();
+    for (const auto& [name, value] : headers_) {
+        size += name.size() + value.size() + 4;
+    }
+    out.reserve(out.size() + size);
+    
+    char digits[24];
+    auto number = [&digits](uint64_t value) {
+        return std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    };
     
     // Status line
-    oss << "HTTP/1.1 " << status_code_ << " " << status_message_ << "\r\n";
+    out.append("HTTP/1.1 ").append(number(status_code_)).append(" ").append(status_message_).append("\r\n");
+    out.append(headers);
     
-    // Add Content-Length if not already set
-    bool has_content_length = headers_.contains("Content-Length");
-    if (!has_content_length && !body_.empty()) {
-        oss << "Content-Length: " << body_.size() << "\r\n";
+    if (frame) {
+        out.append("Content-Length: ").append(number(body_.size())).append("\r\n");
     }
     
     // Headers
     for (const auto& [name, value] : headers_) {
-        oss << name << ": " << value << "\r\n";
-    }
-    
-    // End of headers
-    oss << "\r\n";
-    
-    // Body
-    if (!body_.empty()) {
-        oss << body_;
+        out.append(name).append(": ").append(value).append("\r\n");
     }
     
-    return oss.str();
+    // End of headers, then the body
+    out.append("\r\n");
+    out.append(body_);
 }
 
 std::string_view HTTPResponse::getDefaultStatusMessage(uint16_t code) noexcept {
@@ -125,10 +162,15 @@ std::string_view HTTPResponse::getDefaultStatusMessage(uint16_t code) noexcept {
         case 403: return "Forbidden";
         case 404: return "Not Found";
         case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
         case 500: return "Internal Server Error";
         case 501: return "Not Implemented";
         case 502: return "Bad Gateway";
         case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
         default: return "Unknown";
     }
 }
@@ -0,0 +1,257 @@
+/**
+ * @file http/router.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Radix tree request router with path parameters
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "http/router.hpp"
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+namespace frqs::http {
+
+Router::Router() {
+    nodes_.emplace_back() ;
+}
+
+size_t Router::add(Method method, std::string_view pattern, Handler handler) {
+    return add(std::span<const Method>(&method, 1), pattern, std::move(handler)) ;
+}
+
+size_t Router::add(std::span<const Method> methods, std::string_view pattern, Handler handler) {
+    uint8_t mask = 0 ;
+    for (Method method : methods) {
+        if (method == Method::UNKNOWN) {
+            throw std::runtime_error(std::format("Route {}: unknown method", pattern)) ;
+        }
+        mask |= static_cast<uint8_t>(1u << static_cast<size_t>(method)) ;
+    }
+    if (mask == 0) {
+        throw std::runtime_error(std::format("Route {}: no methods", pattern)) ;
+    }
+    if (!pattern.starts_with('/')) {
+        throw std::runtime_error(std::format("Route {}: pattern must start with '/'", pattern)) ;
+    }
+
+    uint32_t node = 0 ;
+    size_t params = 0 ;
+    std::string_view rest = pattern ;
+
+    while (!rest.empty()) {
+        if (rest.front() == ':' || rest.front() == '*') {
+            bool wildcard = rest.front() == '*' ;
+            size_t end = rest.find('/') ;
+            auto name = rest.substr(1, end == std::string_view::npos ? std::string_view::npos : end - 1) ;
+
+            if (name.empty()) {
+                throw std::runtime_error(std::format("Route {}: unnamed parameter", pattern)) ;
+            }
+            if (wildcard && end != std::string_view::npos) {
+                throw std::runtime_error(std::format("Route {}: wildcard must be the last segment", pattern)) ;
+            }
+            if (++params > HTTPRequest::MAX_PARAMS) {
+                throw std::runtime_error(std::format("Route {}: more than {} parameters", pattern, HTTPRequest::MAX_PARAMS)) ;
+            }
+
+            node = paramChild(node, name, wildcard) ;
+            rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end) ;
+            continue ;
+        }
+
+        auto literal = rest.substr(0, rest.find_first_of(":*")) ;
+        if (literal.size() < rest.size() && !literal.ends_with('/')) {
+            throw std::runtime_error(std::format("Route {}: parameters must start a segment", pattern)) ;
+        }
+
+        node = literalChild(node, literal) ;
+        rest.remove_prefix(literal.size()) ;
+    }
+
+    // Every method is checked before any is taken, so a conflict adds nothing
+    std::string name ;
+    for (size_t index = 0 ; index < METHOD_COUNT ; ++index) {
+        if (!(mask & (1u << index))) {
+            continue ;
+        }
+        auto method = methodToString(static_cast<Method>(index)) ;
+        if (nodes_[node].routes[index] != NONE) {
+            throw std::runtime_error(std::format("Route {} {} registered twice", method, pattern)) ;
+        }
+        if (!name.empty()) {
+            name += ',' ;
+        }
+        name += method ;
+    }
+    if (mask == ALL_METHODS) {
+        name = "ANY" ;
+    }
+
+    routes_.push_back(Route{std::format("{} {}", name, pattern), std::move(handler)}) ;
+    for (size_t index = 0 ; index < METHOD_COUNT ; ++index) {
+        if (mask & (1u << index)) {
+            nodes_[node].routes[index] = static_cast<uint32_t>(routes_.size() - 1) ;
+        }
+    }
+    nodes_[node].allowed |= mask ;
+    return routes_.size() - 1 ;
+}
+
+uint32_t Router::literalChild(uint32_t node, std::string_view literal) {
+    // nodes_ may grow below, so nodes are re-indexed rather than held by reference
+    while (!literal.empty()) {
+        size_t pos = nodes_[node].indices.find(literal.front()) ;
+
+        if (pos == std::string::npos) {
+            auto child = static_cast<uint32_t>(nodes_.size()) ;
+            nodes_.emplace_back().prefix = literal ;
+            nodes_[node].indices.push_back(literal.front()) ;
+            nodes_[node].children.push_back(child) ;
+            return child ;
+        }
+
+        uint32_t child = nodes_[node].children[pos] ;
+        const std::string& prefix = nodes_[child].prefix ;
+        size_t common = static_cast<size_t>(
+            std::mismatch(prefix.begin(), prefix.end(), literal.begin(), literal.end()).first - prefix.begin()) ;
+
+        // Diverges inside the edge: split it, the shared head becomes a new node
+        if (common < prefix.size()) {
+            auto head = static_cast<uint32_t>(nodes_.size()) ;
+            nodes_.emplace_back() ;
+            nodes_[head].prefix = nodes_[child].prefix.substr(0, common) ;
+            nodes_[head].indices.push_back(nodes_[child].prefix[common]) ;
+            nodes_[head].children.push_back(child) ;
+            nodes_[child].prefix.erase(0, common) ;
+            nodes_[node].children[pos] = head ;
+            child = head ;
+        }
+
+        node = child ;
+        literal.remove_prefix(common) ;
+    }
+
+    return node ;
+}
+
+uint32_t Router::paramChild(uint32_t node, std::string_view name, bool wildcard) {
+    uint32_t existing = wildcard ? nodes_[node].wildcard : nodes_[node].param ;
+    if (existing != NONE) {
+        if (nodes_[existing].name != name) {
+            throw std::runtime_error(std::format("Route parameter '{}' conflicts with '{}' at the same position",
+                                                 name, nodes_[existing].name)) ;
+        }
+        return existing ;
+    }
+
+    auto child = static_cast<uint32_t>(nodes_.size()) ;
+    nodes_.emplace_back().name = name ;
+    (wildcard ? nodes_[node].wildcard : nodes_[node].param) = child ;
+    return child ;
+}
+
+uint32_t Router::find(uint32_t node, std::string_view path, Match& match) const noexcept {
+    const Node& current = nodes_[node] ;
+
+    if (path.empty()) {
+        if (current.allowed != 0) {
+            return node ;
+        }
+        if (current.wildcard != NONE) {
+            match.params[match.param_count++] = {nodes_[current.wildcard].name, path} ;
+            return current.wildcard ;
+        }
+        return NONE ;
+    }
+
+    // Literal edges first. Fan-out is small, a plain scan beats memchr.
+    for (size_t pos = 0 ; pos < current.indices.size() ; ++pos) {
+        if (current.indices[pos] != path.front()) {
+            continue ;
+        }
+        uint32_t child = current.children[pos] ;
+        const std::string& prefix = nodes_[child].prefix ;
+        if (path.starts_with(prefix)) {
+            if (uint32_t found = find(child, path.substr(prefix.size()), match) ; found != NONE) {
+                return found ;
+            }
+        }
+        break ;
+    }
+
+    // Then one segment as a parameter
+    if (current.param != NONE) {
+        size_t length = std::min(path.find('/'), path.size()) ;
+        if (length > 0) {
+            size_t saved = match.param_count ;
+            match.params[match.param_count++] = {nodes_[current.param].name, path.substr(0, length)} ;
+            if (uint32_t found = find(current.param, path.substr(length), match) ; found != NONE) {
+                return found ;
+            }
+            match.param_count = saved ;
+        }
+    }
+
+    // Finally the rest of the path
+    if (current.wildcard != NONE) {
+        match.params[match.param_count++] = {nodes_[current.wildcard].name, path} ;
+        return current.wildcard ;
+    }
+
+    return NONE ;
+}
+
+Router::Match Router::match(Method method, std::string_view path) const noexcept {
+    Match result ;
+    if (routes_.empty()) {
+        return result ;
+    }
+
+    uint32_t node = find(0, path, result) ;
+    if (node == NONE) {
+        result.param_count = 0 ;
+        return result ;
+    }
+
+    const Node& matched = nodes_[node] ;
+    auto index = static_cast<size_t>(method) ;
+    uint32_t route = index < METHOD_COUNT ? matched.routes[index] : NONE ;
+    if (route == NONE && method == Method::HEAD) {
+        route = matched.routes[static_cast<size_t>(Method::GET)] ;
+    }
+
+    result.allowed = matched.allowed ;
+    if (route == NONE) {
+        result.path_found = true ;
+        return result ;
+    }
+
+    result.handler = &routes_[route].handler ;
+    result.route = route ;
+    return result ;
+}
+
+std::string Router::allowHeader(uint8_t allowed) {
+    // GET implies HEAD
+    if (allowed & (1u << static_cast<size_t>(Method::GET))) {
+        allowed |= static_cast<uint8_t>(1u << static_cast<size_t>(Method::HEAD)) ;
+    }
+
+    std::string header ;
+    for (size_t i = 0 ; i < METHOD_COUNT ; ++i) {
+        if (allowed & (1u << i)) {
+            if (!header.empty()) {
+                header += ", " ;
+            }
+            header += methodToString(static_cast<Method>(i)) ;
+        }
+    }
+    return header ;
+}
+
+} // namespace frqs::http
@@ -2,17 +2,48 @@
 #include <iostream>
 #include <fstream>
 #include <csignal>
+#include <cstdlib>
+#include <condition_variable>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace {
     frqs::core::Server* g_server = nullptr ;
+    frqs::core::Prefork* g_prefork = nullptr ;
+    volatile std::sig_atomic_t g_stop_signal = 0 ;
 
+    // Runs on whichever thread the signal lands on, possibly inside the
+    // logger or malloc, so nothing here logs or allocates
     void signalHandler(int signal) {
-        if (signal == SIGINT || signal == SIGTERM) {
-            frqs::utils::logInfo("Received shutdown signal, stopping server...") ;
-            if (g_server) {
-                g_server->stop() ;
+        if (signal != SIGINT && signal != SIGTERM) {
+            return ;
+        }
+        g_stop_signal = signal ;
+        if (g_server) {
+            // start() returns and main() logs the shutdown
+            g_server->requestStop() ;
+        } else if (g_prefork) {
+            // The master may be inside the logger or malloc; stop() only
+            // stores a flag and sends signals, and run() logs once it returns
+            g_prefork->stop() ;
+        }
+    }
+    
+    // "0,2,4" -> {0, 2, 4}
+    std::vector<int> parseCpus(const char* list) {
+        std::vector<int> cpus ;
+        for (const char* p = list ; *p ; ) {
+            char* end = nullptr ;
+            long cpu = std::strtol(p, &end, 10) ;
+            if (end == p) {
+                break ;
             }
+            cpus.push_back(static_cast<int>(cpu)) ;
+            p = *end == ',' ? end + 1 : end ;
         }
+        return cpus ;
     }
 }
 
@@ -23,6 +54,13 @@ int main(int argc, char* argv[]) {
         // Enable file logging
         utils::enableFileLogging("zhttp_server.log") ;
         
+        // Runtime log threshold (info, warn, error)
+        if (const char* level_env = std::getenv("ZHTTP_LOG_LEVEL")) {
+            if (auto level = utils::parseLevel(level_env)) {
+                utils::setLogLevel(*level) ;
+            }
+        }
+        
         utils::logInfo("=== ZHTTP Server v1.0.0 ===") ;
         utils::logInfo("High-Performance C++23 HTTP Server") ;
         
@@ -55,7 +93,7 @@ int main(int argc, char* argv[]) {
         // Create document root if it doesn't exist
         if (!std::filesystem::exists(doc_root)) {
             std::filesystem::create_directories(doc_root) ;
-            utils::logInfo("Created document root directory: " + doc_root.string()) ;
+            utils::logInfo("Created document root directory: {}", doc_root) ;
             
             // Create a default index.html
             std::ofstream index(doc_root / "index.html") ;
@@ -107,9 +145,175 @@ int main(int argc, char* argv[]) {
             }
         }
         
+        // Listener socket options: a named profile, then single overrides
+        net::SocketProfile profile = net::SocketProfile::latency() ;
+        if (const char* name = std::getenv("ZHTTP_SOCKET_PROFILE"); name && std::string_view(name) == "throughput") {
+            profile = net::SocketProfile::throughput() ;
+        }
+        {
+            auto setting = [](const char* name, auto& field) {
+                if (const char* value = std::getenv(name)) {
+                    field = static_cast<std::remove_reference_t<decltype(field)>>(std::strtol(value, nullptr, 10)) ;
+                }
+            } ;
+            setting("ZHTTP_TCP_NODELAY", profile.no_delay) ;
+            setting("ZHTTP_TCP_CORK", profile.cork) ;
+            setting("ZHTTP_DEFER_ACCEPT", profile.defer_accept) ;
+            setting("ZHTTP_FAST_OPEN", profile.fast_open) ;
+            setting("ZHTTP_SNDBUF", profile.send_buffer) ;
+            setting("ZHTTP_RCVBUF", profile.receive_buffer) ;
+            setting("ZHTTP_BUSY_POLL", profile.busy_poll) ;
+            setting("ZHTTP_PREFER_BUSY_POLL", profile.prefer_busy_poll) ;
+        }
+        
+        std::vector<int> cpus ;
+        if (const char* cpu_list = std::getenv("ZHTTP_CPUS")) {
+            cpus = parseCpus(cpu_list) ;
+        }
+        
+        // Prefork: this process becomes the master of N worker processes
+        // (0 = one per CPU, pinned round-robin to ZHTTP_CPUS), and only the
+        // workers go on to build a server. SO_REUSEPORT listeners unless
+        // ZHTTP_REUSEPORT=0.
+        std::optional<core::Prefork> prefork ;
+        if (const char* workers = std::getenv("ZHTTP_WORKERS")) {
+            core::PreforkConfig prefork_config ;
+            prefork_config.workers = std::strtoul(workers, nullptr, 10) ;
+            prefork_config.threads = thread_count ;
+            prefork_config.listener = profile ;
+            prefork_config.cpus = std::exchange(cpus, {}) ;
+            if (const char* reuse_port = std::getenv("ZHTTP_REUSEPORT")) {
+                prefork_config.reuse_port = std::strtol(reuse_port, nullptr, 10) != 0 ;
+            }
+            
+            prefork.emplace(port, std::move(prefork_config)) ;
+            g_prefork = &*prefork ;
+            std::signal(SIGINT, signalHandler) ;
+            std::signal(SIGTERM, signalHandler) ;
+            
+            if (!prefork->run()) {
+                utils::logInfo("Server shutdown complete") ;
+                return 0 ;
+            }
+        }
+        
         // Create and configure server
         core::Server server(port, thread_count) ;
         server.setDocumentRoot(doc_root) ;
+        server.setSocketProfile(profile) ;
+        
+        // Prometheus metrics endpoint
+        if (const char* metrics_path = std::getenv("ZHTTP_METRICS_PATH")) {
+            server.enableMetrics(metrics_path) ;
+        }
+        
+        // Chrome trace of sampled (1 in N) and slow requests
+        if (const char* trace_file = std::getenv("ZHTTP_TRACE_FILE")) {
+            utils::trace::TracerConfig trace_config ;
+            trace_config.output = trace_file ;
+            if (const char* sample = std::getenv("ZHTTP_TRACE_SAMPLE")) {
+                trace_config.sample_every = static_cast<uint32_t>(std::strtoul(sample, nullptr, 10)) ;
+            }
+            server.enableTracing(std::move(trace_config)) ;
+        }
+        
+        // Busy polling for dedicated cores: idle milliseconds before backing
+        // off to blocking, and an optional CPU list (event loop first; in
+        // prefork mode the list pins processes instead)
+        if (const char* idle = std::getenv("ZHTTP_BUSY_POLLING")) {
+            core::BusyPollConfig busy_poll ;
+            busy_poll.idle_timeout = std::chrono::milliseconds(std::strtoul(idle, nullptr, 10)) ;
+            busy_poll.cpus = cpus ;
+            server.enableBusyPolling(std::move(busy_poll)) ;
+        }
+        
+        // Admission control: connection/queue limits and CoDel target delay
+        {
+            core::AdmissionConfig admission ;
+            if (const char* max_conn = std::getenv("ZHTTP_MAX_CONNECTIONS")) {
+                admission.max_connections = std::strtoul(max_conn, nullptr, 10) ;
+            }
+            if (const char* max_queue = std::getenv("ZHTTP_MAX_QUEUE")) {
+                admission.max_queued = std::strtoul(max_queue, nullptr, 10) ;
+            }
+            if (const char* delay = std::getenv("ZHTTP_QUEUE_DELAY_MS")) {
+                admission.target_delay = std::chrono::milliseconds(std::strtoul(delay, nullptr, 10)) ;
+            }
+            if (const char* action = std::getenv("ZHTTP_OVERLOAD"); action && std::string_view(action) == "pause") {
+                admission.on_max_connections = core::OverloadAction::PAUSE_ACCEPT ;
+            }
+            server.setAdmissionConfig(admission) ;
+        }
+        
+        // Per-client rate limit: requests per second and burst
+        if (const char* rate = std::getenv("ZHTTP_RATE_LIMIT")) {
+            core::RateLimitConfig rate_limit ;
+            rate_limit.rate = std::strtod(rate, nullptr) ;
+            if (const char* burst = std::getenv("ZHTTP_RATE_BURST")) {
+                rate_limit.burst = static_cast<uint32_t>(std::strtoul(burst, nullptr, 10)) ;
+            }
+            server.setRateLimit(rate_limit) ;
+        }
+        
+        // CIDR access list, reloaded when the file changes
+        std::jthread acl_watcher ;
+        if (const char* acl_path = std::getenv("ZHTTP_ACL")) {
+            const char* acl_default = std::getenv("ZHTTP_ACL_DEFAULT") ;
+            bool default_allow = !(acl_default && std::string_view(acl_default) == "deny") ;
+            
+            std::filesystem::path path(acl_path) ;
+            server.setAccessList(net::AccessList::load(path, default_allow)) ;
+            
+            acl_watcher = std::jthread([&server, path, default_allow](std::stop_token stop) {
+                std::mutex mutex ;
+                std::condition_variable_any wakeup ;
+                std::error_code ec ;
+                auto loaded = std::filesystem::last_write_time(path, ec) ;
+                
+                std::unique_lock<std::mutex> lock(mutex) ;
+                while (!wakeup.wait_for(lock, stop, std::chrono::seconds(1), [&stop] { return stop.stop_requested() ; })) {
+                    auto modified = std::filesystem::last_write_time(path, ec) ;
+                    if (ec || modified == loaded) {
+                        continue ;
+                    }
+                    loaded = modified ;
+                    
+                    // A bad file keeps the previous list in force
+                    try {
+                        server.setAccessList(net::AccessList::load(path, default_allow)) ;
+                    } catch (const std::exception& e) {
+                        utils::logError("Access list reload failed: {}", e.what()) ;
+                    }
+                }
+            }) ;
+        }
+        
+        // Reverse proxy everything under a prefix to a list of backends
+        if (const char* upstream = std::getenv("ZHTTP_UPSTREAM")) {
+            core::UpstreamConfig upstream_config ;
+            upstream_config.backends = core::Upstream::parseBackends(upstream) ;
+            
+            std::string prefix = "/" ;
+            if (const char* proxy_prefix = std::getenv("ZHTTP_PROXY_PREFIX")) {
+                prefix = proxy_prefix ;
+                if (!prefix.ends_with('/')) {
+                    prefix += '/' ;
+                }
+            }
+            server.proxy(prefix + "*rest", std::make_shared<core::Upstream>(std::move(upstream_config))) ;
+        }
+        
+        // Binary access log (decode with zhttp_access_decode)
+        if (const char* access_dir = std::getenv("ZHTTP_ACCESS_LOG")) {
+            utils::AccessLogConfig access_config ;
+            access_config.directory = access_dir ;
+            server.enableAccessLog(std::move(access_config)) ;
+        }
+        
+        // Listener and shared counters from the prefork master
+        if (prefork) {
+            prefork->attach(server) ;
+        }
         
         g_server = &server ;
         
@@ -120,10 +324,13 @@ int main(int argc, char* argv[]) {
         // Start server (blocks until stopped)
         server.start() ;
         
+        if (g_stop_signal) {
+            utils::logInfo("Received shutdown signal {}, server stopped", static_cast<int>(g_stop_signal)) ;
+        }
         utils::logInfo("Server shutdown complete") ;
         
     } catch (const std::exception& e) {
-        utils::logError("Fatal error: " + std::string(e.what())) ;
+        utils::logError("Fatal error: {}", e.what()) ;
         return 1 ;
     }
     
@@ -0,0 +1,216 @@
+#include "net/access_list.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace frqs::net {
+
+namespace {
+    using Verdict = AccessList::Verdict ;
+
+    constexpr uint32_t CHILD = 0x8000'0000u ;
+
+    std::string_view trim(std::string_view s) noexcept {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\r')) s.remove_prefix(1) ;
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1) ;
+        return s ;
+    }
+
+    bool parseNumber(std::string_view text, uint32_t max, uint32_t& out) noexcept {
+        if (text.empty() || text.size() > 3) {
+            return false ;
+        }
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), out) ;
+        return ec == std::errc{} && ptr == text.data() + text.size() && out <= max ;
+    }
+
+    // Uncompressed levels used while rules are applied in prefix order
+    struct Builder {
+        std::vector<uint32_t> top = std::vector<uint32_t>(65536, 0) ;
+        std::vector<std::array<uint32_t, 256>> middle ;
+        std::vector<std::array<uint8_t, 256>> bottom ;
+
+        std::array<uint32_t, 256>& middleFor(uint32_t address) {
+            uint32_t& entry = top[address >> 16] ;
+            if ((entry & CHILD) == 0) {
+                std::array<uint32_t, 256> fresh ;
+                fresh.fill(entry) ;
+                middle.push_back(fresh) ;
+                entry = CHILD | static_cast<uint32_t>(middle.size() - 1) ;
+            }
+            return middle[entry & ~CHILD] ;
+        }
+
+        std::array<uint8_t, 256>& bottomFor(uint32_t address) {
+            uint32_t& entry = middleFor(address)[(address >> 8) & 0xFF] ;
+            if ((entry & CHILD) == 0) {
+                std::array<uint8_t, 256> fresh ;
+                fresh.fill(static_cast<uint8_t>(entry)) ;
+                bottom.push_back(fresh) ;
+                entry = CHILD | static_cast<uint32_t>(bottom.size() - 1) ;
+            }
+            return bottom[entry & ~CHILD] ;
+        }
+
+        // Rules arrive shortest prefix first, so a range never contains a
+        // child node yet when it is overwritten
+        void apply(uint32_t network, uint8_t prefix, Verdict verdict) {
+            auto value = static_cast<uint32_t>(verdict) ;
+            if (prefix <= 16) {
+                auto first = top.begin() + (network >> 16) ;
+                std::fill(first, first + (size_t{1} << (16 - prefix)), value) ;
+            } else if (prefix <= 24) {
+                auto& entries = middleFor(network) ;
+                auto first = entries.begin() + ((network >> 8) & 0xFF) ;
+                std::fill(first, first + (size_t{1} << (24 - prefix)), value) ;
+            } else {
+                auto& entries = bottomFor(network) ;
+                auto first = entries.begin() + (network & 0xFF) ;
+                std::fill(first, first + (size_t{1} << (32 - prefix)), static_cast<uint8_t>(value)) ;
+            }
+        }
+    } ;
+
+    template <typename Entry>
+    void packLeaves(const std::array<Entry, 256>& entries, uint64_t (&bits)[8]) noexcept {
+        for (uint32_t i = 0 ; i < 256 ; ++i) {
+            uint64_t verdict = (entries[i] & CHILD) ? 0 : (entries[i] & 3) ;
+            bits[i >> 5] |= verdict << ((i & 31) * 2) ;
+        }
+    }
+}
+
+AccessList::AccessList(std::span<const Rule> rules, bool default_allow)
+    : rule_count_(rules.size())
+    , default_allow_(default_allow)
+{
+    std::vector<Rule> sorted(rules.begin(), rules.end()) ;
+    for (auto& rule : sorted) {
+        rule.prefix = std::min<uint8_t>(rule.prefix, 32) ;
+        rule.network &= IPv4::mask(rule.prefix) ;
+    }
+
+    // Shorter prefixes first so longer ones overwrite them; deny last on ties
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Rule& a, const Rule& b) {
+        return a.prefix != b.prefix ? a.prefix < b.prefix : a.verdict < b.verdict ;
+    }) ;
+
+    Builder builder ;
+    for (const auto& rule : sorted) {
+        if (rule.verdict != Verdict::NONE) {
+            builder.apply(rule.network.toUint32(), rule.prefix, rule.verdict) ;
+        }
+    }
+
+    // Compress: middle nodes keep a bitmap of their children, which are
+    // laid out contiguously in bottom_
+    top_ = std::move(builder.top) ;
+    middle_.resize(builder.middle.size()) ;
+
+    for (size_t m = 0 ; m < builder.middle.size() ; ++m) {
+        const auto& entries = builder.middle[m] ;
+        Middle& node = middle_[m] ;
+        packLeaves(entries, node.leaves.bits) ;
+
+        for (uint32_t i = 0 ; i < 256 ; ++i) {
+            if ((i & 63) == 0) {
+                node.base[i >> 6] = static_cast<uint32_t>(bottom_.size()) ;
+            }
+            if (entries[i] & CHILD) {
+                node.children[i >> 6] |= uint64_t{1} << (i & 63) ;
+                Leaves& leaves = bottom_.emplace_back() ;
+                packLeaves(builder.bottom[entries[i] & ~CHILD], leaves.bits) ;
+            }
+        }
+    }
+}
+
+std::optional<AccessList::Rule> AccessList::parseCidr(std::string_view text) noexcept {
+    Rule rule ;
+
+    if (auto slash = text.find('/') ; slash != std::string_view::npos) {
+        uint32_t prefix = 0 ;
+        if (!parseNumber(text.substr(slash + 1), 32, prefix)) {
+            return std::nullopt ;
+        }
+        rule.prefix = static_cast<uint8_t>(prefix) ;
+        text = text.substr(0, slash) ;
+    }
+
+    uint32_t address = 0 ;
+    for (int octet = 0 ; octet < 4 ; ++octet) {
+        size_t dot = text.find('.') ;
+        if ((octet < 3) == (dot == std::string_view::npos)) {
+            return std::nullopt ;
+        }
+
+        uint32_t value = 0 ;
+        if (!parseNumber(text.substr(0, dot), 255, value)) {
+            return std::nullopt ;
+        }
+        address = (address << 8) | value ;
+        text = dot == std::string_view::npos ? std::string_view{} : text.substr(dot + 1) ;
+    }
+
+    rule.network = IPv4(address) & IPv4::mask(rule.prefix) ;
+    return rule ;
+}
+
+std::vector<AccessList::Rule> AccessList::parse(std::string_view text) {
+    std::vector<Rule> rules ;
+    size_t line_number = 0 ;
+
+    while (!text.empty()) {
+        size_t eol = text.find('\n') ;
+        std::string_view line = text.substr(0, eol) ;
+        text = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1) ;
+        ++line_number ;
+
+        line = trim(line.substr(0, line.find_first_of("#;"))) ;
+        if (line.empty()) {
+            continue ;
+        }
+
+        Verdict verdict = Verdict::DENY ;
+        if (size_t space = line.find_first_of(" \t") ; space != std::string_view::npos) {
+            auto keyword = line.substr(0, space) ;
+            if (keyword == "allow") {
+                verdict = Verdict::ALLOW ;
+            } else if (keyword != "deny") {
+                throw std::runtime_error(std::format("Access list line {}: unknown action '{}'", line_number, keyword)) ;
+            }
+            line = trim(line.substr(space)) ;
+        }
+
+        auto rule = parseCidr(line) ;
+        if (!rule) {
+            throw std::runtime_error(std::format("Access list line {}: invalid CIDR '{}'", line_number, line)) ;
+        }
+        rule->verdict = verdict ;
+        rules.push_back(*rule) ;
+    }
+
+    return rules ;
+}
+
+std::shared_ptr<const AccessList> AccessList::load(const std::filesystem::path& path, bool default_allow) {
+    std::ifstream file(path, std::ios::binary) ;
+    if (!file) {
+        throw std::runtime_error(std::format("Cannot open access list {}", path.string())) ;
+    }
+
+    std::ostringstream contents ;
+    contents << file.rdbuf() ;
+    auto rules = parse(contents.str()) ;
+    return std::make_shared<const AccessList>(rules, default_allow) ;
+}
+
+size_t AccessList::memoryUsage() const noexcept {
+    return top_.size() * sizeof(uint32_t) + middle_.size() * sizeof(Middle) + bottom_.size() * sizeof(Leaves) ;
+}
+
+} // namespace frqs::net
@@ -0,0 +1,258 @@
+/**
+ * @file net/poller.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "net/poller.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <errno.h>
+#elif !defined(_WIN32)
+    #include <fcntl.h>
+    #include <errno.h>
+#endif
+
+namespace frqs::net {
+
+#if defined(__linux__)
+
+namespace {
+    uint32_t toEpoll(uint32_t interest) noexcept {
+        uint32_t events = 0 ;
+        if (interest & Poller::READABLE) events |= EPOLLIN ;
+        if (interest & Poller::WRITABLE) events |= EPOLLOUT ;
+        return events ;
+    }
+}
+
+Poller::Poller() {
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC) ;
+    if (epoll_fd_ < 0) {
+        throw std::runtime_error("epoll_create1 failed") ;
+    }
+
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) ;
+    if (wake_fd_ < 0) {
+        ::close(epoll_fd_) ;
+        throw std::runtime_error("eventfd failed") ;
+    }
+
+    epoll_event ev{} ;
+    ev.events = EPOLLIN ;
+    ev.data.ptr = nullptr ;   // Reserved for the wakeup
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev) ;
+}
+
+Poller::~Poller() {
+    ::close(wake_fd_) ;
+    ::close(epoll_fd_) ;
+}
+
+void Poller::add(handle_t handle, uint32_t interest, void* data) {
+    epoll_event ev{} ;
+    ev.events = toEpoll(interest) ;
+    ev.data.ptr = data ;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, handle, &ev) < 0) {
+        throw std::runtime_error("epoll_ctl add failed") ;
+    }
+}
+
+void Poller::modify(handle_t handle, uint32_t interest, void* data) {
+    epoll_event ev{} ;
+    ev.events = toEpoll(interest) ;
+    ev.data.ptr = data ;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, handle, &ev) < 0) {
+        throw std::runtime_error("epoll_ctl modify failed") ;
+    }
+}
+
+void Poller::remove(handle_t handle) noexcept {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, handle, nullptr) ;
+}
+
+size_t Poller::wait(std::span<Event> events, int timeout_ms) {
+    epoll_event raw[256] ;
+    int capacity = static_cast<int>(std::min<size_t>(events.size(), std::size(raw))) ;
+
+    int ready = ::epoll_wait(epoll_fd_, raw, capacity, timeout_ms) ;
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0 ;
+        }
+        throw std::runtime_error("epoll_wait failed") ;
+    }
+
+    size_t count = 0 ;
+    for (int i = 0 ; i < ready ; ++i) {
+        if (raw[i].data.ptr == nullptr) {
+            drainWake() ;
+            continue ;
+        }
+
+        uint32_t out = 0 ;
+        if (raw[i].events & EPOLLIN) out |= READABLE ;
+        if (raw[i].events & EPOLLOUT) out |= WRITABLE ;
+        if (raw[i].events & (EPOLLHUP | EPOLLERR)) out |= CLOSED ;
+        events[count++] = Event{raw[i].data.ptr, out} ;
+    }
+    return count ;
+}
+
+void Poller::wake() noexcept {
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        uint64_t one = 1 ;
+        [[maybe_unused]] auto n = ::write(wake_fd_, &one, sizeof(one)) ;
+    }
+}
+
+void Poller::drainWake() noexcept {
+    uint64_t value ;
+    [[maybe_unused]] auto n = ::read(wake_fd_, &value, sizeof(value)) ;
+    wake_pending_.store(false, std::memory_order_release) ;
+}
+
+#else // poll() / WSAPoll()
+
+namespace {
+    short toPoll(uint32_t interest) noexcept {
+        short events = 0 ;
+        if (interest & Poller::READABLE) events |= POLLIN ;
+        if (interest & Poller::WRITABLE) events |= POLLOUT ;
+        return events ;
+    }
+}
+
+Poller::Poller() {
+#ifndef _WIN32
+    if (::pipe(wake_pipe_) < 0) {
+        throw std::runtime_error("pipe failed") ;
+    }
+    for (int fd : wake_pipe_) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK) ;
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC) ;
+    }
+    fds_.push_back(pollfd_t{wake_pipe_[0], POLLIN, 0}) ;
+    data_.push_back(nullptr) ;
+#endif
+}
+
+Poller::~Poller() {
+#ifndef _WIN32
+    ::close(wake_pipe_[0]) ;
+    ::close(wake_pipe_[1]) ;
+#endif
+}
+
+void Poller::add(handle_t handle, uint32_t interest, void* data) {
+    if (index_.contains(handle)) {
+        throw std::runtime_error("Handle already registered") ;
+    }
+    index_[handle] = fds_.size() ;
+    fds_.push_back(pollfd_t{handle, toPoll(interest), 0}) ;
+    data_.push_back(data) ;
+}
+
+void Poller::modify(handle_t handle, uint32_t interest, void* data) {
+    auto it = index_.find(handle) ;
+    if (it == index_.end()) {
+        throw std::runtime_error("Handle not registered") ;
+    }
+    fds_[it->second].events = toPoll(interest) ;
+    data_[it->second] = data ;
+}
+
+void Poller::remove(handle_t handle) noexcept {
+    auto it = index_.find(handle) ;
+    if (it == index_.end()) {
+        return ;
+    }
+
+    // Swap with the last entry to keep the arrays dense
+    size_t slot = it->second ;
+    size_t last = fds_.size() - 1 ;
+    if (slot != last) {
+        fds_[slot] = fds_[last] ;
+        data_[slot] = data_[last] ;
+        index_[fds_[slot].fd] = slot ;
+    }
+    fds_.pop_back() ;
+    data_.pop_back() ;
+    index_.erase(it) ;
+}
+
+size_t Poller::wait(std::span<Event> events, int timeout_ms) {
+#ifdef _WIN32
+    // No portable wakeup handle for WSAPoll; bound the wait instead so
+    // wake() is noticed within a few milliseconds
+    if (timeout_ms < 0 || timeout_ms > 5) {
+        timeout_ms = 5 ;
+    }
+    if (fds_.empty()) {
+        ::Sleep(static_cast<DWORD>(timeout_ms)) ;
+        wake_pending_.store(false, std::memory_order_release) ;
+        return 0 ;
+    }
+    int ready = ::WSAPoll(fds_.data(), static_cast<ULONG>(fds_.size()), timeout_ms) ;
+    wake_pending_.store(false, std::memory_order_release) ;
+#else
+    int ready = ::poll(fds_.data(), fds_.size(), timeout_ms) ;
+    if (ready < 0 && errno == EINTR) {
+        return 0 ;
+    }
+#endif
+    if (ready < 0) {
+        throw std::runtime_error("poll failed") ;
+    }
+
+    size_t count = 0 ;
+    for (size_t i = 0 ; i < fds_.size() && ready > 0 && count < events.size() ; ++i) {
+        auto revents = fds_[i].revents ;
+        if (revents == 0) {
+            continue ;
+        }
+        --ready ;
+
+        if (data_[i] == nullptr) {
+            drainWake() ;
+            continue ;
+        }
+
+        uint32_t out = 0 ;
+        if (revents & POLLIN) out |= READABLE ;
+        if (revents & POLLOUT) out |= WRITABLE ;
+        if (revents & (POLLHUP | POLLERR | POLLNVAL)) out |= CLOSED ;
+        events[count++] = Event{data_[i], out} ;
+    }
+    return count ;
+}
+
+void Poller::wake() noexcept {
+#ifndef _WIN32
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+        char one = 1 ;
+        [[maybe_unused]] auto n = ::write(wake_pipe_[1], &one, 1) ;
+    }
+#endif
+}
+
+void Poller::drainWake() noexcept {
+#ifndef _WIN32
+    char buffer[64] ;
+    while (::read(wake_pipe_[0], buffer, sizeof(buffer)) > 0) {}
+    wake_pending_.store(false, std::memory_order_release) ;
+#endif
+}
+
+#endif
+
+} // namespace frqs::net
@@ -10,17 +10,69 @@
  */
 
 #include "net/socket.hpp"
+#include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <string>
 
 #ifdef _WIN32
     #include <ws2tcpip.h>
 #else
     #include <errno.h>
+    #include <fcntl.h>
     #include <netinet/in.h>
 #endif
 
 namespace frqs::net {
 
+namespace {
+    // Peers closing early must surface as an error, not SIGPIPE
+#ifdef MSG_NOSIGNAL
+    constexpr int SEND_FLAGS = MSG_NOSIGNAL ;
+#else
+    constexpr int SEND_FLAGS = 0 ;
+#endif
+
+    // True for errors that only mean "try again later"
+    bool retryLater() noexcept {
+#ifdef _WIN32
+        int err = ::WSAGetLastError() ;
+        return err == WSAEWOULDBLOCK || err == WSAEINTR ;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR ;
+#endif
+    }
+    
+    bool connectInProgress() noexcept {
+#ifdef _WIN32
+        return ::WSAGetLastError() == WSAEWOULDBLOCK ;
+#else
+        return errno == EINPROGRESS || errno == EINTR ;
+#endif
+    }
+
+    std::error_code lastError() noexcept {
+#ifdef _WIN32
+        return {::WSAGetLastError(), std::system_category()} ;
+#else
+        return {errno, std::system_category()} ;
+#endif
+    }
+
+    bool interrupted() noexcept {
+#ifdef _WIN32
+        return ::WSAGetLastError() == WSAEINTR ;
+#else
+        return errno == EINTR ;
+#endif
+    }
+
+    // What the try* calls throw for errors the nothrow forms return
+    std::runtime_error failure(const char* what, const std::error_code& error) {
+        return std::runtime_error(std::string(what) + ": " + error.message()) ;
+    }
+}
+
 NetworkInit::NetworkInit() {
 #ifdef _WIN32
     WSADATA wsaData ;
@@ -107,7 +159,7 @@ Socket Socket::accept(SockAddr* out_client_addr) {
 
 size_t Socket::send(const void* data, size_t size) {
     auto sent = ::send(handle_, static_cast<const char*>(data), 
-                       static_cast<int>(size), 0) ;
+                       static_cast<int>(size), SEND_FLAGS) ;
     if (sent < 0) {
         throw std::runtime_error("Send failed") ;
     }
@@ -134,6 +186,296 @@ std::vector<char> Socket::receive(size_t max_size) {
     return buffer ;
 }
 
+void Socket::setNonBlocking(bool enabled) {
+#ifdef _WIN32
+    u_long mode = enabled ? 1 : 0 ;
+    if (::ioctlsocket(handle_, FIONBIO, &mode) != 0) {
+        throw std::runtime_error("Failed to set non-blocking mode") ;
+    }
+#else
+    int flags = ::fcntl(handle_, F_GETFL, 0) ;
+    if (flags < 0) {
+        throw std::runtime_error("Failed to get socket flags") ;
+    }
+    flags = enabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK) ;
+    if (::fcntl(handle_, F_SETFL, flags) != 0) {
+        throw std::runtime_error("Failed to set non-blocking mode") ;
+    }
+#endif
+}
+
+bool Socket::startConnect(const SockAddr& addr) {
+    auto native_addr = addr.native() ;
+    if (::connect(handle_, reinterpret_cast<const sockaddr*>(&native_addr), 
+                  sizeof(native_addr)) == 0) {
+        return true ;
+    }
+    if (connectInProgress()) {
+        return false ;
+    }
+    throw std::runtime_error("Connect failed") ;
+}
+
+void Socket::finishConnect() {
+    int error = 0 ;
+    socklen_t len = sizeof(error) ;
+    if (::getsockopt(handle_, SOL_SOCKET, SO_ERROR, 
+                     reinterpret_cast<char*>(&error), &len) != 0 || error != 0) {
+        throw std::runtime_error("Connect failed") ;
+    }
+}
+
+std::optional<size_t> Socket::trySend(const void* data, size_t size) {
+    auto sent = send(std::nothrow, data, size) ;
+    if (!sent) {
+        if (net::wouldBlock(sent.error())) {
+            return std::nullopt ;
+        }
+        throw failure("Send failed", sent.error()) ;
+    }
+    return *sent ;
+}
+
+std::optional<size_t> Socket::trySend(std::string_view data) {
+    return trySend(data.data(), data.size()) ;
+}
+
+std::optional<size_t> Socket::tryReceive(void* buffer, size_t size) {
+    auto received = receive(std::nothrow, buffer, size) ;
+    if (!received) {
+        if (net::wouldBlock(received.error())) {
+            return std::nullopt ;
+        }
+        throw failure("Receive failed", received.error()) ;
+    }
+    return *received ;
+}
+
+std::optional<Socket> Socket::tryAccept(SockAddr* out_client_addr) {
+    SockAddr::native_t client_native{} ;
+    socklen_t len = sizeof(client_native) ;
+    
+    native_handle_t client_fd = ::accept(
+        handle_, 
+        reinterpret_cast<sockaddr*>(&client_native), 
+        &len
+    ) ;
+    
+    if (client_fd == invalid_handle) {
+#ifndef _WIN32
+        // The peer gave up while queued; nothing to accept
+        if (errno == ECONNABORTED) {
+            return std::nullopt ;
+        }
+#endif
+        if (retryLater()) {
+            return std::nullopt ;
+        }
+        throw std::runtime_error("Accept failed") ;
+    }
+    
+    if (out_client_addr) {
+        *out_client_addr = SockAddr(client_native) ;
+    }
+    
+    return Socket(client_fd) ;
+}
+
+Expected<Socket> Socket::accept(std::nothrow_t, SockAddr* out_client_addr) noexcept {
+    SockAddr::native_t client_native{} ;
+    native_handle_t client_fd = invalid_handle ;
+    
+    do {
+        socklen_t len = sizeof(client_native) ;
+#if defined(__linux__)
+        client_fd = ::accept4(
+            handle_, 
+            reinterpret_cast<sockaddr*>(&client_native), 
+            &len, 
+            SOCK_NONBLOCK | SOCK_CLOEXEC
+        ) ;
+#else
+        client_fd = ::accept(
+            handle_, 
+            reinterpret_cast<sockaddr*>(&client_native), 
+            &len
+        ) ;
+#endif
+    } while (client_fd == invalid_handle && interrupted()) ;
+    
+    if (client_fd == invalid_handle) {
+        return std::unexpected(lastError()) ;
+    }
+    
+    Socket client(client_fd) ;
+#if !defined(__linux__)
+    if (auto blocking = client.setNonBlocking(std::nothrow) ; !blocking) {
+        return std::unexpected(blocking.error()) ;
+    }
+#ifndef _WIN32
+    ::fcntl(client_fd, F_SETFD, FD_CLOEXEC) ;
+#endif
+#endif
+    
+    if (out_client_addr) {
+        *out_client_addr = SockAddr(client_native) ;
+    }
+    
+    return client ;
+}
+
+Expected<size_t> Socket::send(std::nothrow_t, const void* data, size_t size, bool more) noexcept {
+    int flags = SEND_FLAGS ;
+#ifdef MSG_MORE
+    if (more) {
+        flags |= MSG_MORE ;
+    }
+#else
+    (void)more ;
+#endif
+    for (;;) {
+        auto sent = ::send(handle_, static_cast<const char*>(data), 
+                           static_cast<int>(size), flags) ;
+        if (sent >= 0) {
+            return static_cast<size_t>(sent) ;
+        }
+        if (!interrupted()) {
+            return std::unexpected(lastError()) ;
+        }
+    }
+}
+
+Expected<size_t> Socket::send(std::nothrow_t, std::string_view data, bool more) noexcept {
+    return send(std::nothrow, data.data(), data.size(), more) ;
+}
+
+Expected<size_t> Socket::send(std::nothrow_t, std::span<const std::string_view> parts) noexcept {
+    parts = parts.first(std::min(parts.size(), MAX_PARTS)) ;
+    
+#ifdef _WIN32
+    std::array<WSABUF, MAX_PARTS> buffers ;
+    for (size_t i = 0 ; i < parts.size() ; ++i) {
+        buffers[i].buf = const_cast<char*>(parts[i].data()) ;
+        buffers[i].len = static_cast<ULONG>(parts[i].size()) ;
+    }
+    for (;;) {
+        DWORD sent = 0 ;
+        if (::WSASend(handle_, buffers.data(), static_cast<DWORD>(parts.size()), &sent, 0, nullptr, nullptr) == 0) {
+            return static_cast<size_t>(sent) ;
+        }
+        if (!interrupted()) {
+            return std::unexpected(lastError()) ;
+        }
+    }
+#else
+    std::array<iovec, MAX_PARTS> buffers ;
+    for (size_t i = 0 ; i < parts.size() ; ++i) {
+        buffers[i].iov_base = const_cast<char*>(parts[i].data()) ;
+        buffers[i].iov_len = parts[i].size() ;
+    }
+    msghdr message{} ;
+    message.msg_iov = buffers.data() ;
+    message.msg_iovlen = parts.size() ;
+    for (;;) {
+        auto sent = ::sendmsg(handle_, &message, SEND_FLAGS) ;
+        if (sent >= 0) {
+            return static_cast<size_t>(sent) ;
+        }
+        if (!interrupted()) {
+            return std::unexpected(lastError()) ;
+        }
+    }
+#endif
+}
+
+Expected<size_t> Socket::receive(std::nothrow_t, void* buffer, size_t size) noexcept {
+    for (;;) {
+        auto received = ::recv(handle_, static_cast<char*>(buffer), 
+                               static_cast<int>(size), 0) ;
+        if (received >= 0) {
+            return static_cast<size_t>(received) ;
+        }
+        if (!interrupted()) {
+            return std::unexpected(lastError()) ;
+        }
+    }
+}
+
+Expected<bool> Socket::connect(std::nothrow_t, const SockAddr& addr) noexcept {
+    auto native_addr = addr.native() ;
+    if (::connect(handle_, reinterpret_cast<const sockaddr*>(&native_addr), 
+                  sizeof(native_addr)) == 0) {
+        return true ;
+    }
+    // An interrupted connect carries on in the background, like EINPROGRESS
+    if (connectInProgress()) {
+        return false ;
+    }
+    return std::unexpected(lastError()) ;
+}
+
+Expected<void> Socket::finishConnect(std::nothrow_t) noexcept {
+    int error = 0 ;
+    socklen_t len = sizeof(error) ;
+    if (::getsockopt(handle_, SOL_SOCKET, SO_ERROR, 
+                     reinterpret_cast<char*>(&error), &len) != 0) {
+        return std::unexpected(lastError()) ;
+    }
+    if (error != 0) {
+        return std::unexpected(std::error_code(error, std::system_category())) ;
+    }
+    return {} ;
+}
+
+Expected<void> Socket::setNonBlocking(std::nothrow_t, bool enabled) noexcept {
+#ifdef _WIN32
+    u_long mode = enabled ? 1 : 0 ;
+    if (::ioctlsocket(handle_, FIONBIO, &mode) != 0) {
+        return std::unexpected(lastError()) ;
+    }
+#else
+    int flags = ::fcntl(handle_, F_GETFL, 0) ;
+    if (flags < 0) {
+        return std::unexpected(lastError()) ;
+    }
+    int updated = enabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK) ;
+    if (updated != flags && ::fcntl(handle_, F_SETFL, updated) != 0) {
+        return std::unexpected(lastError()) ;
+    }
+#endif
+    return {} ;
+}
+
+void Socket::setOption(int level, int name, int value) {
+    if (auto result = setOption(std::nothrow, level, name, value) ; !result) {
+        throw failure("Failed to set socket option", result.error()) ;
+    }
+}
+
+Expected<void> Socket::setOption(std::nothrow_t, int level, int name, int value) noexcept {
+    if (name < 0) {
+        return std::unexpected(std::make_error_code(std::errc::not_supported)) ;
+    }
+    if (::setsockopt(handle_, level, name, 
+                     reinterpret_cast<const char*>(&value), sizeof(value)) != 0) {
+        return std::unexpected(lastError()) ;
+    }
+    return {} ;
+}
+
+Expected<int> Socket::getOption(std::nothrow_t, int level, int name) const noexcept {
+    if (name < 0) {
+        return std::unexpected(std::make_error_code(std::errc::not_supported)) ;
+    }
+    int value = 0 ;
+    socklen_t len = sizeof(value) ;
+    if (::getsockopt(handle_, level, name, 
+                     reinterpret_cast<char*>(&value), &len) != 0) {
+        return std::unexpected(lastError()) ;
+    }
+    return value ;
+}
+
 void Socket::close() {
     if (handle_ != invalid_handle) {
 #ifdef _WIN32
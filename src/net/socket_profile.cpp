@@ -0,0 +1,70 @@
+/**
+ * @file net/socket_profile.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Named socket tuning profiles
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "net/socket_profile.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace frqs::net {
+
+namespace {
+    template <typename Option>
+    void apply(Socket& socket, const Option& option, const char* name) {
+        if constexpr (Option::supported) {
+            if (auto result = socket.set(std::nothrow, option) ; !result) {
+                throw std::runtime_error(std::string("Failed to set ") + name + ": " + result.error().message()) ;
+            }
+        }
+    }
+}
+
+SocketProfile SocketProfile::latency() {
+    SocketProfile profile ;
+    profile.defer_accept = 1 ;
+    return profile ;
+}
+
+SocketProfile SocketProfile::throughput() {
+    SocketProfile profile ;
+    profile.defer_accept = 1 ;
+    profile.send_buffer = 1 << 20 ;
+    return profile ;
+}
+
+void SocketProfile::applyListener(Socket& listener) const {
+    apply(listener, option::ReuseAddress(reuse_address), "SO_REUSEADDR") ;
+    apply(listener, option::NoDelay(no_delay), "TCP_NODELAY") ;
+    
+    if (reuse_port) {
+        apply(listener, option::ReusePort(true), "SO_REUSEPORT") ;
+    }
+
+    if (defer_accept > 0) {
+        apply(listener, option::DeferAccept(defer_accept), "TCP_DEFER_ACCEPT") ;
+    }
+    if (fast_open > 0) {
+        apply(listener, option::FastOpen(fast_open), "TCP_FASTOPEN") ;
+    }
+    if (send_buffer > 0) {
+        apply(listener, option::SendBuffer(send_buffer), "SO_SNDBUF") ;
+    }
+    if (receive_buffer > 0) {
+        apply(listener, option::ReceiveBuffer(receive_buffer), "SO_RCVBUF") ;
+    }
+    if (busy_poll > 0) {
+        apply(listener, option::BusyPoll(busy_poll), "SO_BUSY_POLL") ;
+    }
+    if (prefer_busy_poll) {
+        apply(listener, option::PreferBusyPoll(true), "SO_PREFER_BUSY_POLL") ;
+    }
+}
+
+} // namespace frqs::net
@@ -0,0 +1,262 @@
+/**
+ * @file utils/access_log.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "utils/access_log.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace frqs::utils {
+
+void AccessRecord::setPath(std::string_view p) noexcept {
+    if (p.size() > PATH_CAPACITY) {
+        p = p.substr(0, PATH_CAPACITY) ;
+        flags |= PATH_TRUNCATED ;
+    }
+    std::memcpy(path, p.data(), p.size()) ;
+    path_len = static_cast<uint8_t>(p.size()) ;
+}
+
+// Single-producer/single-consumer ring of records
+class AccessLog::Ring {
+public:
+    explicit Ring(size_t capacity)
+        : slots_(std::bit_ceil(std::max<size_t>(capacity, 2)))
+        , mask_(slots_.size() - 1) {}
+
+    bool push(const AccessRecord& record) noexcept {
+        uint64_t head = head_.load(std::memory_order_relaxed) ;
+        if (head - tail_.load(std::memory_order_acquire) >= slots_.size()) {
+            // Single writer, so a plain load/store pair is enough
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed) ;
+            return false ;
+        }
+        slots_[head & mask_] = record ;
+        head_.store(head + 1, std::memory_order_release) ;
+        return true ;
+    }
+
+    // Hands contiguous runs of pending records to sink, then releases them
+    template <typename Sink>
+    void consume(Sink&& sink) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed) ;
+        uint64_t head = head_.load(std::memory_order_acquire) ;
+        while (tail != head) {
+            size_t start = tail & mask_ ;
+            size_t count = std::min<uint64_t>(head - tail, slots_.size() - start) ;
+            sink(&slots_[start], count) ;
+            tail += count ;
+        }
+        tail_.store(tail, std::memory_order_release) ;
+    }
+
+    [[nodiscard]] uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed) ;
+    }
+
+private:
+    std::vector<AccessRecord> slots_ ;
+    size_t mask_ ;
+    alignas(64) std::atomic<uint64_t> head_{0} ;
+    alignas(64) std::atomic<uint64_t> tail_{0} ;
+    alignas(64) std::atomic<uint64_t> dropped_{0} ;
+} ;
+
+// One rotated file: header followed by a flat array of records
+class AccessLog::Segment {
+public:
+    Segment(const std::filesystem::path& path, size_t max_size)
+        : capacity_((std::max(max_size, sizeof(AccessLogHeader) + sizeof(AccessRecord))
+                     - sizeof(AccessLogHeader)) / sizeof(AccessRecord)) {
+        header_.version = ACCESS_LOG_VERSION ;
+        header_.created_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()) ;
+
+#ifdef _WIN32
+        file_.open(path, std::ios::binary | std::ios::trunc) ;
+        if (!file_) {
+            throw std::runtime_error("Failed to open access log: " + path.string()) ;
+        }
+        file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_)) ;
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) ;
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open access log: " + path.string()) ;
+        }
+        mapped_size_ = sizeof(AccessLogHeader) + capacity_ * sizeof(AccessRecord) ;
+        if (::ftruncate(fd_, static_cast<off_t>(mapped_size_)) != 0) {
+            ::close(fd_) ;
+            throw std::runtime_error("Failed to size access log: " + path.string()) ;
+        }
+        void* base = ::mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0) ;
+        if (base == MAP_FAILED) {
+            ::close(fd_) ;
+            throw std::runtime_error("Failed to map access log: " + path.string()) ;
+        }
+        base_ = static_cast<char*>(base) ;
+        std::memcpy(base_, &header_, sizeof(header_)) ;
+#endif
+    }
+
+    ~Segment() {
+#ifdef _WIN32
+        file_.seekp(0) ;
+        file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_)) ;
+#else
+        // Records appended since the last drain's commit are counted too
+        commit() ;
+        ::munmap(base_, mapped_size_) ;
+        // Trim the preallocated tail so readers see only real records
+        [[maybe_unused]] int rc = ::ftruncate(fd_, static_cast<off_t>(
+            sizeof(AccessLogHeader) + header_.record_count * sizeof(AccessRecord))) ;
+        ::close(fd_) ;
+#endif
+    }
+
+    Segment(const Segment&) = delete ;
+    Segment& operator=(const Segment&) = delete ;
+
+    [[nodiscard]] size_t remaining() const noexcept { return capacity_ - header_.record_count ; }
+
+    void append(const AccessRecord* records, size_t count) noexcept {
+#ifdef _WIN32
+        file_.write(reinterpret_cast<const char*>(records),
+                    static_cast<std::streamsize>(count * sizeof(AccessRecord))) ;
+#else
+        std::memcpy(base_ + sizeof(AccessLogHeader) + header_.record_count * sizeof(AccessRecord),
+                    records, count * sizeof(AccessRecord)) ;
+#endif
+        header_.record_count += count ;
+    }
+
+    // Publish the record count so live readers see the new records
+    void commit() noexcept {
+#ifndef _WIN32
+        std::memcpy(base_ + offsetof(AccessLogHeader, record_count),
+                    &header_.record_count, sizeof(header_.record_count)) ;
+#endif
+    }
+
+private:
+    AccessLogHeader header_ ;
+    size_t capacity_ ;
+#ifdef _WIN32
+    std::ofstream file_ ;
+#else
+    int fd_ = -1 ;
+    char* base_ = nullptr ;
+    size_t mapped_size_ = 0 ;
+#endif
+} ;
+
+AccessLog::AccessLog(AccessLogConfig config, size_t producer_count)
+    : config_(std::move(config))
+{
+    std::filesystem::create_directories(config_.directory) ;
+
+    rings_.reserve(producer_count) ;
+    for (size_t i = 0 ; i < producer_count ; ++i) {
+        rings_.push_back(std::make_unique<Ring>(config_.buffer_records)) ;
+    }
+    shared_ring_ = std::make_unique<Ring>(config_.buffer_records) ;
+
+    rotate() ;
+    flusher_ = std::thread([this] { flusherThread() ; }) ;
+}
+
+AccessLog::~AccessLog() {
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex_) ;
+        stop_ = true ;
+    }
+    flush_cv_.notify_one() ;
+    if (flusher_.joinable()) {
+        flusher_.join() ;
+    }
+}
+
+void AccessLog::record(size_t producer, const AccessRecord& record) noexcept {
+    if (producer < rings_.size()) {
+        rings_[producer]->push(record) ;
+        return ;
+    }
+
+    std::lock_guard<std::mutex> lock(shared_mutex_) ;
+    shared_ring_->push(record) ;
+}
+
+void AccessLog::flush() {
+    std::lock_guard<std::mutex> lock(flush_mutex_) ;
+    drainAll() ;
+}
+
+uint64_t AccessLog::dropped() const noexcept {
+    uint64_t total = shared_ring_->dropped() ;
+    for (const auto& ring : rings_) {
+        total += ring->dropped() ;
+    }
+    return total ;
+}
+
+void AccessLog::flusherThread() {
+    std::unique_lock<std::mutex> lock(flush_mutex_) ;
+    while (!stop_) {
+        flush_cv_.wait_for(lock, config_.flush_interval, [this] { return stop_ ; }) ;
+        drainAll() ;
+    }
+}
+
+// Caller holds flush_mutex_
+void AccessLog::drainAll() {
+    for (auto& ring : rings_) {
+        drain(*ring) ;
+    }
+    drain(*shared_ring_) ;
+    segment_->commit() ;
+}
+
+void AccessLog::drain(Ring& ring) {
+    ring.consume([this](const AccessRecord* records, size_t count) {
+        while (count > 0) {
+            if (segment_->remaining() == 0) {
+                rotate() ;
+            }
+            size_t n = std::min(count, segment_->remaining()) ;
+            segment_->append(records, n) ;
+            written_.fetch_add(n, std::memory_order_relaxed) ;
+            records += n ;
+            count -= n ;
+        }
+    }) ;
+}
+
+void AccessLog::rotate() {
+    auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count() ;
+    auto name = std::format("{}-{}-{:06}.zal", config_.prefix, stamp, segment_seq_++) ;
+
+    segment_.reset() ;
+    segment_ = std::make_unique<Segment>(config_.directory / name, config_.max_file_size) ;
+}
+
+} // namespace frqs::utils
@@ -0,0 +1,105 @@
+/**
+ * @file utils/arena.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Monotonic per-request memory resource
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "utils/arena.hpp"
+#include <new>
+
+namespace frqs::utils {
+
+namespace {
+    constexpr size_t HEADER = 32 ;   // sizeof(Block) rounded up so carving starts 32-byte aligned
+
+    std::byte* alignUp(std::byte* p, size_t alignment) noexcept {
+        auto address = reinterpret_cast<uintptr_t>(p) ;
+        return p + ((alignment - address % alignment) % alignment) ;
+    }
+}
+
+Arena::~Arena() {
+    release(head_) ;
+    release(spare_) ;
+}
+
+void Arena::release(Block* block) noexcept {
+    while (block) {
+        Block* next = block->next ;
+        ::operator delete(block) ;
+        block = next ;
+    }
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    std::byte* p = alignUp(cursor_, alignment) ;
+    if (cursor_ && p + bytes <= end_) {
+        cursor_ = p + bytes ;
+        used_ += bytes ;
+        return p ;
+    }
+    return grow(bytes, alignment) ;
+}
+
+void* Arena::grow(size_t bytes, size_t alignment) {
+    static_assert(sizeof(Block) <= HEADER) ;
+
+    size_t needed = bytes + (alignment > HEADER ? alignment : 0) ;
+    Block* block = nullptr ;
+
+    if (needed <= BLOCK_SIZE - HEADER && spare_) {
+        block = spare_ ;
+        spare_ = spare_->next ;
+    } else {
+        // Standard blocks are the ones worth keeping; a big allocation
+        // gets a block of exactly its size
+        size_t size = needed <= BLOCK_SIZE - HEADER ? BLOCK_SIZE - HEADER : needed ;
+        block = static_cast<Block*>(::operator new(HEADER + size)) ;
+        block->size = size ;
+        ++blocks_ ;
+        ++refills_ ;
+    }
+
+    block->next = head_ ;
+    head_ = block ;
+    cursor_ = reinterpret_cast<std::byte*>(block) + HEADER ;
+    end_ = cursor_ + block->size ;
+
+    std::byte* p = alignUp(cursor_, alignment) ;
+    cursor_ = p + bytes ;
+    used_ += bytes ;
+    return p ;
+}
+
+void Arena::reset() noexcept {
+    size_t retained = 0 ;
+    for (Block* block = spare_ ; block ; block = block->next) {
+        retained += HEADER + block->size ;
+    }
+
+    while (head_) {
+        Block* block = head_ ;
+        head_ = block->next ;
+
+        bool standard = block->size == BLOCK_SIZE - HEADER ;
+        if (standard && retained + BLOCK_SIZE <= MAX_RETAINED) {
+            block->next = spare_ ;
+            spare_ = block ;
+            retained += BLOCK_SIZE ;
+        } else {
+            ::operator delete(block) ;
+            --blocks_ ;
+        }
+    }
+
+    cursor_ = nullptr ;
+    end_ = nullptr ;
+    used_ = 0 ;
+}
+
+} // namespace frqs::utils
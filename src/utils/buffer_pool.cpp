@@ -0,0 +1,162 @@
+/**
+ * @file utils/buffer_pool.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Size-class pool for connection input buffers
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "utils/buffer_pool.hpp"
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace frqs::utils {
+
+namespace {
+    constexpr size_t PAGE = 4096 ;
+
+    // Index of the class holding exactly capacity, CLASSES.size() for oversized buffers
+    size_t classOf(size_t capacity) noexcept {
+        size_t index = 0 ;
+        while (index < BufferPool::CLASSES.size() && BufferPool::CLASSES[index] != capacity) {
+            ++index ;
+        }
+        return index ;
+    }
+
+    size_t capacityFor(size_t min_capacity) noexcept {
+        for (size_t size : BufferPool::CLASSES) {
+            if (size >= min_capacity) {
+                return size ;
+            }
+        }
+        return (min_capacity + PAGE - 1) / PAGE * PAGE ;
+    }
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , capacity_(std::exchange(other.capacity_, 0))
+    , pool_(std::exchange(other.pool_, nullptr))
+{}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+        reset() ;
+        data_ = std::exchange(other.data_, nullptr) ;
+        size_ = std::exchange(other.size_, 0) ;
+        capacity_ = std::exchange(other.capacity_, 0) ;
+        pool_ = std::exchange(other.pool_, nullptr) ;
+    }
+    return *this ;
+}
+
+void Buffer::consume(size_t bytes) noexcept {
+    if (bytes >= size_) {
+        reset() ;
+        return ;
+    }
+    std::memmove(data_, data_ + bytes, size_ - bytes) ;
+    size_ -= bytes ;
+}
+
+void Buffer::reset() noexcept {
+    if (data_) {
+        pool_->release(data_, capacity_) ;
+    }
+    data_ = nullptr ;
+    size_ = 0 ;
+    capacity_ = 0 ;
+    pool_ = nullptr ;
+}
+
+BufferPool::~BufferPool() {
+    for (size_t index = 0 ; index < CLASSES.size() ; ++index) {
+        while (FreeBuffer* buffer = free_[index]) {
+            free_[index] = buffer->next ;
+            delete[] reinterpret_cast<char*>(buffer) ;
+        }
+    }
+}
+
+bool BufferPool::reserve(Buffer& buffer, size_t min_capacity) {
+    if (min_capacity <= buffer.capacity_) {
+        return true ;
+    }
+
+    size_t capacity = capacityFor(min_capacity) ;
+    char* data = take(capacity) ;
+    if (!data) {
+        return false ;
+    }
+
+    if (buffer.size_ > 0) {
+        std::memcpy(data, buffer.data_, buffer.size_) ;
+    }
+    size_t size = buffer.size_ ;
+    buffer.reset() ;
+
+    buffer.data_ = data ;
+    buffer.size_ = size ;
+    buffer.capacity_ = capacity ;
+    buffer.pool_ = this ;
+    return true ;
+}
+
+char* BufferPool::take(size_t capacity) {
+    size_t index = classOf(capacity) ;
+    if (index < CLASSES.size() && free_[index]) {
+        FreeBuffer* buffer = free_[index] ;
+        free_[index] = buffer->next ;
+        cached_.store(cached() - capacity, std::memory_order_relaxed) ;
+        in_use_.store(inUse() + capacity, std::memory_order_relaxed) ;
+        return reinterpret_cast<char*>(buffer) ;
+    }
+
+    size_t total = inUse() + cached() ;
+    if (total + capacity > limit_ && !trim(total + capacity - limit_)) {
+        exhausted_.fetch_add(1, std::memory_order_relaxed) ;
+        return nullptr ;
+    }
+
+    // Not zero-filled; only received bytes are ever read
+    char* data = new char[capacity] ;
+    allocations_.fetch_add(1, std::memory_order_relaxed) ;
+    in_use_.store(inUse() + capacity, std::memory_order_relaxed) ;
+    return data ;
+}
+
+void BufferPool::release(char* data, size_t capacity) noexcept {
+    in_use_.store(inUse() - capacity, std::memory_order_relaxed) ;
+
+    size_t index = classOf(capacity) ;
+    if (index == CLASSES.size()) {
+        delete[] data ;
+        return ;
+    }
+
+    free_[index] = new (data) FreeBuffer{free_[index]} ;
+    cached_.store(cached() + capacity, std::memory_order_relaxed) ;
+}
+
+bool BufferPool::trim(size_t bytes) noexcept {
+    // Largest first, they free the most per buffer and are the rarest to reuse
+    size_t freed = 0 ;
+    for (size_t index = CLASSES.size() ; index-- > 0 && freed < bytes ; ) {
+        while (freed < bytes && free_[index]) {
+            FreeBuffer* buffer = free_[index] ;
+            free_[index] = buffer->next ;
+            delete[] reinterpret_cast<char*>(buffer) ;
+            freed += CLASSES[index] ;
+        }
+    }
+    cached_.store(cached() - freed, std::memory_order_relaxed) ;
+    return freed >= bytes ;
+}
+
+} // namespace frqs::utils
@@ -0,0 +1,130 @@
+/**
+ * @file utils/date_header.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Cached Date and Server header block
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "utils/date_header.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace frqs::utils {
+
+namespace {
+    constexpr std::string_view WEEKDAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"} ;
+    constexpr std::string_view MONTHS[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    } ;
+
+    void appendTwoDigits(std::string& out, unsigned value) {
+        out.push_back(static_cast<char>('0' + value / 10)) ;
+        out.push_back(static_cast<char>('0' + value % 10)) ;
+    }
+}
+
+DateHeader::DateHeader() {
+    publish(std::chrono::system_clock::now()) ;
+    refresher_ = std::thread([this] { run() ; }) ;
+}
+
+DateHeader::~DateHeader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_) ;
+        stop_ = true ;
+    }
+    wake_.notify_one() ;
+    if (refresher_.joinable()) {
+        refresher_.join() ;
+    }
+}
+
+void DateHeader::setServer(std::string_view server) {
+    if (server.size() > MAX_SERVER) {
+        throw std::runtime_error("Server header too long") ;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_) ;
+    server_line_.clear() ;
+    if (!server.empty()) {
+        server_line_.append("Server: ").append(server).append("\r\n") ;
+    }
+    publish(std::chrono::system_clock::now()) ;
+}
+
+std::string_view DateHeader::read(std::array<char, CAPACITY>& buffer) const noexcept {
+    uint64_t before = 0 ;
+    size_t size = 0 ;
+    do {
+        before = sequence_.load(std::memory_order_acquire) ;
+        size = size_.load(std::memory_order_relaxed) ;
+        for (size_t i = 0 ; i < (size + sizeof(uint64_t) - 1) / sizeof(uint64_t) ; ++i) {
+            uint64_t word = words_[i].load(std::memory_order_relaxed) ;
+            std::memcpy(buffer.data() + i * sizeof(uint64_t), &word, sizeof(word)) ;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire) ;
+    } while ((before & 1) != 0 || before != sequence_.load(std::memory_order_relaxed)) ;
+
+    return {buffer.data(), size} ;
+}
+
+std::string DateHeader::format(std::chrono::system_clock::time_point time) {
+    using namespace std::chrono ;
+
+    auto seconds = floor<std::chrono::seconds>(time) ;
+    auto day = floor<days>(seconds) ;
+    year_month_day date{day} ;
+    hh_mm_ss clock{seconds - day} ;
+
+    std::string out ;
+    out.reserve(29) ;
+    out.append(WEEKDAYS[weekday{day}.c_encoding()]).append(", ") ;
+    appendTwoDigits(out, static_cast<unsigned>(date.day())) ;
+    out.append(" ").append(MONTHS[static_cast<unsigned>(date.month()) - 1]).append(" ") ;
+    out.append(std::to_string(static_cast<int>(date.year()))).append(" ") ;
+    appendTwoDigits(out, static_cast<unsigned>(clock.hours().count())) ;
+    out.push_back(':') ;
+    appendTwoDigits(out, static_cast<unsigned>(clock.minutes().count())) ;
+    out.push_back(':') ;
+    appendTwoDigits(out, static_cast<unsigned>(clock.seconds().count())) ;
+    out.append(" GMT") ;
+    return out ;
+}
+
+void DateHeader::publish(std::chrono::system_clock::time_point now) {
+    std::array<char, CAPACITY> block{} ;
+    std::string line = "Date: " + format(now) + "\r\n" + server_line_ ;
+    std::memcpy(block.data(), line.data(), line.size()) ;
+
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed) ;
+    sequence_.store(sequence + 1, std::memory_order_relaxed) ;
+    std::atomic_thread_fence(std::memory_order_release) ;
+
+    for (size_t i = 0 ; i < WORDS ; ++i) {
+        uint64_t word = 0 ;
+        std::memcpy(&word, block.data() + i * sizeof(uint64_t), sizeof(word)) ;
+        words_[i].store(word, std::memory_order_relaxed) ;
+    }
+    size_.store(line.size(), std::memory_order_relaxed) ;
+
+    sequence_.store(sequence + 2, std::memory_order_release) ;
+}
+
+void DateHeader::run() {
+    std::unique_lock<std::mutex> lock(mutex_) ;
+    while (!stop_) {
+        // Just past the next second boundary, so the date turns over on time
+        auto next = std::chrono::ceil<std::chrono::seconds>(std::chrono::system_clock::now()) ;
+        if (wake_.wait_until(lock, next, [this] { return stop_ ; })) {
+            break ;
+        }
+        publish(std::max<std::chrono::system_clock::time_point>(std::chrono::system_clock::now(), next)) ;
+    }
+}
+
+} // namespace frqs::utils
@@ -107,6 +107,32 @@ std::optional<std::string> FileSystemUtils::readFile(
     }
 }
 
+bool FileSystemUtils::readFile(
+    const std::filesystem::path& path,
+    std::pmr::string& out,
+    size_t max_size
+) {
+    try {
+        auto file_size = std::filesystem::file_size(path) ;
+        if (file_size > max_size) {
+            return false ;
+        }
+        
+        std::ifstream file(path, std::ios::binary) ;
+        if (!file) {
+            return false ;
+        }
+        
+        out.resize(static_cast<size_t>(file_size)) ;
+        file.read(out.data(), static_cast<std::streamsize>(out.size())) ;
+        out.resize(static_cast<size_t>(file.gcount())) ;
+        return !file.bad() ;
+        
+    } catch (const std::exception&) {
+        return false ;
+    }
+}
+
 std::filesystem::path FileSystemUtils::normalizePath(std::string_view path) {
     std::filesystem::path result ;
     
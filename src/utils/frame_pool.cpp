@@ -0,0 +1,155 @@
+/**
+ * @file utils/frame_pool.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Size-class pool for coroutine frames
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "utils/frame_pool.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+
+namespace frqs::utils {
+
+namespace {
+    constexpr size_t CLASSES = std::countr_zero(FramePool::MAX_SIZE) - std::countr_zero(FramePool::MIN_SIZE) + 1 ;
+    constexpr uint32_t BATCH = 32 ;
+    constexpr uint32_t THREAD_CAP = 4 * BATCH ;
+    constexpr uint32_t DEPOT_CAP = 128 * BATCH ;
+
+    struct Block {
+        Block* next ;
+    } ;
+
+    constexpr size_t classOf(size_t size) noexcept {
+        return size <= FramePool::MIN_SIZE
+            ? 0
+            : static_cast<size_t>(std::bit_width(size - 1)) - std::countr_zero(FramePool::MIN_SIZE) ;
+    }
+
+    constexpr size_t classSize(size_t index) noexcept {
+        return FramePool::MIN_SIZE << index ;
+    }
+
+    struct FreeList {
+        Block* head = nullptr ;
+        uint32_t count = 0 ;
+
+        void push(Block* block) noexcept {
+            block->next = head ;
+            head = block ;
+            ++count ;
+        }
+
+        Block* pop() noexcept {
+            Block* block = head ;
+            head = block->next ;
+            --count ;
+            return block ;
+        }
+
+        // Moves up to n blocks onto other
+        void transfer(FreeList& other, uint32_t n) noexcept {
+            while (n-- > 0 && head) {
+                other.push(pop()) ;
+            }
+        }
+    } ;
+
+    struct Depot {
+        std::array<std::mutex, CLASSES> mutexes ;
+        std::array<FreeList, CLASSES> lists ;
+
+        ~Depot() {
+            for (size_t i = 0 ; i < CLASSES ; ++i) {
+                while (lists[i].head) {
+                    ::operator delete(lists[i].pop(), classSize(i)) ;
+                }
+            }
+        }
+    } ;
+
+    Depot& depot() {
+        static Depot instance ;
+        return instance ;
+    }
+
+    struct ThreadCache {
+        std::array<FreeList, CLASSES> lists ;
+
+        // Frames this thread kept go back for others to use
+        ~ThreadCache() {
+            auto& shared = depot() ;
+            for (size_t i = 0 ; i < CLASSES ; ++i) {
+                std::lock_guard<std::mutex> lock(shared.mutexes[i]) ;
+                lists[i].transfer(shared.lists[i], lists[i].count) ;
+            }
+        }
+    } ;
+
+    thread_local ThreadCache t_cache ;
+
+    std::atomic<uint64_t> g_allocations{0} ;
+    std::atomic<uint64_t> g_reused{0} ;
+}
+
+void* FramePool::allocate(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed) ;
+    if (size > MAX_SIZE) {
+        return ::operator new(size) ;
+    }
+
+    size_t index = classOf(size) ;
+    FreeList& local = t_cache.lists[index] ;
+
+    if (!local.head) {
+        auto& shared = depot() ;
+        std::lock_guard<std::mutex> lock(shared.mutexes[index]) ;
+        shared.lists[index].transfer(local, BATCH) ;
+    }
+
+    if (local.head) {
+        g_reused.fetch_add(1, std::memory_order_relaxed) ;
+        return local.pop() ;
+    }
+    return ::operator new(classSize(index)) ;
+}
+
+void FramePool::deallocate(void* frame, size_t size) noexcept {
+    if (size > MAX_SIZE) {
+        ::operator delete(frame, size) ;
+        return ;
+    }
+
+    size_t index = classOf(size) ;
+    FreeList& local = t_cache.lists[index] ;
+    local.push(static_cast<Block*>(frame)) ;
+
+    if (local.count > THREAD_CAP) {
+        auto& shared = depot() ;
+        std::lock_guard<std::mutex> lock(shared.mutexes[index]) ;
+        local.transfer(shared.lists[index], BATCH) ;
+
+        // Beyond the depot cap memory goes back to the system
+        while (shared.lists[index].count > DEPOT_CAP) {
+            ::operator delete(shared.lists[index].pop(), classSize(index)) ;
+        }
+    }
+}
+
+uint64_t FramePool::allocations() noexcept {
+    return g_allocations.load(std::memory_order_relaxed) ;
+}
+
+uint64_t FramePool::reused() noexcept {
+    return g_reused.load(std::memory_order_relaxed) ;
+}
+
+} // namespace frqs::utils
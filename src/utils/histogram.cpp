@@ -0,0 +1,62 @@
+/**
+ * @file utils/histogram.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "utils/histogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace frqs::utils {
+
+void Histogram::Snapshot::add(uint64_t value, uint64_t times) noexcept {
+    counts[bucketIndex(value)] += times ;
+    count += times ;
+    sum += value * times ;
+    max = std::max(max, value) ;
+}
+
+void Histogram::Snapshot::merge(const Snapshot& other) noexcept {
+    for (size_t i = 0 ; i < BUCKET_COUNT ; ++i) {
+        counts[i] += other.counts[i] ;
+    }
+    count += other.count ;
+    sum += other.sum ;
+    max = std::max(max, other.max) ;
+}
+
+uint64_t Histogram::Snapshot::percentile(double q) const noexcept {
+    if (count == 0) {
+        return 0 ;
+    }
+
+    q = std::clamp(q, 0.0, 1.0) ;
+    auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))) ;
+    rank = std::max<uint64_t>(rank, 1) ;
+
+    uint64_t seen = 0 ;
+    for (size_t i = 0 ; i < BUCKET_COUNT ; ++i) {
+        seen += counts[i] ;
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max) ;
+        }
+    }
+    return max ;
+}
+
+void Histogram::mergeInto(Snapshot& out) const noexcept {
+    for (size_t i = 0 ; i < BUCKET_COUNT ; ++i) {
+        out.counts[i] += counts_[i].load(std::memory_order_relaxed) ;
+    }
+    out.count += count_.load(std::memory_order_relaxed) ;
+    out.sum += sum_.load(std::memory_order_relaxed) ;
+    out.max = std::max(out.max, max_.load(std::memory_order_relaxed)) ;
+}
+
+} // namespace frqs::utils
@@ -13,6 +13,15 @@
 #include <iostream>
 #include <fstream>
 #include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
 
 namespace frqs::utils {
 
@@ -23,53 +32,181 @@ public:
         return logger ;
     }
     
-    void log(Level level, std::string_view message) {
-        std::lock_guard<std::mutex> lock(mutex_) ;
-        
-        auto log_entry = CreateLog(level, message) ;
-        
-        // Write to console
-        if (level == Level::ERROR) {
-            std::cerr << log_entry << '\n' ;
-        } else {
-            std::cout << log_entry << '\n' ;
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(queue_->mutex) ;
+            queue_->stop = true ;
         }
-        
-        // Write to file if enabled
-        if (log_file_.is_open()) {
-            log_file_ << log_entry << '\n' ;
-            log_file_.flush() ;
+        queue_->pending_cv.notify_one() ;
+        if (queue_->writer.joinable()) {
+            queue_->writer.join() ;
+        }
+    }
+    
+    template <typename Message>
+    void push(Level level, Message message) {
+        {
+            std::lock_guard<std::mutex> lock(queue_->mutex) ;
+            queue_->pending.push_back(Entry{level, std::chrono::system_clock::now(), std::move(message)}) ;
         }
+        queue_->pending_cv.notify_one() ;
     }
     
     void enableFileLogging(const std::string& filename) {
-        std::lock_guard<std::mutex> lock(mutex_) ;
+        std::lock_guard<std::mutex> lock(file_mutex_) ;
         if (log_file_.is_open()) {
             log_file_.close() ;
         }
         log_file_.open(filename, std::ios::app) ;
     }
     
+    void flush() {
+        auto& queue = *queue_ ;
+        std::unique_lock<std::mutex> lock(queue.mutex) ;
+        uint64_t target = queue.enqueued + queue.pending.size() ;
+        queue.drained_cv.wait(lock, [&queue, target] { return queue.written >= target || queue.stop ; }) ;
+    }
+    
 private:
-    Logger() = default ;
-    std::mutex mutex_ ;
+    struct Entry {
+        Level level ;
+        std::chrono::system_clock::time_point when ;
+        std::variant<std::string, detail::DeferredMessage> message ;
+    } ;
+    
+    struct Queue {
+        std::mutex mutex ;
+        std::condition_variable pending_cv ;
+        std::condition_variable drained_cv ;
+        std::vector<Entry> pending ;
+        uint64_t enqueued = 0 ;
+        uint64_t written = 0 ;
+        bool stop = false ;
+        std::thread writer ;
+    } ;
+    
+    Logger() : queue_(startQueue()) {
+#ifndef _WIN32
+        // A forked child has no writer thread. The file is quiesced across
+        // fork(); the child abandons the parent's queue (messages still in
+        // it are the parent's to write) and starts its own.
+        ::pthread_atfork(
+            [] { instance().file_mutex_.lock() ; },
+            [] { instance().file_mutex_.unlock() ; },
+            [] {
+                auto& logger = instance() ;
+                logger.file_mutex_.unlock() ;
+                (void)logger.queue_.release() ;   // Its mutex and writer belong to the parent
+                logger.queue_ = logger.startQueue() ;
+            }) ;
+#endif
+    }
+    
+    std::unique_ptr<Queue> startQueue() {
+        auto queue = std::make_unique<Queue>() ;
+        queue->writer = std::thread([this, &queue = *queue] { writerThread(queue) ; }) ;
+        return queue ;
+    }
+    
+    void writerThread(Queue& queue) {
+        std::vector<Entry> batch ;
+        
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex) ;
+                queue.pending_cv.wait(lock, [&queue] { return queue.stop || !queue.pending.empty() ; }) ;
+                
+                if (queue.pending.empty()) {
+                    return ;
+                }
+                
+                batch.swap(queue.pending) ;
+                queue.enqueued += batch.size() ;
+            }
+            
+            write(batch) ;
+            
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex) ;
+                queue.written += batch.size() ;
+            }
+            queue.drained_cv.notify_all() ;
+            batch.clear() ;
+        }
+    }
+    
+    void write(std::vector<Entry>& batch) {
+        std::lock_guard<std::mutex> lock(file_mutex_) ;
+        
+        for (auto& entry : batch) {
+            std::string message ;
+            if (auto* text = std::get_if<std::string>(&entry.message)) {
+                message = std::move(*text) ;
+            } else {
+                try {
+                    message = std::get<detail::DeferredMessage>(entry.message)() ;
+                } catch (const std::exception& e) {
+                    message = std::string("<log format error: ") + e.what() + ">" ;
+                }
+            }
+            
+            auto log_entry = CreateLog(entry.level, message, entry.when) ;
+            
+            // Write to console
+            if (entry.level == Level::ERROR) {
+                std::cerr << log_entry << '\n' ;
+            } else {
+                std::cout << log_entry << '\n' ;
+            }
+            
+            // Write to file if enabled
+            if (log_file_.is_open()) {
+                log_file_ << log_entry << '\n' ;
+            }
+        }
+        
+        // One flush per batch instead of per line
+        std::cout.flush() ;
+        if (log_file_.is_open()) {
+            log_file_.flush() ;
+        }
+    }
+    
+    std::mutex file_mutex_ ;
     std::ofstream log_file_ ;
+    
+    std::unique_ptr<Queue> queue_ ;   // Last: its writer uses the file
 } ;
 
-void logInfo(std::string_view message) {
-    Logger::instance().log(Level::INFO, message) ;
+std::optional<Level> parseLevel(std::string_view name) noexcept {
+    if (name == "info" || name == "INFO") return Level::INFO ;
+    if (name == "warn" || name == "WARN") return Level::WARN ;
+    if (name == "error" || name == "ERROR") return Level::ERROR ;
+    return std::nullopt ;
 }
 
-void logWarn(std::string_view message) {
-    Logger::instance().log(Level::WARN, message) ;
+void setLogLevel(Level level) noexcept {
+    detail::g_min_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed) ;
 }
 
-void logError(std::string_view message) {
-    Logger::instance().log(Level::ERROR, message) ;
+namespace detail {
+
+void enqueue(Level level, std::string message) {
+    Logger::instance().push(level, std::move(message)) ;
 }
 
+void enqueue(Level level, DeferredMessage message) {
+    Logger::instance().push(level, std::move(message)) ;
+}
+
+} // namespace detail
+
 void enableFileLogging(const std::string& filename) {
     Logger::instance().enableFileLogging(filename) ;
 }
 
+void flushLogs() {
+    Logger::instance().flush() ;
+}
+
 } // namespace frqs::utils
\ No newline at end of file
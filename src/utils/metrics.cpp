@@ -0,0 +1,247 @@
+/**
+ * @file utils/metrics.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "utils/metrics.hpp"
+#include "utils/logger.hpp"
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+namespace frqs::utils {
+
+namespace {
+    // Exported histogram boundaries in microseconds
+    constexpr std::array<uint64_t, 16> EXPORT_BOUNDS_US = {
+        100, 250, 500, 1'000, 2'500, 5'000, 10'000, 25'000, 50'000,
+        100'000, 250'000, 500'000, 1'000'000, 2'500'000, 5'000'000, 10'000'000
+    } ;
+
+    constexpr std::array<double, 5> EXPORT_QUANTILES = {0.5, 0.9, 0.99, 0.999, 1.0} ;
+
+    double toSeconds(uint64_t us) noexcept {
+        return static_cast<double>(us) / 1e6 ;
+    }
+
+    void appendHeader(std::string& out, std::string_view name, std::string_view type, std::string_view help) {
+        std::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type) ;
+    }
+
+    std::string escapeLabel(std::string_view value) {
+        std::string out ;
+        out.reserve(value.size()) ;
+        for (char c : value) {
+            if (c == '\\' || c == '"') out += '\\' ;
+            if (c == '\n') { out += "\\n" ; continue ; }
+            out += c ;
+        }
+        return out ;
+    }
+}
+
+Metrics::Metrics(size_t slot_count)
+    : slot_count_(std::max<size_t>(slot_count, 1))
+    , own_counters_(std::make_unique<CounterSlot[]>(slot_count_))
+    , counters_(own_counters_.get(), slot_count_)
+    , totals_(counters_)
+    , routes_(std::make_unique<RouteSlot[]>(slot_count_))
+{
+    route_names_.reserve(MAX_ROUTES) ;
+}
+
+Metrics::~Metrics() {
+    for (size_t s = 0 ; s < slot_count_ ; ++s) {
+        for (auto& route : routes_[s].routes) {
+            delete route.load(std::memory_order_relaxed) ;
+        }
+    }
+}
+
+size_t Metrics::registerRoute(std::string name) {
+    std::lock_guard<std::mutex> lock(registry_mutex_) ;
+    
+    auto it = std::find(route_names_.begin(), route_names_.end(), name) ;
+    if (it != route_names_.end()) {
+        return static_cast<size_t>(it - route_names_.begin()) ;
+    }
+    if (route_names_.size() == OVERFLOW_ROUTE) {
+        logWarn("Metrics route table full ({} routes), '{}' and later routes are counted as '{}'",
+                OVERFLOW_ROUTE, name, OVERFLOW_NAME) ;
+        route_names_.emplace_back(OVERFLOW_NAME) ;
+    }
+    if (route_names_.size() > OVERFLOW_ROUTE) {
+        return OVERFLOW_ROUTE ;
+    }
+    route_names_.push_back(std::move(name)) ;
+    return route_names_.size() - 1 ;
+}
+
+void Metrics::addGauge(std::string name, std::string help, Source source) {
+    std::lock_guard<std::mutex> lock(registry_mutex_) ;
+    externals_.push_back({std::move(name), std::move(help), std::move(source), false}) ;
+}
+
+void Metrics::addCounter(std::string name, std::string help, Source source) {
+    std::lock_guard<std::mutex> lock(registry_mutex_) ;
+    externals_.push_back({std::move(name), std::move(help), std::move(source), true}) ;
+}
+
+void Metrics::share(std::span<CounterSlot> shared, size_t first) {
+    if (first > shared.size() || shared.size() - first < slot_count_) {
+        throw std::runtime_error("Shared metrics slots too small for this server") ;
+    }
+    
+    auto target = shared.subspan(first, slot_count_) ;
+    for (size_t s = 0 ; s < slot_count_ ; ++s) {
+        for (size_t c = 0 ; c < COUNTER_COUNT ; ++c) {
+            target[s].counters[c].fetch_add(counters_[s].counters[c].load(std::memory_order_relaxed),
+                                            std::memory_order_relaxed) ;
+        }
+    }
+    counters_ = target ;
+    totals_ = shared ;
+}
+
+Histogram& Metrics::routeHistogram(size_t slot, size_t route) {
+    auto& entry = routes_[slot].routes[std::min(route, MAX_ROUTES - 1)] ;
+    Histogram* histogram = entry.load(std::memory_order_acquire) ;
+    if (!histogram) {
+        // First request on this route from this slot; only the owner writes
+        histogram = new Histogram() ;
+        entry.store(histogram, std::memory_order_release) ;
+    }
+    return *histogram ;
+}
+
+void Metrics::recordRequest(size_t slot, size_t route, uint16_t status,
+                            uint64_t bytes_in, uint64_t bytes_out, uint64_t latency_us) noexcept {
+    size_t status_class = std::clamp<size_t>(status / 100, 1, 5) - 1 ;
+    add(slot, static_cast<Counter>(REQUESTS_1XX + status_class)) ;
+    add(slot, BYTES_IN, bytes_in) ;
+    add(slot, BYTES_OUT, bytes_out) ;
+
+    try {
+        routeHistogram(slot, route).record(latency_us) ;
+    } catch (...) {
+        // Out of memory: skip the latency sample
+    }
+}
+
+uint64_t Metrics::total(Counter counter) const noexcept {
+    uint64_t sum = 0 ;
+    for (const auto& slot : totals_) {
+        sum += slot.counters[counter].load(std::memory_order_relaxed) ;
+    }
+    return sum ;
+}
+
+Histogram::Snapshot Metrics::latency(size_t route) const {
+    Histogram::Snapshot snapshot ;
+    route = std::min(route, MAX_ROUTES - 1) ;
+    for (size_t s = 0 ; s < slot_count_ ; ++s) {
+        if (auto* histogram = routes_[s].routes[route].load(std::memory_order_acquire)) {
+            histogram->mergeInto(snapshot) ;
+        }
+    }
+    return snapshot ;
+}
+
+std::string Metrics::renderPrometheus() const {
+    std::string out ;
+    out.reserve(8192) ;
+    auto it = std::back_inserter(out) ;
+
+    appendHeader(out, "zhttp_requests_total", "counter", "Requests answered, by status class") ;
+    static constexpr std::array<std::string_view, 5> classes = {"1xx", "2xx", "3xx", "4xx", "5xx"} ;
+    for (size_t i = 0 ; i < classes.size() ; ++i) {
+        std::format_to(it, "zhttp_requests_total{{code=\"{}\"}} {}\n",
+                       classes[i], total(static_cast<Counter>(REQUESTS_1XX + i))) ;
+    }
+
+    appendHeader(out, "zhttp_received_bytes_total", "counter", "Request bytes read") ;
+    std::format_to(it, "zhttp_received_bytes_total {}\n", total(BYTES_IN)) ;
+
+    appendHeader(out, "zhttp_sent_bytes_total", "counter", "Response bytes written") ;
+    std::format_to(it, "zhttp_sent_bytes_total {}\n", total(BYTES_OUT)) ;
+
+    appendHeader(out, "zhttp_connections_accepted_total", "counter", "Connections accepted") ;
+    std::format_to(it, "zhttp_connections_accepted_total {}\n", total(CONNECTIONS_OPENED)) ;
+
+    // Opens and closes are counted by different threads, so clamp transient skew
+    uint64_t opened = total(CONNECTIONS_OPENED) ;
+    uint64_t closed = total(CONNECTIONS_CLOSED) ;
+    appendHeader(out, "zhttp_connections_active", "gauge", "Connections currently open") ;
+    std::format_to(it, "zhttp_connections_active {}\n", opened > closed ? opened - closed : 0) ;
+
+    appendHeader(out, "zhttp_parse_errors_total", "counter", "Requests rejected by the parser") ;
+    std::format_to(it, "zhttp_parse_errors_total {}\n", total(PARSE_ERRORS)) ;
+
+    appendHeader(out, "zhttp_timeouts_total", "counter", "Connections closed by a read, write or idle deadline") ;
+    std::format_to(it, "zhttp_timeouts_total {}\n", total(TIMEOUTS)) ;
+
+    appendHeader(out, "zhttp_shed_total", "counter", "Work refused with 503 by admission control") ;
+    std::format_to(it, "zhttp_shed_total{{reason=\"connections\"}} {}\n", total(SHED_CONNECTIONS)) ;
+    std::format_to(it, "zhttp_shed_total{{reason=\"queue\"}} {}\n", total(SHED_QUEUE)) ;
+    std::format_to(it, "zhttp_shed_total{{reason=\"client\"}} {}\n", total(SHED_CLIENT)) ;
+    std::format_to(it, "zhttp_shed_total{{reason=\"delay\"}} {}\n", total(SHED_DELAY)) ;
+
+    appendHeader(out, "zhttp_rate_limited_total", "counter", "Connections and requests refused with 429") ;
+    std::format_to(it, "zhttp_rate_limited_total {}\n", total(RATE_LIMITED)) ;
+
+    appendHeader(out, "zhttp_access_denied_total", "counter", "Connections closed by the access list") ;
+    std::format_to(it, "zhttp_access_denied_total {}\n", total(ACCESS_DENIED)) ;
+
+    std::lock_guard<std::mutex> lock(registry_mutex_) ;
+
+    for (const auto& external : externals_) {
+        appendHeader(out, external.name, external.is_counter ? "counter" : "gauge", external.help) ;
+        std::format_to(it, "{} {}\n", external.name, external.source ? external.source() : 0.0) ;
+    }
+
+    appendHeader(out, "zhttp_request_duration_seconds", "histogram", "Accept to last byte sent, by route") ;
+    std::vector<Histogram::Snapshot> snapshots ;
+    snapshots.reserve(route_names_.size()) ;
+    for (size_t r = 0 ; r < route_names_.size() ; ++r) {
+        snapshots.push_back(latency(r)) ;
+        const auto& snapshot = snapshots.back() ;
+        auto route = escapeLabel(route_names_[r]) ;
+
+        uint64_t cumulative = 0 ;
+        size_t bucket = 0 ;
+        for (uint64_t bound : EXPORT_BOUNDS_US) {
+            while (bucket < Histogram::BUCKET_COUNT && Histogram::bucketUpperBound(bucket) <= bound) {
+                cumulative += snapshot.counts[bucket++] ;
+            }
+            std::format_to(it, "zhttp_request_duration_seconds_bucket{{route=\"{}\",le=\"{}\"}} {}\n",
+                           route, toSeconds(bound), cumulative) ;
+        }
+        std::format_to(it, "zhttp_request_duration_seconds_bucket{{route=\"{}\",le=\"+Inf\"}} {}\n",
+                       route, snapshot.count) ;
+        std::format_to(it, "zhttp_request_duration_seconds_sum{{route=\"{}\"}} {}\n", route, toSeconds(snapshot.sum)) ;
+        std::format_to(it, "zhttp_request_duration_seconds_count{{route=\"{}\"}} {}\n", route, snapshot.count) ;
+    }
+
+    appendHeader(out, "zhttp_request_latency_seconds", "summary", "HDR latency quantiles, by route") ;
+    for (size_t r = 0 ; r < route_names_.size() ; ++r) {
+        const auto& snapshot = snapshots[r] ;
+        auto route = escapeLabel(route_names_[r]) ;
+        for (double q : EXPORT_QUANTILES) {
+            std::format_to(it, "zhttp_request_latency_seconds{{route=\"{}\",quantile=\"{}\"}} {}\n",
+                           route, q, toSeconds(snapshot.percentile(q))) ;
+        }
+        std::format_to(it, "zhttp_request_latency_seconds_sum{{route=\"{}\"}} {}\n", route, toSeconds(snapshot.sum)) ;
+        std::format_to(it, "zhttp_request_latency_seconds_count{{route=\"{}\"}} {}\n", route, snapshot.count) ;
+    }
+
+    return out ;
+}
+
+} // namespace frqs::utils
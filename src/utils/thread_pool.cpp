@@ -11,8 +11,43 @@
 
 #include "utils/thread_pool.hpp"
 
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
 namespace frqs::utils {
 
+namespace {
+    thread_local size_t t_worker_index = ThreadPool::npos;
+    
+    // Polls before yielding; about the cost of a futex wake
+    constexpr uint32_t PAUSE_ROUNDS = 1024;
+    
+    void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+    
+#ifdef __linux__
+    bool pinThread(pthread_t thread, int cpu) noexcept {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return ::pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+    }
+#endif
+}
+
 ThreadPool::ThreadPool(size_t num_threads) {
     if (num_threads == 0) {
         num_threads = 1;
@@ -21,7 +56,7 @@ ThreadPool::ThreadPool(size_t num_threads) {
     workers_.reserve(num_threads);
     
     for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back([this] { workerThread(); });
+        workers_.emplace_back([this, i] { workerThread(i); });
     }
 }
 
@@ -40,10 +75,16 @@ ThreadPool::~ThreadPool() {
     }
 }
 
-void ThreadPool::workerThread() {
+void ThreadPool::workerThread(size_t index) {
+    t_worker_index = index;
+    
     while (true) {
         std::function<void()> task;
         
+        if (auto limit = spin_ns_.load(std::memory_order_relaxed); limit > 0) {
+            spin(std::chrono::nanoseconds(limit));
+        }
+        
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
             
@@ -58,6 +99,7 @@ void ThreadPool::workerThread() {
             if (!tasks_.empty()) {
                 task = std::move(tasks_.front());
                 tasks_.pop();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
             }
         }
         
@@ -67,9 +109,54 @@ void ThreadPool::workerThread() {
     }
 }
 
+void ThreadPool::spin(std::chrono::nanoseconds limit) const noexcept {
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    for (uint32_t round = 0; pending_.load(std::memory_order_acquire) == 0; ++round) {
+        if (round < PAUSE_ROUNDS) {
+            cpuRelax();
+            continue;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void ThreadPool::setSpin(std::chrono::nanoseconds spin) noexcept {
+    spin_ns_.store(spin.count(), std::memory_order_relaxed);
+}
+
+bool ThreadPool::pin(std::span<const int> cpus) {
+    if (cpus.empty()) {
+        return true;
+    }
+    bool pinned = true;
+#ifdef __linux__
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        pinned = pinThread(workers_[i].native_handle(), cpus[i % cpus.size()]) && pinned;
+    }
+#else
+    pinned = false;
+#endif
+    return pinned;
+}
+
+bool ThreadPool::pinCurrentThread(int cpu) noexcept {
+#ifdef __linux__
+    return pinThread(::pthread_self(), cpu);
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
 size_t ThreadPool::pendingTasks() const noexcept {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return tasks_.size();
+    return pending_.load(std::memory_order_relaxed);
+}
+
+size_t ThreadPool::workerIndex() noexcept {
+    return t_worker_index;
 }
 
 } // namespace frqs::utils
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * @file utils/timer_wheel.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "utils/timer_wheel.hpp"
+#include <algorithm>
+
+namespace frqs::utils {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds resolution, Clock::time_point now)
+    : resolution_(std::max<Clock::duration>(resolution, std::chrono::milliseconds(1)))
+    , origin_(now) {
+}
+
+uint64_t TimerWheel::tickAt(Clock::time_point t) const noexcept {
+    if (t <= origin_) {
+        return 0 ;
+    }
+    return static_cast<uint64_t>((t - origin_) / resolution_) ;
+}
+
+void TimerWheel::arm(Timer& timer, Clock::time_point deadline) noexcept {
+    timer.cancel() ;
+
+    // Round up so a timer never fires early
+    uint64_t expiry = 0 ;
+    if (deadline > origin_) {
+        auto elapsed = deadline - origin_ ;
+        expiry = static_cast<uint64_t>((elapsed + resolution_ - Clock::duration(1)) / resolution_) ;
+    }
+
+    timer.wheel_ = this ;
+    timer.expiry_ = std::max(expiry, current_ + 1) ;
+    place(timer) ;
+}
+
+void TimerWheel::place(Timer& timer) noexcept {
+    // Beyond the wheel's reach: park in the outermost level and re-place on cascade
+    uint64_t slot_tick = std::min(timer.expiry_, current_ + MAX_SPAN - 1) ;
+    uint64_t delta = slot_tick - current_ ;
+
+    uint32_t level = 0 ;
+    while (level + 1 < LEVELS && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level ;
+    }
+
+    auto index = static_cast<uint32_t>((slot_tick >> (SLOT_BITS * level)) & (SLOTS - 1)) ;
+    Link& head = slots_[level][index] ;
+
+    timer.prev = head.prev ;
+    timer.next = &head ;
+    head.prev->next = &timer ;
+    head.prev = &timer ;
+    ++size_ ;
+}
+
+void TimerWheel::cascade(uint32_t level) noexcept {
+    if (level >= LEVELS) {
+        return ;
+    }
+
+    auto index = static_cast<uint32_t>((current_ >> (SLOT_BITS * level)) & (SLOTS - 1)) ;
+    if (index == 0) {
+        cascade(level + 1) ;
+    }
+
+    Link moving ;
+    splice(slots_[level][index], moving) ;
+    while (moving.linked()) {
+        auto& timer = static_cast<Timer&>(*moving.next) ;
+        timer.unlink() ;
+        --size_ ;
+        place(timer) ;
+    }
+}
+
+void TimerWheel::splice(Link& from, Link& to) noexcept {
+    if (!from.linked()) {
+        return ;
+    }
+    to.next = from.next ;
+    to.prev = from.prev ;
+    to.next->prev = &to ;
+    to.prev->next = &to ;
+    from.prev = from.next = &from ;
+}
+
+std::optional<TimerWheel::Clock::duration> TimerWheel::nextTimeout(Clock::time_point now) const noexcept {
+    if (size_ == 0) {
+        return std::nullopt ;
+    }
+
+    // Nearest occupied level-0 slot, else the next cascade point
+    uint64_t next = ((current_ >> SLOT_BITS) + 1) << SLOT_BITS ;
+    for (uint64_t tick = current_ + 1 ; tick < next ; ++tick) {
+        if (slots_[0][tick & (SLOTS - 1)].linked()) {
+            next = tick ;
+            break ;
+        }
+    }
+
+    auto at = origin_ + resolution_ * static_cast<Clock::rep>(next) ;
+    return at > now ? at - now : Clock::duration::zero() ;
+}
+
+} // namespace frqs::utils
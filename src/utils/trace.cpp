@@ -0,0 +1,159 @@
+/**
+ * @file utils/trace.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief 
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "utils/trace.hpp"
+#include "utils/json.hpp"
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace frqs::utils::trace {
+
+namespace {
+    // Span name for the interval ending at each phase
+    constexpr std::array<std::string_view, static_cast<size_t>(Phase::COUNT)> PHASE_NAMES = {
+        "accept", "receive", "queue", "parse", "securePath", "readFile", "handler", "build", "send"
+    } ;
+
+    double calibrate() noexcept {
+#if FRQS_ENABLE_TRACING && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+        auto wall_start = std::chrono::steady_clock::now() ;
+        uint64_t tsc_start = ticks() ;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)) ;
+        uint64_t tsc_end = ticks() ;
+        auto wall_end = std::chrono::steady_clock::now() ;
+        
+        double us = std::chrono::duration<double, std::micro>(wall_end - wall_start).count() ;
+        return us > 0 ? static_cast<double>(tsc_end - tsc_start) / us : 1.0 ;
+#else
+        return 1000.0 ;   // steady_clock nanoseconds
+#endif
+    }
+}
+
+double ticksPerMicrosecond() noexcept {
+    static const double ratio = calibrate() ;
+    return ratio ;
+}
+
+Tracer::Tracer(TracerConfig config)
+    : config_(std::move(config))
+    , origin_ticks_(ticks())
+    , ticks_per_us_(ticksPerMicrosecond())
+{
+    slow_ticks_ = static_cast<uint64_t>(static_cast<double>(config_.slow_threshold.count()) * ticks_per_us_) ;
+    
+    file_.open(config_.output, std::ios::trunc) ;
+    if (!file_) {
+        throw std::runtime_error("Failed to open trace file: " + config_.output.string()) ;
+    }
+    file_ << "[\n" ;
+}
+
+Tracer::~Tracer() {
+    std::lock_guard<std::mutex> lock(file_mutex_) ;
+    file_ << "\n]\n" ;
+}
+
+bool Tracer::keep(const RequestTrace& trace) const noexcept {
+    if (config_.sample_every != 0) {
+        thread_local uint32_t countdown = 0 ;
+        if (countdown == 0) {
+            countdown = config_.sample_every ;
+        }
+        if (--countdown == 0) {
+            return true ;
+        }
+    }
+
+    uint64_t start = trace.at(Phase::ACCEPTED) ;
+    uint64_t end = trace.at(Phase::SENT) ;
+    return slow_ticks_ != 0 && start != 0 && end > start && end - start >= slow_ticks_ ;
+}
+
+double Tracer::toMicros(uint64_t t) const noexcept {
+    return static_cast<double>(t - origin_ticks_) / ticks_per_us_ ;
+}
+
+void Tracer::finish(const RequestTrace& trace, size_t thread_id,
+                    std::string_view method, std::string_view path, uint16_t status) {
+#if FRQS_ENABLE_TRACING
+    if (!keep(trace)) {
+        return ;
+    }
+
+    uint64_t accepted = trace.at(Phase::ACCEPTED) ;
+    uint64_t received = trace.at(Phase::RECEIVED) ;
+    uint64_t dequeued = trace.at(Phase::DEQUEUED) ;
+    uint64_t sent = trace.at(Phase::SENT) ;
+    if (dequeued == 0 || sent < dequeued) {
+        return ;
+    }
+    if (received == 0 || received > dequeued) {
+        received = accepted ;
+    }
+
+    std::string events ;
+    events.reserve(1024) ;
+    auto it = std::back_inserter(events) ;
+
+    std::string name = std::string(method) + " " + std::string(path) ;
+
+    std::lock_guard<std::mutex> lock(file_mutex_) ;
+    uint64_t id = next_id_++ ;
+    
+    if (id != 0) {
+        events += ",\n" ;
+    }
+
+    // Reading the request and waiting for a worker as async spans, they
+    // overlap other requests
+    auto async_span = [&](std::string_view span, uint64_t begin, uint64_t end) {
+        if (begin == 0 || begin >= end) {
+            return ;
+        }
+        std::format_to(it, R"({{"name":"{}","cat":"queue","ph":"b","id":{},"ts":{:.3f},"pid":1,"tid":{}}},)"
+                           "\n"
+                           R"({{"name":"{}","cat":"queue","ph":"e","id":{},"ts":{:.3f},"pid":1,"tid":{}}},)"
+                           "\n",
+                       span, id, toMicros(begin), thread_id, span, id, toMicros(end), thread_id) ;
+    } ;
+    async_span("receive", accepted, received) ;
+    async_span("queue", received, dequeued) ;
+
+    events += R"({"name":)" ;
+    appendJsonString(events, name) ;
+    std::format_to(it, R"(,"cat":"request","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{},"args":{{"status":{},"queue_us":{:.3f}}}}})",
+                   toMicros(dequeued), static_cast<double>(sent - dequeued) / ticks_per_us_, thread_id, status,
+                   received != 0 && received < dequeued ? static_cast<double>(dequeued - received) / ticks_per_us_ : 0.0) ;
+
+    // Consecutive phases as back-to-back spans
+    uint64_t previous = dequeued ;
+    for (size_t p = static_cast<size_t>(Phase::PARSED) ; p < static_cast<size_t>(Phase::COUNT) ; ++p) {
+        uint64_t at = trace.marks[p] ;
+        if (at == 0 || at < previous) {
+            continue ;
+        }
+        std::format_to(it, ",\n" R"({{"name":"{}","cat":"phase","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                       PHASE_NAMES[p], toMicros(previous), static_cast<double>(at - previous) / ticks_per_us_, thread_id) ;
+        previous = at ;
+    }
+
+    file_ << events ;
+    written_.fetch_add(1, std::memory_order_relaxed) ;
+#else
+    (void)trace ; (void)thread_id ; (void)method ; (void)path ; (void)status ;
+#endif
+}
+
+} // namespace frqs::utils::trace
@@ -0,0 +1,104 @@
+/**
+ * @file tools/access_log_decode.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Converts binary access log segments (.zal) to JSON lines
+ * @version 1.0.0
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+#include "utils/access_log.hpp"
+#include "utils/json.hpp"
+#include "http/method.hpp"
+#include "net/ipv4.hpp"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    using namespace frqs ;
+
+    std::string toJson(const utils::AccessRecord& r) {
+        std::string out ;
+        out.reserve(256) ;
+        out += std::format("{{\"ts_ns\":{},\"client\":\"{}\",\"port\":{},\"method\":\"{}\",\"path\":",
+                           r.timestamp_ns,
+                           net::IPv4(r.client_ip).toString(),
+                           r.client_port,
+                           http::methodToString(static_cast<http::Method>(r.method))) ;
+        utils::appendJsonString(out, r.getPath()) ;
+        out += std::format(",\"status\":{},\"bytes_in\":{},\"bytes_out\":{},\"total_us\":{},\"handler_us\":{}",
+                           r.status, r.bytes_in, r.bytes_out, r.total_us, r.handler_us) ;
+        if (r.flags & utils::AccessRecord::PATH_TRUNCATED) {
+            out += ",\"path_truncated\":true" ;
+        }
+        out += '}' ;
+        return out ;
+    }
+
+    bool decodeFile(const std::filesystem::path& path, std::ostream& out) {
+        std::ifstream in(path, std::ios::binary) ;
+        if (!in) {
+            std::cerr << "Cannot open " << path.string() << '\n' ;
+            return false ;
+        }
+
+        utils::AccessLogHeader header ;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, utils::AccessLogHeader::MAGIC, sizeof(header.magic)) != 0) {
+            std::cerr << "Not an access log segment: " << path.string() << '\n' ;
+            return false ;
+        }
+
+        if (header.version != utils::ACCESS_LOG_VERSION || header.record_size != sizeof(utils::AccessRecord)) {
+            std::cerr << "Unsupported segment version " << header.version << ": " << path.string() << '\n' ;
+            return false ;
+        }
+
+        utils::AccessRecord record ;
+        for (uint64_t i = 0 ; i < header.record_count ; ++i) {
+            if (!in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+                std::cerr << "Truncated segment: " << path.string() << '\n' ;
+                return false ;
+            }
+            out << toJson(record) << '\n' ;
+        }
+        return true ;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <segment.zal | directory>...\n" ;
+        return 2 ;
+    }
+
+    std::vector<std::filesystem::path> files ;
+    for (int i = 1 ; i < argc ; ++i) {
+        std::filesystem::path arg = argv[i] ;
+        if (std::filesystem::is_directory(arg)) {
+            for (const auto& entry : std::filesystem::directory_iterator(arg)) {
+                if (entry.path().extension() == ".zal") {
+                    files.push_back(entry.path()) ;
+                }
+            }
+        } else {
+            files.push_back(arg) ;
+        }
+    }
+
+    // Segment names embed creation time, so name order is chronological
+    std::sort(files.begin(), files.end()) ;
+
+    std::ios::sync_with_stdio(false) ;
+    bool ok = true ;
+    for (const auto& file : files) {
+        ok = decodeFile(file, std::cout) && ok ;
+    }
+    return ok ? 0 : 1 ;
+}
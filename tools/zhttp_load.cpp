@@ -0,0 +1,584 @@
+/**
+ * @file tools/zhttp_load.cpp
+ * @author zuudevs (zuudevs@gmail.com)
+ * @brief Loopback HTTP/1.1 load generator (closed and open loop)
+ * @version 1.0.0
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "net/socket.hpp"
+#include "utils/histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+#else
+    #include <poll.h>
+#endif
+
+namespace {
+    using namespace frqs ;
+    using Clock = std::chrono::steady_clock ;
+
+    struct Options {
+        std::string host = "127.0.0.1" ;
+        std::string source ;         // Local address to connect from, e.g. 127.0.0.2
+        uint16_t port = 8080 ;
+        std::vector<std::string> paths ;
+        size_t connections = 64 ;
+        size_t threads = std::max(1u, std::min(4u, std::thread::hardware_concurrency())) ;
+        double duration_s = 10.0 ;
+        double warmup_s = 1.0 ;
+        double rate = 0.0 ;          // Total requests/s; 0 selects closed-loop mode
+        size_t pipeline = 1 ;        // Requests in flight per connection
+        bool keep_alive = true ;
+        std::string json_out ;
+        std::string label ;
+    } ;
+
+    struct Stats {
+        utils::Histogram latency_us ;
+        uint64_t completed = 0 ;
+        uint64_t errors = 0 ;
+        uint64_t connects = 0 ;
+        uint64_t connect_errors = 0 ;
+        uint64_t bytes_in = 0 ;
+        uint64_t status[6] = {} ;    // Index by status / 100
+    } ;
+
+    struct Connection {
+        enum class State : uint8_t { IDLE, CONNECTING, OPEN } ;
+
+        std::unique_ptr<net::Socket> socket ;
+        State state = State::IDLE ;
+        Clock::time_point retry_at{} ;
+
+        std::string out ;
+        size_t out_offset = 0 ;
+        std::string in ;
+        size_t in_offset = 0 ;
+
+        // Intended start time of every request written but not yet answered
+        std::deque<Clock::time_point> in_flight ;
+        size_t next_path = 0 ;
+    } ;
+
+    // Outcome of trying to parse one response from the connection buffer
+    enum class Parse : uint8_t { INCOMPLETE, COMPLETE, UNTIL_CLOSE, INVALID } ;
+
+    struct Response {
+        uint16_t status = 0 ;
+        size_t length = 0 ;
+        bool close = false ;
+    } ;
+
+    bool iequals(std::string_view a, std::string_view b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)) ;
+        }) ;
+    }
+
+    Parse parseResponse(std::string_view data, Response& out) {
+        auto header_end = data.find("\r\n\r\n") ;
+        if (header_end == std::string_view::npos) {
+            return data.size() > 64 * 1024 ? Parse::INVALID : Parse::INCOMPLETE ;
+        }
+        if (!data.starts_with("HTTP/1.") || data.size() < 12) {
+            return Parse::INVALID ;
+        }
+
+        std::from_chars(data.data() + 9, data.data() + 12, out.status) ;
+
+        std::optional<size_t> content_length ;
+        size_t pos = data.find("\r\n") + 2 ;
+        while (pos < header_end) {
+            auto eol = data.find("\r\n", pos) ;
+            auto line = data.substr(pos, eol - pos) ;
+            auto colon = line.find(':') ;
+            if (colon != std::string_view::npos) {
+                auto name = line.substr(0, colon) ;
+                auto value = line.substr(colon + 1) ;
+                while (!value.empty() && value.front() == ' ') value.remove_prefix(1) ;
+                if (iequals(name, "Content-Length")) {
+                    size_t length = 0 ;
+                    std::from_chars(value.data(), value.data() + value.size(), length) ;
+                    content_length = length ;
+                } else if (iequals(name, "Connection") && iequals(value, "close")) {
+                    out.close = true ;
+                }
+            }
+            pos = eol + 2 ;
+        }
+
+        size_t body_start = header_end + 4 ;
+        if (!content_length) {
+            bool bodyless = out.status == 204 || out.status == 304 || out.status < 200 ;
+            if (bodyless) {
+                out.length = body_start ;
+                return Parse::COMPLETE ;
+            }
+            out.length = data.size() ;
+            return Parse::UNTIL_CLOSE ;
+        }
+
+        out.length = body_start + *content_length ;
+        return data.size() >= out.length ? Parse::COMPLETE : Parse::INCOMPLETE ;
+    }
+
+    class Worker {
+    public:
+        Worker(const Options& options, size_t connections, double rate, net::SockAddr target)
+            : options_(options)
+            , rate_(rate)
+            , target_(target)
+            , connections_(connections) {
+            for (const auto& path : options_.paths) {
+                requests_.push_back(std::format(
+                    "GET {} HTTP/1.1\r\nHost: {}:{}\r\nUser-Agent: zhttp_load\r\n{}\r\n",
+                    path, options_.host, options_.port,
+                    options_.keep_alive ? "" : "Connection: close\r\n")) ;
+            }
+        }
+
+        void run(Clock::time_point start, Clock::time_point end) {
+            start_ = start ;
+            measure_from_ = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(options_.warmup_s)) ;
+
+            std::vector<pollfd> fds ;
+            std::vector<size_t> owners ;
+
+            while (true) {
+                auto now = Clock::now() ;
+                if (now >= end) {
+                    break ;
+                }
+
+                releaseDue(now) ;
+                spare_ = 0 ;
+                for (const auto& conn : connections_) {
+                    if (conn.state == Connection::State::CONNECTING ||
+                        (conn.state == Connection::State::OPEN && conn.in_flight.empty())) {
+                        ++spare_ ;
+                    }
+                }
+                for (size_t i = 0 ; i < connections_.size() ; ++i) {
+                    fill(connections_[i], now) ;
+                }
+
+                fds.clear() ;
+                owners.clear() ;
+                for (size_t i = 0 ; i < connections_.size() ; ++i) {
+                    auto& conn = connections_[i] ;
+                    if (conn.state == Connection::State::IDLE) {
+                        continue ;
+                    }
+                    short events = conn.state == Connection::State::CONNECTING ? POLLOUT : POLLIN ;
+                    if (conn.state == Connection::State::OPEN && conn.out_offset < conn.out.size()) {
+                        events |= POLLOUT ;
+                    }
+                    fds.push_back({static_cast<decltype(pollfd::fd)>(conn.socket->native_handle()), events, 0}) ;
+                    owners.push_back(i) ;
+                }
+
+                int timeout_ms = pollTimeout(now, end) ;
+#ifdef _WIN32
+                int ready = fds.empty() ? 0 : ::WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout_ms) ;
+#else
+                int ready = ::poll(fds.data(), fds.size(), timeout_ms) ;
+#endif
+                if (ready <= 0) {
+                    if (fds.empty()) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms)) ;
+                    }
+                    continue ;
+                }
+
+                for (size_t k = 0 ; k < fds.size() ; ++k) {
+                    if (fds[k].revents != 0) {
+                        onEvent(connections_[owners[k]], fds[k].revents) ;
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] const Stats& stats() const noexcept { return stats_ ; }
+
+    private:
+        const Options& options_ ;
+        double rate_ ;
+        net::SockAddr target_ ;
+        std::vector<Connection> connections_ ;
+        std::vector<std::string> requests_ ;
+        Stats stats_ ;
+
+        Clock::time_point start_ ;
+        Clock::time_point measure_from_ ;
+        uint64_t scheduled_ = 0 ;
+        std::deque<Clock::time_point> backlog_ ;   // Open loop: due but not yet sent
+        size_t spare_ = 0 ;                        // Connections able to take a request soon
+
+        [[nodiscard]] bool openLoop() const noexcept { return rate_ > 0 ; }
+
+        Clock::time_point intendedTime(uint64_t k) const {
+            return start_ + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(k) / rate_)) ;
+        }
+
+        // Open loop: requests become due on a fixed schedule whether or not
+        // the server keeps up; latency is measured from the schedule, which
+        // corrects for coordinated omission.
+        void releaseDue(Clock::time_point now) {
+            if (!openLoop()) {
+                return ;
+            }
+            while (intendedTime(scheduled_) <= now) {
+                backlog_.push_back(intendedTime(scheduled_++)) ;
+            }
+        }
+
+        int pollTimeout(Clock::time_point now, Clock::time_point end) const {
+            auto until = end ;
+            if (openLoop()) {
+                until = std::min(until, intendedTime(scheduled_)) ;
+            }
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(until - now).count() ;
+            return static_cast<int>(std::clamp<long long>(ms, 0, 100)) ;
+        }
+
+        void connect(Connection& conn, Clock::time_point now) {
+            if (now < conn.retry_at) {
+                return ;
+            }
+            try {
+                conn.socket = std::make_unique<net::Socket>() ;
+                if (!options_.source.empty()) {
+                    conn.socket->bind(net::SockAddr(net::IPv4(std::string_view(options_.source)), 0)) ;
+                }
+                conn.socket->setNonBlocking() ;
+                conn.state = conn.socket->startConnect(target_)
+                    ? Connection::State::OPEN
+                    : Connection::State::CONNECTING ;
+                ++stats_.connects ;
+            } catch (const std::exception&) {
+                fail(conn, now) ;
+            }
+        }
+
+        void fail(Connection& conn, Clock::time_point now) {
+            ++stats_.connect_errors ;
+            reset(conn) ;
+            conn.retry_at = now + std::chrono::milliseconds(10) ;
+        }
+
+        // Drop the connection; unanswered requests count as errors
+        void reset(Connection& conn) {
+            for (auto intended : conn.in_flight) {
+                if (intended >= measure_from_) {
+                    ++stats_.errors ;
+                }
+            }
+            conn.in_flight.clear() ;
+            conn.socket.reset() ;
+            conn.state = Connection::State::IDLE ;
+            conn.out.clear() ;
+            conn.out_offset = 0 ;
+            conn.in.clear() ;
+            conn.in_offset = 0 ;
+        }
+
+        // Queue requests up to the pipeline depth
+        void fill(Connection& conn, Clock::time_point now) {
+            if (conn.state == Connection::State::IDLE) {
+                // Open loop: only dial out for work no existing connection can take
+                if (!openLoop() || backlog_.size() > spare_) {
+                    connect(conn, now) ;
+                    ++spare_ ;
+                }
+                return ;
+            }
+            if (conn.state != Connection::State::OPEN) {
+                return ;
+            }
+
+            size_t depth = options_.keep_alive ? options_.pipeline : 1 ;
+            while (conn.in_flight.size() < depth) {
+                Clock::time_point intended = now ;
+                if (openLoop()) {
+                    if (backlog_.empty()) {
+                        break ;
+                    }
+                    intended = backlog_.front() ;
+                    backlog_.pop_front() ;
+                }
+                if (conn.out_offset == conn.out.size()) {
+                    conn.out.clear() ;
+                    conn.out_offset = 0 ;
+                }
+                conn.out += requests_[conn.next_path++ % requests_.size()] ;
+                conn.in_flight.push_back(intended) ;
+            }
+
+            flushOut(conn, now) ;
+        }
+
+        void flushOut(Connection& conn, Clock::time_point now) {
+            try {
+                while (conn.out_offset < conn.out.size()) {
+                    auto sent = conn.socket->trySend(std::string_view(conn.out).substr(conn.out_offset)) ;
+                    if (!sent) {
+                        return ;
+                    }
+                    conn.out_offset += *sent ;
+                }
+            } catch (const std::exception&) {
+                reset(conn) ;
+                conn.retry_at = now ;
+            }
+        }
+
+        void onEvent(Connection& conn, short revents) {
+            auto now = Clock::now() ;
+
+            if (conn.state == Connection::State::CONNECTING) {
+                try {
+                    conn.socket->finishConnect() ;
+                    conn.state = Connection::State::OPEN ;
+                    fill(conn, now) ;
+                } catch (const std::exception&) {
+                    fail(conn, now) ;
+                }
+                return ;
+            }
+
+            if (revents & POLLOUT) {
+                flushOut(conn, now) ;
+            }
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                readResponses(conn) ;
+            }
+        }
+
+        void complete(Connection& conn, const Response& response, Clock::time_point now) {
+            auto intended = conn.in_flight.front() ;
+            conn.in_flight.pop_front() ;
+            if (intended < measure_from_) {
+                return ;
+            }
+            ++stats_.completed ;
+            ++stats_.status[std::min<size_t>(response.status / 100, 5)] ;
+            stats_.bytes_in += response.length ;
+            stats_.latency_us.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - intended).count())) ;
+        }
+
+        void readResponses(Connection& conn) {
+            char buffer[64 * 1024] ;
+            bool closed = false ;
+
+            try {
+                while (true) {
+                    auto received = conn.socket->tryReceive(buffer, sizeof(buffer)) ;
+                    if (!received) {
+                        break ;
+                    }
+                    if (*received == 0) {
+                        closed = true ;
+                        break ;
+                    }
+                    conn.in.append(buffer, *received) ;
+                }
+            } catch (const std::exception&) {
+                closed = true ;
+            }
+
+            auto now = Clock::now() ;
+            while (!conn.in_flight.empty()) {
+                Response response ;
+                auto result = parseResponse(std::string_view(conn.in).substr(conn.in_offset), response) ;
+                if (result == Parse::COMPLETE || (result == Parse::UNTIL_CLOSE && closed)) {
+                    complete(conn, response, now) ;
+                    conn.in_offset += response.length ;
+                    if (response.close || result == Parse::UNTIL_CLOSE) {
+                        closed = true ;
+                        break ;
+                    }
+                    continue ;
+                }
+                if (result == Parse::INVALID) {
+                    closed = true ;
+                }
+                break ;
+            }
+
+            // Compact once the consumed prefix dominates the buffer
+            if (conn.in_offset > 0 && conn.in_offset * 2 >= conn.in.size()) {
+                conn.in.erase(0, conn.in_offset) ;
+                conn.in_offset = 0 ;
+            }
+
+            if (closed) {
+                reset(conn) ;
+                conn.retry_at = now ;
+            } else {
+                fill(conn, now) ;
+            }
+        }
+    } ;
+
+    bool parseArgs(int argc, char* argv[], Options& options) {
+        for (int i = 1 ; i < argc ; ++i) {
+            std::string_view arg = argv[i] ;
+            auto eq = arg.find('=') ;
+            std::string_view key = arg.substr(0, eq) ;
+            std::string value(eq == std::string_view::npos ? "" : arg.substr(eq + 1)) ;
+
+            try {
+                if (key == "--host") options.host = value ;
+                else if (key == "--source") options.source = value ;
+                else if (key == "--port") options.port = static_cast<uint16_t>(std::stoul(value)) ;
+                else if (key == "--path") options.paths.push_back(value) ;
+                else if (key == "--connections") options.connections = std::stoul(value) ;
+                else if (key == "--threads") options.threads = std::stoul(value) ;
+                else if (key == "--duration") options.duration_s = std::stod(value) ;
+                else if (key == "--warmup") options.warmup_s = std::stod(value) ;
+                else if (key == "--rate") options.rate = std::stod(value) ;
+                else if (key == "--pipeline") options.pipeline = std::max<size_t>(1, std::stoul(value)) ;
+                else if (key == "--no-keepalive") options.keep_alive = false ;
+                else if (key == "--json") options.json_out = value ;
+                else if (key == "--label") options.label = value ;
+                else return false ;
+            } catch (const std::exception&) {
+                return false ;
+            }
+        }
+
+        if (options.paths.empty()) {
+            options.paths.push_back("/") ;
+        }
+        options.threads = std::clamp<size_t>(options.threads, 1, std::max<size_t>(options.connections, 1)) ;
+        return options.connections > 0 && options.duration_s > 0 ;
+    }
+
+    void usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [options]\n"
+                  << "  --host=127.0.0.1     Target IPv4 address\n"
+                  << "  --port=8080          Target port\n"
+                  << "  --source=ADDR        Local IPv4 to connect from (any 127.x.y.z on loopback)\n"
+                  << "  --path=/             Request path (repeat to round-robin)\n"
+                  << "  --connections=64     Concurrent connections\n"
+                  << "  --threads=N          Client threads (default min(4, cores))\n"
+                  << "  --duration=10        Measured seconds, after warmup\n"
+                  << "  --warmup=1           Seconds excluded from results\n"
+                  << "  --rate=0             Open loop at this total req/s (0 = closed loop)\n"
+                  << "  --pipeline=1         Requests in flight per connection\n"
+                  << "  --no-keepalive       Send Connection: close, one request per connection\n"
+                  << "  --json=FILE          Write results as JSON\n"
+                  << "  --label=NAME         Scenario name recorded in the JSON\n" ;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options ;
+    if (!parseArgs(argc, argv, options)) {
+        usage(argv[0]) ;
+        return 2 ;
+    }
+
+#ifndef _WIN32
+    std::signal(SIGPIPE, SIG_IGN) ;
+#endif
+
+    net::SockAddr target(net::IPv4(std::string_view(options.host)), options.port) ;
+
+    std::vector<std::unique_ptr<Worker>> workers ;
+    for (size_t t = 0 ; t < options.threads ; ++t) {
+        size_t share = options.connections / options.threads + (t < options.connections % options.threads ? 1 : 0) ;
+        workers.push_back(std::make_unique<Worker>(options, share, options.rate / static_cast<double>(options.threads), target)) ;
+    }
+
+    auto start = Clock::now() ;
+    auto end = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(options.warmup_s + options.duration_s)) ;
+
+    std::vector<std::thread> threads ;
+    for (auto& worker : workers) {
+        threads.emplace_back([&worker, start, end] { worker->run(start, end) ; }) ;
+    }
+    for (auto& thread : threads) {
+        thread.join() ;
+    }
+
+    // Merge per-thread results
+    utils::Histogram::Snapshot latency ;
+    Stats total ;
+    for (const auto& worker : workers) {
+        const auto& s = worker->stats() ;
+        s.latency_us.mergeInto(latency) ;
+        total.completed += s.completed ;
+        total.errors += s.errors ;
+        total.connects += s.connects ;
+        total.connect_errors += s.connect_errors ;
+        total.bytes_in += s.bytes_in ;
+        for (size_t i = 0 ; i < 6 ; ++i) total.status[i] += s.status[i] ;
+    }
+
+    double seconds = options.duration_s ;
+    double rps = static_cast<double>(total.completed) / seconds ;
+    double mbps = static_cast<double>(total.bytes_in) / seconds / (1024.0 * 1024.0) ;
+    const char* mode = options.rate > 0 ? "open" : "closed" ;
+
+    std::cout << std::format("Target      {}:{} {} ({} paths)\n", options.host, options.port, options.paths.front(), options.paths.size())
+              << std::format("Mode        {}-loop, {} connections, {} threads, pipeline {}, keep-alive {}\n",
+                             mode, options.connections, options.threads, options.pipeline, options.keep_alive ? "on" : "off") ;
+    if (options.rate > 0) {
+        std::cout << std::format("Rate        {:.0f} req/s target\n", options.rate) ;
+    }
+    std::cout << std::format("Requests    {} in {:.1f}s, {} errors, {} connects ({} failed)\n",
+                             total.completed, seconds, total.errors, total.connects, total.connect_errors)
+              << std::format("Throughput  {:.0f} req/s, {:.2f} MiB/s\n", rps, mbps)
+              << std::format("Status      2xx={} 3xx={} 4xx={} 5xx={}\n",
+                             total.status[2], total.status[3], total.status[4], total.status[5])
+              << std::format("Latency us  mean={:.0f} p50={} p90={} p99={} p99.9={} max={}\n",
+                             latency.mean(), latency.percentile(0.5), latency.percentile(0.9),
+                             latency.percentile(0.99), latency.percentile(0.999), latency.max) ;
+
+    if (!options.json_out.empty()) {
+        std::ofstream file(options.json_out) ;
+        if (!file) {
+            std::cerr << "Cannot write " << options.json_out << '\n' ;
+            return 1 ;
+        }
+        file << std::format(
+            "{{\"label\":\"{}\",\"mode\":\"{}\",\"connections\":{},\"threads\":{},\"pipeline\":{},"
+            "\"keep_alive\":{},\"rate\":{},\"duration_s\":{},\"requests\":{},\"errors\":{},\"connects\":{},"
+            "\"connect_errors\":{},\"rps\":{:.1f},\"bytes_per_second\":{:.0f},"
+            "\"status\":{{\"2xx\":{},\"3xx\":{},\"4xx\":{},\"5xx\":{}}},"
+            "\"latency_us\":{{\"mean\":{:.1f},\"p50\":{},\"p90\":{},\"p99\":{},\"p999\":{},\"max\":{}}}}}\n",
+            options.label, mode, options.connections, options.threads, options.pipeline,
+            options.keep_alive ? "true" : "false", options.rate, options.duration_s,
+            total.completed, total.errors, total.connects, total.connect_errors,
+            rps, static_cast<double>(total.bytes_in) / seconds,
+            total.status[2], total.status[3], total.status[4], total.status[5],
+            latency.mean(), latency.percentile(0.5), latency.percentile(0.9),
+            latency.percentile(0.99), latency.percentile(0.999), latency.max) ;
+    }
+
+    return total.completed > 0 ? 0 : 1 ;
+}